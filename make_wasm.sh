@@ -7,10 +7,14 @@ emcmake cmake \
   -DKISSFFT_STATIC:BOOL=OFF \
   .
 
-make wasm_tuner
+make wasm_tuner wasm_tuner_simd
+
+mkdir -p ./wasm_public
 
 mv ./wasm_tuner.js ./wasm_public
 mv ./wasm_tuner.wasm ./wasm_public
+mv ./wasm_tuner_simd.js ./wasm_public
+mv ./wasm_tuner_simd.wasm ./wasm_public
 
 rm ./Makefile
 rm ./CMakeCache.txt
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <tuner/cepstrum.hpp>
+#include <tuner/dsp.hpp>
+#include <tuner/kernels.hpp>
+#include <tuner/window_table.hpp>
+
+tuner::cepstrum_engine::cepstrum_engine(int sample_rate, const tuner::cepstrum_config &config,
+                                        tuner::metrics *metrics) noexcept
+        : rate(sample_rate), metrics(metrics), min_quefrency(0), max_quefrency(0), floor_ratio(0), fft(),
+          in(), fft_res() {
+    if (sample_rate <= 0 || !(config.min_frequency > 0) || !(config.max_frequency > config.min_frequency) ||
+        !(config.dynamic_range_db > 0)) {
+        return;
+    }
+
+    // the peak needs a neighbour on both sides for the parabolic refinement
+    min_quefrency = std::max(2, int(std::ceil(float(sample_rate) / config.max_frequency)));
+    max_quefrency = std::min(TUNER_SIZE / 2 - 1, int(std::floor(float(sample_rate) / config.min_frequency)));
+    if (min_quefrency >= max_quefrency) {
+        return;
+    }
+    floor_ratio = std::pow(10.0f, -config.dynamic_range_db / 10.0f);
+
+    try {
+        fft = tuner::plan_cache::shared().lease_fft(TUNER_SIZE);
+    } catch (const std::exception &) {
+        // not ready
+        fft = tuner::fft_lease();
+    }
+}
+
+tuner::cepstrum_engine::~cepstrum_engine() = default;
+
+tuner::realtime_status tuner::cepstrum_engine::process(const float *samples, tuner::realtime_note &out) noexcept {
+    if (!ready()) {
+        return tuner::realtime_status::not_ready;
+    }
+    if (samples == nullptr) {
+        return tuner::realtime_status::invalid_input;
+    }
+    TUNER_METRICS_FRAME(metrics);
+    TUNER_METRICS_ALLOCATIONS(metrics);
+
+    float power;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+        power = tuner::apply_window_and_sum_squares(samples, tuner::HANN_WINDOW<TUNER_SIZE>.data(), in.data(), TUNER_SIZE) / float(TUNER_SIZE);
+    }
+
+    if (power < tuner::SIGNAL_POWER_THRESHOLD) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        out = tuner::realtime_note();
+        std::memcpy(out.name, "LOW", sizeof("LOW"));
+        return tuner::realtime_status::low_energy;
+    }
+
+    float confidence;
+    float frequency = analyze(confidence);
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::note_lookup);
+        tuner::find_note_for_frequency(frequency, out);
+    }
+    out.confidence = confidence;
+
+    return tuner::realtime_status::ok;
+}
+
+float tuner::cepstrum_engine::analyze(float &confidence) noexcept {
+    constexpr int bins = TUNER_SIZE / 2;
+    float floor;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::fft);
+        kiss_fftr(fft.get(), in.data(), fft_res.data());
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::cepstrum);
+        // the frame was consumed by the FFT, so 'in' receives the log power spectrum
+        float max_power = 0;
+        for (int k = 0; k <= bins; k++) {
+            in[k] = fft_res[k].r * fft_res[k].r + fft_res[k].i * fft_res[k].i;
+            max_power = std::max(max_power, in[k]);
+        }
+        floor = std::max(max_power * floor_ratio, std::numeric_limits<float>::min());
+        tuner::fast_log2(in.data(), in.data(), bins + 1, floor);
+        for (int k = 1; k < bins; k++) {
+            in[TUNER_SIZE - k] = in[k];
+        }
+        kiss_fftr(fft.get(), in.data(), fft_res.data());
+    }
+
+    TUNER_METRICS_STAGE(metrics, tuner::stage::peak_pick);
+    // the strongest local maximum, so the falling edge of the low quefrency spectral envelope is never picked
+    int peak = min_quefrency;
+    float peak_value = -std::numeric_limits<float>::infinity();
+    for (int q = min_quefrency; q <= max_quefrency; q++) {
+        float c = fft_res[q].r;
+        if (c > fft_res[q - 1].r && c >= fft_res[q + 1].r && c > peak_value) {
+            peak_value = c;
+            peak = q;
+        }
+    }
+
+    float before = fft_res[peak - 1].r;
+    float after = fft_res[peak + 1].r;
+    float curvature = before - 2 * fft_res[peak].r + after;
+    float offset = curvature < 0 ? 0.5f * (before - after) / curvature : 0;
+    float frequency = float(rate) / (float(peak) + offset);
+
+    // 'in' still holds the floored log power spectrum; the bins at the floor, i.e. between the harmonics, count as silent
+    for (int k = 0; k < bins; k++) {
+        in[k] = std::max(std::exp2(in[k]) - floor, 0.0f);
+    }
+    confidence = tuner::harmonic_energy_fraction(in.data(), bins, 1, frequency * float(TUNER_SIZE) / float(rate));
+
+    return frequency;
+}
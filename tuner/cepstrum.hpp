@@ -0,0 +1,90 @@
+#ifndef TUNER_CEPSTRUM_H
+#define TUNER_CEPSTRUM_H
+
+#include <array>
+
+#include <kiss_fftr.h>
+
+#include <tuner/global.hpp>
+#include <tuner/metrics.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/realtime.hpp>
+
+namespace tuner {
+
+    struct cepstrum_config {
+        // the pitch search range, converted to a quefrency range of at most TUNER_SIZE / 2 samples
+        float min_frequency = 60;
+        float max_frequency = 1000;
+        // bins more than this far below the strongest bin are raised to that level before taking the logarithm, so
+        // the near silent bins between the harmonics do not dominate the cepstrum
+        float dynamic_range_db = 30;
+    };
+
+    /**
+     * @brief Detects the pitch of TUNER_SIZE samples from the real cepstrum, the inverse FFT of the log magnitude
+     *        spectrum, instead of the harmonic product spectrum.
+     *
+     * The harmonics of a pitched note form a periodic ripple in the log spectrum, which the cepstrum turns into a peak
+     * at the period of the note. That needs one more FFT but no 5x interpolation and no HPS, so it is the cheaper
+     * engine for instruments with strong harmonics. A pure sine has no ripple and is better served by
+     * tuner::realtime_engine.
+     *
+     * The frame is windowed with the same Hanning window as tuner::realtime_engine, and both FFTs run on one plan: the
+     * log spectrum is real and even, so its inverse FFT is its forward FFT divided by TUNER_SIZE. Like
+     * tuner::realtime_engine, everything is allocated by the constructor and process() is noexcept.
+     *
+     * There is no HPS to take the clarity of, so the confidence of a note is the tuner::harmonic_energy_fraction of the
+     * frame alone.
+     */
+    class cepstrum_engine {
+    public:
+        /**
+         * @param sample_rate The sample rate of the frames that will be processed.
+         * @param config The search range and the dynamic range of the log spectrum. If the sample rate is not positive
+         *               or the search range is empty, every call to process() returns realtime_status::not_ready.
+         * @param metrics Optional counters that receive stage timings when built with TUNER_INSTRUMENTATION.
+         */
+        explicit cepstrum_engine(int sample_rate, const tuner::cepstrum_config &config = {},
+                                 tuner::metrics *metrics = nullptr) noexcept;
+
+        ~cepstrum_engine();
+
+        cepstrum_engine(const cepstrum_engine &) = delete;
+
+        cepstrum_engine &operator=(const cepstrum_engine &) = delete;
+
+        /**
+         * @brief Performs tuning on TUNER_SIZE samples.
+         *
+         * @param samples The first of TUNER_SIZE samples.
+         * @param out Receives the detected note. Set to the "LOW" note for realtime_status::low_energy, untouched otherwise.
+         *
+         * @return realtime_status::ok if a note was detected.
+         */
+        tuner::realtime_status process(const float *samples, tuner::realtime_note &out) noexcept;
+
+        [[nodiscard]] bool ready() const noexcept { return fft.get() != nullptr; }
+
+        [[nodiscard]] int sample_rate() const noexcept { return rate; }
+
+    private:
+        // returns the detected pitch and stores its confidence in 'confidence'
+        float analyze(float &confidence) noexcept;
+
+        int rate;
+        tuner::metrics *metrics;
+        // the quefrencies searched, in samples
+        int min_quefrency;
+        int max_quefrency;
+        // the power ratio of dynamic_range_db
+        float floor_ratio;
+        tuner::fft_lease fft;
+        // the windowed frame, then the even extension of the log power spectrum
+        std::array<float, TUNER_SIZE> in;
+        // the spectrum, then the cepstrum times TUNER_SIZE in the real parts
+        std::array<kiss_fft_cpx, TUNER_SIZE / 2 + 1> fft_res;
+    };
+}
+
+#endif //TUNER_CEPSTRUM_H
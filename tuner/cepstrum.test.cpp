@@ -0,0 +1,67 @@
+#include <array>
+#include <cmath>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/cepstrum.hpp>
+#include <tuner/note_table.hpp>
+#include <tuner/test_signals.hpp>
+
+TEST_CASE("[cepstrum_engine] invalid configuration") {
+    tuner::realtime_note n;
+    std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(110.0f, 48000);
+
+    tuner::cepstrum_engine zero_rate(0);
+    REQUIRE_FALSE(zero_rate.ready());
+    REQUIRE(zero_rate.process(m.data(), n) == tuner::realtime_status::not_ready);
+
+    tuner::cepstrum_engine inverted(48000, {500, 100});
+    REQUIRE_FALSE(inverted.ready());
+
+    tuner::cepstrum_engine no_dynamic_range(48000, {60, 1000, 0});
+    REQUIRE_FALSE(no_dynamic_range.ready());
+
+    // above the Nyquist frequency there is no quefrency left to search
+    tuner::cepstrum_engine too_high(48000, {30000, 40000});
+    REQUIRE_FALSE(too_high.ready());
+}
+
+TEST_CASE("[cepstrum_engine] samples are null") {
+    tuner::cepstrum_engine e(48000);
+    tuner::realtime_note n;
+    REQUIRE(e.process(nullptr, n) == tuner::realtime_status::invalid_input);
+}
+
+TEST_CASE("[cepstrum_engine] signal energy is too low") {
+    tuner::cepstrum_engine e(48000);
+    std::array<float, TUNER_SIZE> m = {};
+    tuner::realtime_note n;
+    REQUIRE(e.process(m.data(), n) == tuner::realtime_status::low_energy);
+    REQUIRE(std::string(n.name) == "LOW");
+    REQUIRE(n.actual_frequency == -1);
+}
+
+TEST_CASE("[cepstrum_engine] detects harmonic tones") {
+    for (int sample_rate: {44100, 48000}) {
+        tuner::cepstrum_engine e(sample_rate);
+        for (float frequency: {82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f, 440.0f, 587.33f, 880.0f}) {
+            std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(frequency, sample_rate);
+            tuner::realtime_note n;
+            REQUIRE(e.process(m.data(), n) == tuner::realtime_status::ok);
+            REQUIRE(std::string(n.name) == tuner::note_table<>::match(frequency).name);
+            REQUIRE(std::abs(tuner::note_table<>::cents(n.actual_frequency, frequency)) < 20);
+            // the harmonics of the low E string are only 3.5 bins apart, too close to keep their leakage apart
+            if (frequency > 100) {
+                REQUIRE(n.confidence > 0.5f);
+            }
+        }
+    }
+}
+
+TEST_CASE("[cepstrum_engine] only the search range is searched") {
+    tuner::cepstrum_engine e(48000, {150, 1000});
+    std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(110.0f, 48000);
+    tuner::realtime_note n;
+    REQUIRE(e.process(m.data(), n) == tuner::realtime_status::ok);
+    REQUIRE(n.actual_frequency >= 150);
+}
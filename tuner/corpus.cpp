@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <thread>
+
+#include <tuner/corpus.hpp>
+
+namespace {
+    uint64_t align_up(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // whether 'count' items of 'size' bytes from 'offset' on end at or before 'limit', for counts and offsets read from
+    // an untrusted header, so nothing is multiplied or added that could overflow
+    bool section_fits(uint64_t offset, uint64_t count, uint64_t size, uint64_t limit) {
+        return offset <= limit && (count == 0 || size <= (limit - offset) / count);
+    }
+
+    // trailing number of a file stem, e.g. 12 for "audio-stream-a-12"
+    uint32_t source_index_of(const std::filesystem::path &p) {
+        std::string stem = p.stem().string();
+        size_t digits = stem.size();
+        while (digits > 0 && std::isdigit(static_cast<unsigned char>(stem[digits - 1]))) {
+            digits--;
+        }
+        if (digits == stem.size()) {
+            return 0;
+        }
+
+        return uint32_t(std::strtoul(stem.c_str() + digits, nullptr, 10));
+    }
+}
+
+tuner::corpus_reader::corpus_reader(const std::string &file_path) : file(file_path) {
+    if (file.size() < sizeof(tuner::corpus_header)) {
+        throw tuner::CorpusFormatException();
+    }
+
+    header = reinterpret_cast<const tuner::corpus_header *>(file.data());
+    if (std::memcmp(header->magic, tuner::CORPUS_MAGIC, sizeof(tuner::CORPUS_MAGIC)) != 0 ||
+        header->version != tuner::CORPUS_VERSION) {
+        throw tuner::CorpusFormatException();
+    }
+
+    // each section ends before the next one starts and the records end within the file, so every section does
+    const uint64_t frame_bytes = uint64_t(header->frame_size) * sizeof(float);
+    if (!section_fits(header->labels_offset, header->label_count, sizeof(tuner::corpus_label), header->samples_offset) ||
+        !section_fits(header->samples_offset, header->frame_count, frame_bytes, header->frame_records_offset) ||
+        !section_fits(header->frame_records_offset, header->frame_count, sizeof(tuner::corpus_frame_record), file.size()) ||
+        header->labels_offset % alignof(tuner::corpus_label) != 0 ||
+        header->samples_offset % tuner::CORPUS_SAMPLE_ALIGNMENT != 0 ||
+        header->frame_records_offset % alignof(tuner::corpus_frame_record) != 0) {
+        throw tuner::CorpusFormatException();
+    }
+    const uint64_t samples_end = header->samples_offset + header->frame_count * frame_bytes;
+
+    labels = reinterpret_cast<const tuner::corpus_label *>(file.data() + header->labels_offset);
+    samples = reinterpret_cast<const float *>(file.data() + header->samples_offset);
+    records = reinterpret_cast<const tuner::corpus_frame_record *>(file.data() + header->frame_records_offset);
+
+    // the names are compared as C strings, so each one has to end within its slot
+    for (uint32_t i = 0; i < header->label_count; i++) {
+        if (std::memchr(labels[i].name, '\0', sizeof(labels[i].name)) == nullptr) {
+            throw tuner::CorpusFormatException();
+        }
+    }
+
+    for (uint64_t i = 0; i < header->frame_count; i++) {
+        if (records[i].label_index >= header->label_count) {
+            throw tuner::CorpusFormatException();
+        }
+    }
+
+    file.advise_sequential(header->samples_offset, samples_end - header->samples_offset);
+}
+
+int tuner::corpus_reader::find_label(const std::string &name) const {
+    for (uint32_t i = 0; i < header->label_count; i++) {
+        if (name == labels[i].name) {
+            return int(i);
+        }
+    }
+
+    return -1;
+}
+
+tuner::corpus_frame tuner::corpus_reader::frame(uint64_t index) const {
+    return {
+            samples + index * header->frame_size,
+            records[index].label_index,
+            records[index].source_index
+    };
+}
+
+tuner::corpus_writer::corpus_writer(const std::string &file_path, uint32_t frame_size, uint32_t sample_rate,
+                                    const std::vector<tuner::corpus_label> &labels) : header() {
+    out.open(file_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw tuner::FileOpenException();
+    }
+
+    std::memcpy(header.magic, tuner::CORPUS_MAGIC, sizeof(tuner::CORPUS_MAGIC));
+    header.version = tuner::CORPUS_VERSION;
+    header.frame_size = frame_size;
+    header.sample_rate = sample_rate;
+    header.label_count = uint32_t(labels.size());
+    header.labels_offset = sizeof(tuner::corpus_header);
+    header.samples_offset = align_up(header.labels_offset + labels.size() * sizeof(tuner::corpus_label),
+                                     tuner::CORPUS_SAMPLE_ALIGNMENT);
+
+    // the header is rewritten with the final counts by finish()
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(labels.data()), std::streamsize(labels.size() * sizeof(tuner::corpus_label)));
+    std::vector<char> padding(header.samples_offset - uint64_t(out.tellp()), 0);
+    out.write(padding.data(), std::streamsize(padding.size()));
+}
+
+void tuner::corpus_writer::append(const std::vector<float> &samples, uint32_t label_index, uint32_t source_index) {
+    if (finished || samples.size() != header.frame_size || label_index >= header.label_count) {
+        throw tuner::CorpusFormatException();
+    }
+
+    out.write(reinterpret_cast<const char *>(samples.data()), std::streamsize(samples.size() * sizeof(float)));
+    records.push_back({label_index, source_index});
+}
+
+void tuner::corpus_writer::finish() {
+    if (finished) {
+        return;
+    }
+
+    header.frame_count = records.size();
+    header.frame_records_offset = header.samples_offset + header.frame_count * header.frame_size * sizeof(float);
+    out.write(reinterpret_cast<const char *>(records.data()), std::streamsize(records.size() * sizeof(tuner::corpus_frame_record)));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.close();
+    finished = true;
+}
+
+tuner::corpus_label
+tuner::make_corpus_label(const std::string &name, float expected_frequency, float min_frequency, float max_frequency) {
+    if (name.size() >= tuner::CORPUS_LABEL_NAME_SIZE) {
+        throw tuner::CorpusFormatException();
+    }
+
+    tuner::corpus_label label = {};
+    std::memcpy(label.name, name.c_str(), name.size());
+    label.expected_frequency = expected_frequency;
+    label.min_frequency = min_frequency;
+    label.max_frequency = max_frequency;
+    return label;
+}
+
+std::vector<float> tuner::read_text_frame(const std::string &file_path) {
+    std::vector<float> out_buffer = {};
+
+    std::ifstream audio_file(file_path, std::ios::binary);
+    if (!audio_file.is_open()) {
+        return out_buffer;
+    }
+
+    std::string text((std::istreambuf_iterator<char>(audio_file)), std::istreambuf_iterator<char>());
+    const char *p = text.c_str();
+    while ((p = std::strchr(p, '(')) != nullptr) {
+        char *end = nullptr;
+        float value = std::strtof(p + 1, &end);
+        if (end == p + 1) {
+            break;
+        }
+        out_buffer.push_back(value);
+        p = end;
+    }
+
+    return out_buffer;
+}
+
+std::vector<std::string> tuner::list_text_frames(const std::string &directory) {
+    std::vector<std::filesystem::path> paths;
+    for (const auto &entry: std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            paths.push_back(entry.path());
+        }
+    }
+
+    std::sort(paths.begin(), paths.end(), [](const std::filesystem::path &a, const std::filesystem::path &b) {
+        uint32_t ai = source_index_of(a);
+        uint32_t bi = source_index_of(b);
+        return ai != bi ? ai < bi : a < b;
+    });
+
+    std::vector<std::string> out;
+    out.reserve(paths.size());
+    for (const auto &p: paths) {
+        out.push_back(p.string());
+    }
+
+    return out;
+}
+
+uint64_t tuner::convert_text_corpus(const std::vector<tuner::corpus_source> &sources, const std::string &file_path,
+                                    uint32_t frame_size, uint32_t sample_rate, int threads) {
+    std::vector<tuner::corpus_label> labels;
+    for (const tuner::corpus_source &source: sources) {
+        labels.push_back(tuner::make_corpus_label(source.label, source.expected_frequency, source.min_frequency,
+                                                  source.max_frequency));
+    }
+
+    tuner::corpus_writer writer(file_path, frame_size, sample_rate, labels);
+    uint64_t frames = 0;
+    for (uint32_t label_index = 0; label_index < sources.size(); label_index++) {
+        std::vector<std::string> text_files = tuner::list_text_frames(sources[label_index].directory);
+
+        // parsing dominates the conversion, so parse a directory in parallel and write it in order afterwards
+        std::vector<std::vector<float>> parsed(text_files.size());
+        std::atomic<size_t> next{0};
+        auto parse = [&]() {
+            for (size_t i = next.fetch_add(1); i < text_files.size(); i = next.fetch_add(1)) {
+                parsed[i] = tuner::read_text_frame(text_files[i]);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++) {
+            pool.emplace_back(parse);
+        }
+        parse();
+        for (std::thread &t: pool) {
+            t.join();
+        }
+
+        for (size_t i = 0; i < text_files.size(); i++) {
+            if (parsed[i].size() != frame_size) {
+                continue;
+            }
+            writer.append(parsed[i], label_index, source_index_of(text_files[i]));
+            frames++;
+        }
+    }
+    writer.finish();
+
+    return frames;
+}
@@ -0,0 +1,217 @@
+#ifndef TUNER_CORPUS_H
+#define TUNER_CORPUS_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <tuner/mapped_file.hpp>
+
+namespace tuner {
+
+    struct CorpusFormatException : public std::exception {
+        [[nodiscard]] const char* what() const noexcept override {
+            return "Corpus format exception";
+        }
+    };
+
+    // "TNRCORP" followed by the format version
+    constexpr char CORPUS_MAGIC[8] = {'T', 'N', 'R', 'C', 'O', 'R', 'P', '1'};
+    constexpr uint32_t CORPUS_VERSION = 1;
+    constexpr uint32_t CORPUS_SAMPLE_ALIGNMENT = 64;
+    constexpr int CORPUS_LABEL_NAME_SIZE = 16;
+
+    /**
+     * On-disk layout, all values little-endian:
+     *
+     *   corpus_header
+     *   corpus_label[label_count]
+     *   padding up to a CORPUS_SAMPLE_ALIGNMENT boundary
+     *   float[frame_count][frame_size]        contiguous float32 samples
+     *   corpus_frame_record[frame_count]
+     */
+    struct corpus_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t frame_size;
+        uint32_t sample_rate;
+        uint32_t label_count;
+        uint64_t frame_count;
+        uint64_t labels_offset;
+        uint64_t samples_offset;
+        uint64_t frame_records_offset;
+    };
+
+    struct corpus_label {
+        char name[CORPUS_LABEL_NAME_SIZE];
+        float expected_frequency;
+        float min_frequency;
+        float max_frequency;
+        uint32_t reserved;
+    };
+
+    struct corpus_frame_record {
+        uint32_t label_index;
+        uint32_t source_index;
+    };
+
+    static_assert(sizeof(corpus_header) == 56, "corpus_header must not contain padding");
+    static_assert(sizeof(corpus_label) == 32, "corpus_label must not contain padding");
+    static_assert(sizeof(corpus_frame_record) == 8, "corpus_frame_record must not contain padding");
+
+    /**
+     * @brief A single frame of a corpus. 'samples' points straight into the mapped file.
+     */
+    struct corpus_frame {
+        const float *samples;
+        uint32_t label_index;
+        uint32_t source_index;
+    };
+
+    /**
+     * @brief Describes one directory of text encoded frames (one "(re,im) (re,im) ..." file per frame) and the note it is expected to contain.
+     */
+    struct corpus_source {
+        std::string label;
+        float expected_frequency;
+        float min_frequency;
+        float max_frequency;
+        std::string directory;
+    };
+
+    /**
+     * @brief Zero-copy reader over a memory-mapped binary corpus.
+     */
+    class corpus_reader {
+    public:
+        class iterator {
+        public:
+            iterator(const corpus_reader *reader, uint64_t index) : reader(reader), index(index) {}
+
+            tuner::corpus_frame operator*() const { return reader->frame(index); }
+
+            iterator &operator++() {
+                index++;
+                return *this;
+            }
+
+            bool operator!=(const iterator &other) const { return index != other.index; }
+
+        private:
+            const corpus_reader *reader;
+            uint64_t index;
+        };
+
+        /**
+         * @brief Maps and validates the corpus at 'file_path'.
+         *
+         * @param file_path The path to a file written by corpus_writer.
+         *
+         * @throws FileOpenException If the file cannot be opened.
+         * @throws CorpusFormatException If the file is not a valid corpus.
+         */
+        explicit corpus_reader(const std::string &file_path);
+
+        [[nodiscard]] uint32_t frame_size() const { return header->frame_size; }
+
+        [[nodiscard]] uint32_t sample_rate() const { return header->sample_rate; }
+
+        [[nodiscard]] uint64_t size() const { return header->frame_count; }
+
+        [[nodiscard]] uint32_t label_count() const { return header->label_count; }
+
+        [[nodiscard]] const tuner::corpus_label &label(uint32_t index) const { return labels[index]; }
+
+        /**
+         * @brief Retrieves the index of the label with the given name, or -1 if the corpus has no such label.
+         */
+        [[nodiscard]] int find_label(const std::string &name) const;
+
+        [[nodiscard]] tuner::corpus_frame frame(uint64_t index) const;
+
+        [[nodiscard]] iterator begin() const { return {this, 0}; }
+
+        [[nodiscard]] iterator end() const { return {this, size()}; }
+
+    private:
+        tuner::mapped_file file;
+        const tuner::corpus_header *header;
+        const tuner::corpus_label *labels;
+        const float *samples;
+        const tuner::corpus_frame_record *records;
+    };
+
+    /**
+     * @brief Streams frames into a binary corpus. Samples are written as they are appended; the frame records and the
+     *        final header are written by finish().
+     */
+    class corpus_writer {
+    public:
+        /**
+         * @brief Creates the corpus file at 'file_path' for the given labels.
+         *
+         * @throws FileOpenException If the file cannot be created.
+         */
+        corpus_writer(const std::string &file_path, uint32_t frame_size, uint32_t sample_rate,
+                      const std::vector<tuner::corpus_label> &labels);
+
+        /**
+         * @brief Appends one frame of exactly frame_size samples.
+         *
+         * @throws CorpusFormatException If 'samples' does not hold frame_size values or 'label_index' is out of range.
+         */
+        void append(const std::vector<float> &samples, uint32_t label_index, uint32_t source_index);
+
+        /**
+         * @brief Writes the frame records and the header. No frames can be appended afterwards.
+         */
+        void finish();
+
+    private:
+        std::ofstream out;
+        tuner::corpus_header header;
+        std::vector<tuner::corpus_frame_record> records;
+        bool finished = false;
+    };
+
+    /**
+     * @brief Creates a corpus_label for the note 'name' and its accepted frequency range.
+     *
+     * @throws CorpusFormatException If 'name' is longer than CORPUS_LABEL_NAME_SIZE - 1 characters.
+     */
+    tuner::corpus_label
+    make_corpus_label(const std::string &name, float expected_frequency, float min_frequency, float max_frequency);
+
+    /**
+     * @brief Parses one text encoded frame, i.e. the real parts of a "(re,im) (re,im) ..." sequence.
+     *
+     * @param file_path The path to the text file.
+     *
+     * @return A std::vector<float> containing the real parts in file order. Empty if the file cannot be read.
+     */
+    std::vector<float> read_text_frame(const std::string &file_path);
+
+    /**
+     * @brief Lists the *.txt files of a directory ordered by the number at the end of their name, e.g.
+     *        audio-stream-a-2.txt before audio-stream-a-10.txt.
+     */
+    std::vector<std::string> list_text_frames(const std::string &directory);
+
+    /**
+     * @brief Converts directories of text encoded frames into one binary corpus. Files whose frame size differs from
+     *        'frame_size' are skipped.
+     *
+     * @param sources The directories to convert, one label per directory.
+     * @param file_path The path of the corpus to write.
+     * @param frame_size The number of samples per frame.
+     * @param sample_rate The sample rate the frames were recorded at.
+     * @param threads The number of threads parsing text files in parallel. Frames are written in the same order either way.
+     *
+     * @return The number of frames written.
+     */
+    uint64_t convert_text_corpus(const std::vector<tuner::corpus_source> &sources, const std::string &file_path,
+                                 uint32_t frame_size, uint32_t sample_rate, int threads = 1);
+}
+
+#endif //TUNER_CORPUS_H
@@ -0,0 +1,206 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <tuner/corpus.hpp>
+
+std::string corpus_test_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("tuner-corpus-test-" + name)).string();
+}
+
+// the bytes of a corpus with two labels and two frames of 4 samples
+std::vector<char> valid_corpus_bytes(const std::string &path) {
+    {
+        tuner::corpus_writer writer(path, 4, 48000, {
+                tuner::make_corpus_label("E2", 82.41, 70, 90),
+                tuner::make_corpus_label("A2", 110, 100, 120),
+        });
+        writer.append({0.1, 0.2, 0.3, 0.4}, 0, 1);
+        writer.append({-0.1, -0.2, -0.3, -0.4}, 1, 7);
+        writer.finish();
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+bool corpus_is_rejected(const std::string &path, const std::vector<char> &bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), std::streamsize(bytes.size()));
+    try {
+        tuner::corpus_reader reader(path);
+        return false;
+    } catch (tuner::CorpusFormatException &) {
+        return true;
+    }
+}
+
+TEST_CASE("[make_corpus_label] name and frequencies are stored") {
+    tuner::corpus_label label = tuner::make_corpus_label("E2", 82.41, 70, 90);
+    REQUIRE(std::string(label.name) == "E2");
+    REQUIRE(label.expected_frequency == 82.41f);
+    REQUIRE(label.min_frequency == 70.0f);
+    REQUIRE(label.max_frequency == 90.0f);
+}
+
+TEST_CASE("[make_corpus_label] name is too long") {
+    try {
+        tuner::make_corpus_label("a-very-long-label-name", 1, 0, 2);
+        REQUIRE(false);
+    } catch (tuner::CorpusFormatException &ce) {
+        REQUIRE(std::string(ce.what()) == "Corpus format exception");
+    }
+}
+
+TEST_CASE("[corpus_reader] frames written by corpus_writer are read back") {
+    std::string path = corpus_test_path("round-trip.corpus");
+    {
+        tuner::corpus_writer writer(path, 4, 48000, {
+                tuner::make_corpus_label("E2", 82.41, 70, 90),
+                tuner::make_corpus_label("A2", 110, 100, 120),
+        });
+        writer.append({0.1, 0.2, 0.3, 0.4}, 0, 1);
+        writer.append({-0.1, -0.2, -0.3, -0.4}, 1, 7);
+        writer.finish();
+    }
+
+    tuner::corpus_reader reader(path);
+    REQUIRE(reader.frame_size() == 4);
+    REQUIRE(reader.sample_rate() == 48000);
+    REQUIRE(reader.size() == 2);
+    REQUIRE(reader.label_count() == 2);
+    REQUIRE(reader.find_label("A2") == 1);
+    REQUIRE(reader.find_label("B3") == -1);
+    REQUIRE(reader.label(0).max_frequency == 90.0f);
+
+    tuner::corpus_frame second = reader.frame(1);
+    REQUIRE(second.label_index == 1);
+    REQUIRE(second.source_index == 7);
+    REQUIRE(second.samples[3] == -0.4f);
+
+    int count = 0;
+    for (tuner::corpus_frame frame: reader) {
+        REQUIRE(reinterpret_cast<uintptr_t>(frame.samples) % alignof(float) == 0);
+        count++;
+    }
+    REQUIRE(count == 2);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[corpus_writer] frame of the wrong size") {
+    std::string path = corpus_test_path("wrong-size.corpus");
+    tuner::corpus_writer writer(path, 4, 48000, {tuner::make_corpus_label("E2", 82.41, 70, 90)});
+    try {
+        writer.append({0.1, 0.2}, 0, 1);
+        REQUIRE(false);
+    } catch (tuner::CorpusFormatException &ce) {
+        REQUIRE(std::string(ce.what()) == "Corpus format exception");
+    }
+    writer.finish();
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[corpus_reader] file is not a corpus") {
+    std::string path = corpus_test_path("not-a-corpus.corpus");
+    std::ofstream(path) << "this is not a corpus file, but it is long enough to hold a header";
+
+    try {
+        tuner::corpus_reader reader(path);
+        REQUIRE(false);
+    } catch (tuner::CorpusFormatException &ce) {
+        REQUIRE(std::string(ce.what()) == "Corpus format exception");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[corpus_reader] counts whose section sizes overflow") {
+    std::string path = corpus_test_path("overflow.corpus");
+    const std::vector<char> valid = valid_corpus_bytes(path);
+    REQUIRE_FALSE(corpus_is_rejected(path, valid));
+
+    // 2^62 frames of 16 bytes wrap around to 0 bytes of samples and of records
+    std::vector<char> bytes = valid;
+    uint64_t frame_count = uint64_t(1) << 62;
+    std::memcpy(bytes.data() + offsetof(tuner::corpus_header, frame_count), &frame_count, sizeof(frame_count));
+    REQUIRE(corpus_is_rejected(path, bytes));
+
+    // an offset close to 2^64 wraps around past the end of the section
+    bytes = valid;
+    uint64_t labels_offset = ~uint64_t(0) - 31;
+    std::memcpy(bytes.data() + offsetof(tuner::corpus_header, labels_offset), &labels_offset, sizeof(labels_offset));
+    REQUIRE(corpus_is_rejected(path, bytes));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[corpus_reader] file is truncated") {
+    std::string path = corpus_test_path("truncated.corpus");
+    std::vector<char> bytes = valid_corpus_bytes(path);
+    bytes.resize(bytes.size() - 1);
+    REQUIRE(corpus_is_rejected(path, bytes));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[corpus_reader] label name is not terminated") {
+    std::string path = corpus_test_path("unterminated.corpus");
+    std::vector<char> bytes = valid_corpus_bytes(path);
+    std::memset(bytes.data() + sizeof(tuner::corpus_header), 'E', tuner::CORPUS_LABEL_NAME_SIZE);
+    REQUIRE(corpus_is_rejected(path, bytes));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[corpus_reader] file does not exist") {
+    try {
+        tuner::corpus_reader reader(corpus_test_path("missing.corpus"));
+        REQUIRE(false);
+    } catch (tuner::FileOpenException &fe) {
+        REQUIRE(std::string(fe.what()) == "File open exception");
+    }
+}
+
+TEST_CASE("[read_text_frame] real parts are parsed in order") {
+    std::string path = corpus_test_path("frame.txt");
+    std::ofstream(path) << "(-6.104e-05,0) (9.156e-05,0) (0,0) (0.0001221,0)";
+
+    std::vector<float> result = tuner::read_text_frame(path);
+    std::vector<float> expected = {-6.104e-05f, 9.156e-05f, 0.0f, 0.0001221f};
+    REQUIRE(result == expected);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[read_text_frame] file does not exist") {
+    REQUIRE(tuner::read_text_frame(corpus_test_path("missing.txt")).empty());
+}
+
+TEST_CASE("[convert_text_corpus] files are converted in numeric order") {
+    std::filesystem::path directory = corpus_test_path("frames");
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory / "audio-stream-e2-10.txt") << "(3,0) (3,0)";
+    std::ofstream(directory / "audio-stream-e2-2.txt") << "(2,0) (2,0)";
+    std::ofstream(directory / "audio-stream-e2-1.txt") << "(1,0) (1,0)";
+    std::ofstream(directory / "audio-stream-e2-3.txt") << "(1,0)"; // wrong frame size, skipped
+
+    std::string path = corpus_test_path("converted.corpus");
+    uint64_t frames = tuner::convert_text_corpus({{"E2", 82.41, 70, 90, directory.string()}}, path, 2, 48000);
+    REQUIRE(frames == 3);
+
+    tuner::corpus_reader reader(path);
+    REQUIRE(reader.frame(0).source_index == 1);
+    REQUIRE(reader.frame(1).source_index == 2);
+    REQUIRE(reader.frame(2).source_index == 10);
+    REQUIRE(reader.frame(2).samples[1] == 3.0f);
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove(path);
+}
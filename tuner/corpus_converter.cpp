@@ -0,0 +1,43 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include <tuner/corpus.hpp>
+#include <tuner/global.hpp>
+
+/**
+ * Converts directories of text encoded frames into a binary corpus.
+ *
+ *   corpus_converter <output> <sample_rate> <label>:<expected_hz>:<min_hz>:<max_hz>:<directory> [...]
+ *
+ * e.g.
+ *
+ *   corpus_converter acceptance.corpus 48000 E2:82.41:70:90:./acceptance-test-assets/e2-audio-stream
+ */
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0]
+                  << " <output> <sample_rate> <label>:<expected_hz>:<min_hz>:<max_hz>:<directory> [...]" << std::endl;
+        return 1;
+    }
+
+    std::vector<tuner::corpus_source> sources;
+    for (int i = 3; i < argc; i++) {
+        std::stringstream spec(argv[i]);
+        std::string label, expected, min, max, directory;
+        if (!std::getline(spec, label, ':') || !std::getline(spec, expected, ':') || !std::getline(spec, min, ':') ||
+            !std::getline(spec, max, ':') || !std::getline(spec, directory)) {
+            std::cerr << "invalid source: " << argv[i] << std::endl;
+            return 1;
+        }
+        sources.push_back({label, std::stof(expected), std::stof(min), std::stof(max), directory});
+    }
+
+    uint64_t frames = tuner::convert_text_corpus(sources, argv[1], TUNER_SIZE, uint32_t(std::atoi(argv[2])),
+                                                 int(std::max(1u, std::thread::hardware_concurrency())));
+    std::cout << "wrote " << frames << " frames to " << argv[1] << std::endl;
+
+    return 0;
+}
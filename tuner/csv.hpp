@@ -0,0 +1,27 @@
+#ifndef TUNER_CSV_H
+#define TUNER_CSV_H
+
+#include <string>
+
+namespace tuner {
+
+    /**
+     * @brief Quotes a text field of a CSV row as RFC 4180 specifies: the field is enclosed in double quotes and every
+     *        double quote in it is doubled, so commas, quotes and line breaks, e.g. in a file path, stay in the field.
+     */
+    inline std::string csv_field(const std::string &s) {
+        std::string out;
+        out.reserve(s.size() + 2);
+        out += '"';
+        for (char c: s) {
+            if (c == '"') {
+                out += '"';
+            }
+            out += c;
+        }
+        out += '"';
+        return out;
+    }
+}
+
+#endif //TUNER_CSV_H
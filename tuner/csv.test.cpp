@@ -0,0 +1,13 @@
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/csv.hpp>
+
+TEST_CASE("[csv_field] plain text is quoted") {
+    REQUIRE(tuner::csv_field("tracks/e2.wav") == "\"tracks/e2.wav\"");
+    REQUIRE(tuner::csv_field("") == "\"\"");
+}
+
+TEST_CASE("[csv_field] a path with a comma, quotes and a line break stays one field") {
+    REQUIRE(tuner::csv_field("takes/E2, \"loud\"\nfinal.wav") == "\"takes/E2, \"\"loud\"\"\nfinal.wav\"");
+}
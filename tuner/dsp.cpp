@@ -1,7 +1,11 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include <tuner/dsp.hpp>
 #include <tuner/math.hpp>
+#include <tuner/vector.hpp>
+#include <tuner/window_table.hpp>
 
 bool tuner::signal_energy_is_too_low(std::array<float, TUNER_SIZE> m) {
     float signal_pow = (std::pow(tuner::euclidean_norm(m), float(2)) / float(m.size()));
@@ -10,10 +14,10 @@ bool tuner::signal_energy_is_too_low(std::array<float, TUNER_SIZE> m) {
 
 std::array<float, TUNER_SIZE> tuner::apply_hanning_window(std::array<float, TUNER_SIZE> audio_stream_buffer) {
     std::array<float, TUNER_SIZE> with_hanning_window = {};
+    // https://en.wikipedia.org/wiki/Hann_function
+    const std::array<float, TUNER_SIZE> &hanning = tuner::HANN_WINDOW<TUNER_SIZE>;
     for (int i = 0; i < audio_stream_buffer.size(); i++) {
-        // https://en.wikipedia.org/wiki/Hann_function
-        float multiplier = 0.5f * (1.0f - cos(2.0f * static_cast<float>(M_PI) * static_cast<float>(i) / static_cast<float>(audio_stream_buffer.size())));
-        with_hanning_window[i] = multiplier * audio_stream_buffer[i];
+        with_hanning_window[i] = hanning[i] * audio_stream_buffer[i];
     }
 
     return with_hanning_window;
@@ -22,7 +26,7 @@ std::array<float, TUNER_SIZE> tuner::apply_hanning_window(std::array<float, TUNE
 std::array<float, TUNER_SIZE / 2> tuner::calculate_magnitude_spec(float audio_buffer_stream_freq[TUNER_SIZE / 2]) {
     std::array<float, TUNER_SIZE / 2> out = {};
     for (int i = 0; i < TUNER_SIZE / 2; i++) {
-        out[i] = abs(audio_buffer_stream_freq[i]);
+        out[i] = std::abs(audio_buffer_stream_freq[i]);
     }
 
     return out;
@@ -40,58 +44,251 @@ std::array<float, TUNER_SIZE / 2> tuner::suppress_below_octave_bands(std::array<
         throw tuner::DivisionByZeroException();
     }
     std::array<float, TUNER_SIZE / 2> out = mag_spec;
-    for (int i = 0; i < tuner::OCTAVE_BANDS.size(); i++) {
-        int start_index = tuner::OCTAVE_BANDS[i] / int(delta_frequency);
-        int end_index = tuner::OCTAVE_BANDS[i + 1] / int(delta_frequency);
-        if (mag_spec.size() <= end_index) {
-            end_index = mag_spec.size();
-        }
+    tuner::suppress_below_octave_bands(out.data(), int(out.size()), delta_frequency);
 
-        float p_n = std::pow(tuner::euclidean_norm(mag_spec, start_index, end_index), float(2));
+    return out;
+}
+
+namespace {
+    void suppress_band(float *mag_spec, int start_index, int end_index) noexcept {
+        float sum = 0;
+        for (int j = start_index; j < end_index; j++) {
+            sum += std::pow(std::abs(mag_spec[j]), float(2));
+        }
+        float p_n = std::pow(std::pow(sum, float(1) / float(2)), float(2));
         int dividend = end_index - start_index;
         float avg_energy_per_freq = p_n / float(dividend);
         avg_energy_per_freq = std::pow(avg_energy_per_freq, float(0.5));
         for (int j = start_index; j < end_index; j++) {
             if (mag_spec[j] <= tuner::WHITE_NOISE_THRESHOLD * avg_energy_per_freq) {
-                out[j] = 0;
+                mag_spec[j] = 0;
             }
         }
     }
+}
 
-    return out;
+void tuner::suppress_below_octave_bands(float *mag_spec, int size, float delta_frequency) noexcept {
+    int delta = int(delta_frequency);
+    if (delta <= 0) {
+        return;
+    }
+
+    // bands do not overlap, so each band can be suppressed in place right after its energy was measured
+    for (size_t i = 0; i + 1 < tuner::OCTAVE_BANDS.size(); i++) {
+        int start_index = tuner::OCTAVE_BANDS[i] / delta;
+        int end_index = std::min(tuner::OCTAVE_BANDS[i + 1] / delta, size);
+        if (start_index < end_index) {
+            suppress_band(mag_spec, start_index, end_index);
+        }
+    }
 }
 
-std::vector<float> tuner::calculate_hps(std::vector<float> input) {
-    std::vector<float> copy = input;
-
-    for (int i = 0; i < tuner::NUM_HPS; i++) {
-        int hps_len = int(std::ceil(input.size() / (i + 1)));
-        int every_n = i + 1;
-        std::vector<float> temp;
-        for (int j = 0; j < hps_len; j++) {
-            temp.push_back(copy[j] * input[j * every_n]);
+std::vector<tuner::bin_range> tuner::octave_band_ranges(int size, float delta_frequency) {
+    std::vector<tuner::bin_range> bands;
+    int delta = int(delta_frequency);
+    if (delta <= 0) {
+        return bands;
+    }
+
+    for (size_t i = 0; i + 1 < tuner::OCTAVE_BANDS.size(); i++) {
+        int start_index = tuner::OCTAVE_BANDS[i] / delta;
+        int end_index = std::min(tuner::OCTAVE_BANDS[i + 1] / delta, size);
+        if (start_index < end_index) {
+            bands.push_back({start_index, end_index});
+        }
+    }
+    return bands;
+}
+
+void tuner::suppress_below_octave_bands(float *mag_spec, const tuner::bin_range *bands, int count) noexcept {
+    for (int i = 0; i < count; i++) {
+        suppress_band(mag_spec, bands[i].start, bands[i].end);
+    }
+}
+
+namespace {
+    // the std::allocator and std::pmr overloads share these, so both produce the same values
+
+    template<typename Floats>
+    void normalize(Floats &mag_s_i) {
+        float norm_val = tuner::euclidean_norm(mag_s_i);
+
+        for (size_t i = 0; i < mag_s_i.size(); i++) {
+            mag_s_i[i] = mag_s_i[i] / norm_val;
         }
-        if (temp.size() == 0) {
-            break;
+    }
+
+    template<typename Floats>
+    Floats hps_of(const Floats &input, const typename Floats::allocator_type &allocator) {
+        Floats copy(input, allocator);
+
+        for (int i = 0; i < tuner::NUM_HPS; i++) {
+            int hps_len = int(std::ceil(input.size() / (i + 1)));
+            int every_n = i + 1;
+            Floats temp(allocator);
+            // a monotonic resource never reuses what growing would give back
+            temp.reserve(hps_len);
+            for (int j = 0; j < hps_len; j++) {
+                temp.push_back(copy[j] * input[j * every_n]);
+            }
+            if (temp.size() == 0) {
+                break;
+            }
+            copy = std::move(temp);
         }
-        copy = temp;
+
+        return copy;
     }
 
-    return copy;
+    template<typename Floats>
+    float max_frequency_of(const Floats &m, int sample_rate) {
+        size_t max_index = 0;
+        float tmp_max_freq = 0;
+        for (size_t i = 0; i < m.size(); i++) {
+            if (m[i] > tmp_max_freq) {
+                tmp_max_freq = m[i];
+                max_index = i;
+            }
+        }
+
+        float max_freq = float(max_index) * (float(sample_rate) / float(TUNER_SIZE)) / float(tuner::NUM_HPS);
+
+        return max_freq;
+    }
+}
+
+std::vector<float> tuner::interpolate_spec(std::array<float, TUNER_SIZE / 2> mag_s) {
+    std::vector<float> mag_s_i = tuner::interpolate(
+            tuner::new_vector_with_values_between(0, mag_s.size(), float(1) / float(tuner::NUM_HPS)),
+            tuner::new_vector_with_values_between(0, mag_s.size()),
+            mag_s);
+
+    normalize(mag_s_i);
+
+    return mag_s_i;
+}
+
+std::pmr::vector<float>
+tuner::interpolate_spec(const std::array<float, TUNER_SIZE / 2> &mag_s, std::pmr::memory_resource *resource) {
+    std::pmr::vector<float> mag_s_i = tuner::interpolate(
+            tuner::new_vector_with_values_between(0, mag_s.size(), float(1) / float(tuner::NUM_HPS), resource),
+            tuner::new_vector_with_values_between(0, mag_s.size(), 1, resource),
+            mag_s, resource);
+
+    normalize(mag_s_i);
+
+    return mag_s_i;
+}
+
+std::vector<float> tuner::calculate_hps(std::vector<float> input) {
+    return hps_of(input, {});
+}
+
+std::pmr::vector<float> tuner::calculate_hps(const std::pmr::vector<float> &input, std::pmr::memory_resource *resource) {
+    return hps_of(input, resource);
 }
 
 float tuner::get_max_frequency(std::vector<float> m, int sample_rate) {
-    int max_index = 0;
-    float tmp_max_freq = 0;
-    for (int i = 0; i < m.size(); i++) {
-        if (m[i] > tmp_max_freq) {
-            tmp_max_freq = m[i];
-            max_index = i;
+    return max_frequency_of(m, sample_rate);
+}
+
+float tuner::get_max_frequency(const std::pmr::vector<float> &m, int sample_rate) {
+    return max_frequency_of(m, sample_rate);
+}
+
+int tuner::hps_candidates(const float *hps, int size, int sample_rate, int k, tuner::pitch_candidate *out) noexcept {
+    if (k <= 0) {
+        return 0;
+    }
+
+    // the maxima kept so far, highest first; a later maximum only gets ahead of an earlier one if it is higher, so the
+    // first candidate is the first highest value, as in get_max_frequency
+    int count = 0;
+    for (int i = 0; i < size; i++) {
+        float value = hps[i];
+        bool peak = value > 0 && (i == 0 || value > hps[i - 1]) && (i + 1 == size || value >= hps[i + 1]);
+        if (!peak || (count == k && value <= out[k - 1].salience)) {
+            continue;
+        }
+
+        int position = std::min(count, k - 1);
+        while (position > 0 && out[position - 1].salience < value) {
+            out[position] = out[position - 1];
+            position--;
         }
+        out[position].frequency = float(i) * (float(sample_rate) / float(TUNER_SIZE)) / float(tuner::NUM_HPS);
+        out[position].salience = value;
+        count = std::min(count + 1, k);
+    }
+
+    for (int c = count - 1; c >= 0; c--) {
+        out[c].salience /= out[0].salience;
     }
+    return count;
+}
 
-    float max_freq = float(max_index) * (float(sample_rate) / float(TUNER_SIZE)) / float(tuner::NUM_HPS);
+float tuner::hps_clarity(const float *hps, int size, int stride) noexcept {
+    if (size <= 1) {
+        return 0;
+    }
+
+    float peak = 0;
+    double sum = 0;
+    for (int i = 0; i < size; i++) {
+        float value = hps[size_t(i) * stride];
+        peak = std::max(peak, value);
+        sum += value;
+    }
+    if (!(peak > 0)) {
+        return 0;
+    }
 
-    return max_freq;
+    float ratio = peak / float(sum / double(size));
+    return std::clamp(std::log(ratio) / std::log(float(size)), 0.0f, 1.0f);
 }
 
+float tuner::harmonic_energy_fraction(const float *power, int size, int first_bin, float fundamental_bin) noexcept {
+    first_bin = std::max(first_bin, 0);
+    if (first_bin >= size || !(fundamental_bin > 0) || fundamental_bin < float(first_bin)) {
+        return 0;
+    }
+
+    double total = 0;
+    for (int k = first_bin; k < size; k++) {
+        total += power[k];
+    }
+    if (!(total > 0)) {
+        return 0;
+    }
+
+    // the neighbours catch the leakage of a harmonic between two bins, but would cover every bin of a low fundamental
+    const int half_width = fundamental_bin >= 4 ? 1 : 0;
+    double harmonic = 0;
+    int covered = 0;
+    int next = first_bin;
+    for (int h = 1; float(h) * fundamental_bin < float(size); h++) {
+        int centre = int(std::lround(float(h) * fundamental_bin));
+        for (int k = std::max(next, centre - half_width); k <= std::min(size - 1, centre + half_width); k++) {
+            harmonic += power[k];
+            covered++;
+        }
+        next = std::max(next, centre + half_width + 1);
+    }
+
+    float chance = float(covered) / float(size - first_bin);
+    if (chance >= 1) {
+        return 0;
+    }
+    float fraction = float(harmonic / total);
+    return std::clamp((fraction - chance) / (1 - chance), 0.0f, 1.0f);
+}
+
+float tuner::pitch_confidence(const float *hps, int hps_size, int hps_stride, const float *power, int sample_rate,
+                              float frequency) noexcept {
+    // the bins the hum suppression zeroes are left out
+    float delta_frequency = float(sample_rate) / float(TUNER_SIZE);
+    int first_bin = int(62 / delta_frequency);
+
+    return tuner::hps_clarity(hps, hps_size, hps_stride) *
+           tuner::harmonic_energy_fraction(power, TUNER_SIZE / 2, first_bin, frequency / delta_frequency);
+}
@@ -2,6 +2,7 @@
 #define TUNER_DSP_H
 
 #include <array>
+#include <memory_resource>
 #include <vector>
 
 #include <tuner/global.hpp>
@@ -24,6 +25,19 @@ namespace tuner {
             25600
     };
 
+    // a local maximum of a harmonic product spectrum
+    struct pitch_candidate {
+        float frequency = -1;
+        // the value of the maximum relative to the highest one of its spectrum, in (0, 1]
+        float salience = 0;
+    };
+
+    // the bins [start, end) of a magnitude spectrum
+    struct bin_range {
+        int start;
+        int end;
+    };
+
     /**
      * @brief Checks if the signal energy is too low based on the values in the std::array 'm',
      *        and returns a bool indicating whether the signal energy is too low or not.
@@ -77,6 +91,41 @@ namespace tuner {
     std::array<float, TUNER_SIZE / 2>
     suppress_below_octave_bands(std::array<float, TUNER_SIZE / 2> mag_spec, float delta_frequency);
 
+    /**
+     * @brief Suppresses values below the octave bands of the first 'size' bins of 'mag_spec' in place. The allocation and
+     *        exception free form of the overload above, which does nothing when 'delta_frequency' is below one.
+     */
+    void suppress_below_octave_bands(float *mag_spec, int size, float delta_frequency) noexcept;
+
+    /**
+     * @brief The bins of the OCTAVE_BANDS that suppress_below_octave_bands suppresses, leaving out empty bands.
+     *
+     * @param size The number of bins of the magnitude spectrum.
+     * @param delta_frequency The frequency resolution of the magnitude spectrum.
+     */
+    std::vector<tuner::bin_range> octave_band_ranges(int size, float delta_frequency);
+
+    /**
+     * @brief suppress_below_octave_bands with bands computed once by octave_band_ranges.
+     */
+    void suppress_below_octave_bands(float *mag_spec, const tuner::bin_range *bands, int count) noexcept;
+
+    /**
+     * @brief Resamples the magnitude spectrum 'mag_s' onto a grid NUM_HPS times finer using linear interpolation,
+     *        and returns the result normalized to unit euclidean norm.
+     *
+     * @param mag_s The input std::array<float, TUNER_SIZE / 2> representing the magnitude spectrum.
+     *
+     * @return A new std::vector<float> of NUM_HPS * TUNER_SIZE / 2 values containing the normalized, interpolated spectrum.
+     */
+    std::vector<float> interpolate_spec(std::array<float, TUNER_SIZE / 2> mag_s);
+
+    /**
+     * @brief interpolate_spec, allocating the result and every temporary from 'resource', e.g. a per-frame arena.
+     */
+    std::pmr::vector<float>
+    interpolate_spec(const std::array<float, TUNER_SIZE / 2> &mag_s, std::pmr::memory_resource *resource);
+
     /**
      * @brief Calculates the Harmonic Product Spectrum (HPS) of the input std::vector 'input' and returns the result as a new std::vector<float>.
      *
@@ -86,6 +135,11 @@ namespace tuner {
      */
     std::vector<float> calculate_hps(std::vector<float> input);
 
+    /**
+     * @brief calculate_hps, allocating the result and every temporary from 'resource' and without copying 'input'.
+     */
+    std::pmr::vector<float> calculate_hps(const std::pmr::vector<float> &input, std::pmr::memory_resource *resource);
+
     /**
      * @brief Retrieves the maximum frequency from the given std::vector 'm' representing the frequency spectrum,
      *        based on the provided 'sample_rate', and returns the result as a float.
@@ -96,6 +150,71 @@ namespace tuner {
      * @return A float representing the maximum frequency present in the frequency spectrum.
      */
     float get_max_frequency(std::vector<float> m, int sample_rate);
+
+    /**
+     * @brief get_max_frequency of a std::pmr::vector, without copying it.
+     */
+    float get_max_frequency(const std::pmr::vector<float> &m, int sample_rate);
+
+    /**
+     * @brief The 'k' highest local maxima of a harmonic product spectrum, highest first, instead of only the highest
+     *        one that get_max_frequency returns. The first candidate has the frequency of get_max_frequency.
+     *
+     * @param hps The harmonic product spectrum of a TUNER_SIZE frame, 'size' values.
+     * @param sample_rate The sample rate of the frame.
+     * @param out Receives up to 'k' candidates.
+     *
+     * @return The number of candidates written, 0 for an all zero spectrum.
+     */
+    int hps_candidates(const float *hps, int size, int sample_rate, int k, tuner::pitch_candidate *out) noexcept;
+
+    /**
+     * @brief How clearly the highest value of a harmonic product spectrum stands out: the logarithm of its ratio to the
+     *        mean of the spectrum, relative to the logarithm of 'size', the ratio of a spectrum with a single non-zero
+     *        value.
+     *
+     * @param hps The harmonic product spectrum, 'size' non-negative values.
+     * @param size The number of values of 'hps'.
+     * @param stride The distance between consecutive values of 'hps'.
+     *
+     * @return A value in [0, 1], 0 for an empty or all zero spectrum.
+     */
+    float hps_clarity(const float *hps, int size, int stride = 1) noexcept;
+
+    /**
+     * @brief The fraction of the power of a spectrum that lies on the harmonics of a fundamental, above the fraction a
+     *        flat spectrum would have there.
+     *
+     * Every harmonic covers its closest bin, and both neighbours when the harmonics are at least four bins apart.
+     *
+     * @param power The power spectrum, 'size' values.
+     * @param size The number of values of 'power'.
+     * @param first_bin The first bin that is counted, e.g. the first bin above the hum suppression.
+     * @param fundamental_bin The fundamental frequency in bins, may be fractional.
+     *
+     * @return A value in [0, 1]: 1 when all of the power lies on the harmonics and 0 when they hold no more than their
+     *         share of the bins, or when the fundamental is below 'first_bin'.
+     */
+    float harmonic_energy_fraction(const float *power, int size, int first_bin, float fundamental_bin) noexcept;
+
+    /**
+     * @brief The confidence of a pitch found by the HPS pipeline, hps_clarity of its HPS times the
+     *        harmonic_energy_fraction of the frame above the hum suppression.
+     *
+     * A clean harmonic tone scores about 0.9, a tone in noise or a chord less and noise close to 0.
+     *
+     * @param hps The part of the harmonic product spectrum the pitch was picked from, 'hps_size' values.
+     * @param hps_size The number of values of 'hps'.
+     * @param hps_stride The distance between consecutive values of 'hps'.
+     * @param power The power spectrum of the frame before noise suppression, TUNER_SIZE / 2 values, see
+     *              tuner::power_spectrum.
+     * @param sample_rate The sample rate of the frame.
+     * @param frequency The detected pitch in Hz.
+     *
+     * @return A value in [0, 1].
+     */
+    float pitch_confidence(const float *hps, int hps_size, int hps_stride, const float *power, int sample_rate,
+                           float frequency) noexcept;
 }
 
 #endif //TUNER_DSP_H
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 
 #include <catch2/catch_test_macros.hpp>
@@ -5,6 +6,7 @@
 #include <tuner/math.hpp>
 
 #include <cmath>
+#include <vector>
 
 TEST_CASE("[signal_energy_is_too_low] signal energy is above the threshold") {
     std::array<float, TUNER_SIZE> m = {1.0, 2.0, 3.0, 4.0, 5.0};
@@ -100,6 +102,17 @@ TEST_CASE("[calculate_magnitude_spec] alternate positive and negative elements")
 }
 
 
+TEST_CASE("[calculate_magnitude_spec] fractional elements are not truncated") {
+    float audio_stream_buffer[TUNER_SIZE / 2] = {};
+    for (size_t i = 0; i < TUNER_SIZE / 2; i++) {
+        audio_stream_buffer[i] = i % 2 == 0 ? 0.25f : -1.75f;
+    }
+    std::array<float, TUNER_SIZE / 2> result = tuner::calculate_magnitude_spec(audio_stream_buffer);
+    for (size_t i = 0; i < TUNER_SIZE / 2; i++) {
+        REQUIRE(result[i] == (i % 2 == 0 ? 0.25f : 1.75f));
+    }
+}
+
 TEST_CASE("[calculate_magnitude_spec] all negative elements") {
     float audio_stream_buffer[TUNER_SIZE / 2] = {};
     for (size_t i = 0; i < TUNER_SIZE / 2; i++) {
@@ -302,3 +315,92 @@ TEST_CASE("[get_max_frequency] magnitude spectrum contains negative value") {
 
 
 
+
+TEST_CASE("[calculate_hps | pmr] matches calculate_hps") {
+    std::vector<float> input(TUNER_SIZE / 2 * 5);
+    for (int i = 0; i < int(input.size()); i++) {
+        input[i] = float((i * 13) % 29) / 29.0f;
+    }
+    std::vector<float> expected = tuner::calculate_hps(input);
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<float> pmr_input(input.begin(), input.end(), &arena);
+    std::pmr::vector<float> result = tuner::calculate_hps(pmr_input, &arena);
+
+    REQUIRE(result.get_allocator().resource() == &arena);
+    REQUIRE(std::vector<float>(result.begin(), result.end()) == expected);
+    REQUIRE(tuner::get_max_frequency(result, 48000) == tuner::get_max_frequency(expected, 48000));
+}
+
+TEST_CASE("[hps_candidates] local maxima, highest first") {
+    std::vector<float> m = {1.0, 0.0, 5.0, 0.0, 8.0, 0.0, 2.0, 2.0, 0.0, 4.0};
+    int sample_rate = 44100;
+    std::vector<tuner::pitch_candidate> c(10);
+
+    REQUIRE(tuner::hps_candidates(m.data(), int(m.size()), sample_rate, 10, c.data()) == 5);
+    REQUIRE(c[0].frequency == tuner::get_max_frequency(m, sample_rate));
+    REQUIRE(c[0].salience == 1.0f);
+    REQUIRE(c[1].frequency == convert_to_frequency(2, sample_rate));
+    REQUIRE(c[1].salience == 5.0f / 8.0f);
+    // maxima at either end count as well
+    REQUIRE(c[2].frequency == convert_to_frequency(9, sample_rate));
+    REQUIRE(c[4].frequency == convert_to_frequency(0, sample_rate));
+    // the first of a plateau
+    REQUIRE(c[3].frequency == convert_to_frequency(6, sample_rate));
+    REQUIRE(c[3].salience == 2.0f / 8.0f);
+
+    REQUIRE(tuner::hps_candidates(m.data(), int(m.size()), sample_rate, 2, c.data()) == 2);
+    REQUIRE(c[1].frequency == convert_to_frequency(2, sample_rate));
+    REQUIRE(tuner::hps_candidates(m.data(), int(m.size()), sample_rate, 0, c.data()) == 0);
+
+    std::vector<float> zeroes(10, 0.0f);
+    REQUIRE(tuner::hps_candidates(zeroes.data(), int(zeroes.size()), sample_rate, 4, c.data()) == 0);
+}
+
+TEST_CASE("[hps_clarity] a single peak, a flat spectrum and no spectrum") {
+    std::vector<float> hps(100, 0.0f);
+    REQUIRE(tuner::hps_clarity(hps.data(), 100) == 0);
+    REQUIRE(tuner::hps_clarity(hps.data(), 0) == 0);
+
+    hps[42] = 3;
+    REQUIRE(std::abs(tuner::hps_clarity(hps.data(), 100) - 1) < 1e-6f);
+
+    std::fill(hps.begin(), hps.end(), 3.0f);
+    REQUIRE(tuner::hps_clarity(hps.data(), 100) == 0);
+
+    // every other value of an interleaved spectrum
+    std::fill(hps.begin(), hps.end(), 0.0f);
+    hps[10] = 1;
+    hps[11] = 5;
+    REQUIRE(std::abs(tuner::hps_clarity(hps.data(), 50, 2) - 1) < 1e-6f);
+    REQUIRE(std::abs(tuner::hps_clarity(hps.data() + 1, 50, 2) - 1) < 1e-6f);
+}
+
+TEST_CASE("[harmonic_energy_fraction] power on the harmonics, everywhere and below the first bin") {
+    std::vector<float> power(512, 0.0f);
+    for (int h = 1; h * 10 < 512; h++) {
+        power[h * 10] = 1.0f / float(h);
+    }
+    REQUIRE(tuner::harmonic_energy_fraction(power.data(), 512, 2, 10.0f) == 1);
+    // a fundamental between the harmonics
+    REQUIRE(tuner::harmonic_energy_fraction(power.data(), 512, 2, 15.0f) < 0.5f);
+    REQUIRE(tuner::harmonic_energy_fraction(power.data(), 512, 12, 10.0f) == 0);
+
+    std::fill(power.begin(), power.end(), 1.0f);
+    REQUIRE(tuner::harmonic_energy_fraction(power.data(), 512, 2, 10.0f) == 0);
+    REQUIRE(tuner::harmonic_energy_fraction(power.data(), 512, 2, 0.0f) == 0);
+}
+
+TEST_CASE("[interpolate_spec | pmr] matches interpolate_spec and allocates from the resource") {
+    std::array<float, TUNER_SIZE / 2> mag_s{};
+    for (int i = 0; i < int(mag_s.size()); i++) {
+        mag_s[i] = float((i * 37) % 101) / 100.0f;
+    }
+    std::vector<float> expected = tuner::interpolate_spec(mag_s);
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<float> result = tuner::interpolate_spec(mag_s, &arena);
+
+    REQUIRE(result.get_allocator().resource() == &arena);
+    REQUIRE(std::vector<float>(result.begin(), result.end()) == expected);
+}
@@ -0,0 +1,210 @@
+#include <algorithm>
+
+#include <tuner/engine.hpp>
+#include <tuner/dsp.hpp>
+#include <tuner/kernels.hpp>
+#include <tuner/math.hpp>
+#include <tuner/noise_floor.hpp>
+#include <tuner/onset.hpp>
+#include <tuner/realtime.hpp>
+
+tuner::note_context tuner::low_energy_note() {
+    tuner::note_context n;
+    n.name = "LOW";
+    n.closest_note_frequency = -1;
+    n.actual_frequency = -1;
+    n.confidence = 0;
+    return n;
+}
+
+tuner::engine::engine(int sample_rate, tuner::metrics *metrics)
+        : rate(sample_rate), metrics(metrics), noise(nullptr), onset(nullptr),
+          previous(tuner::low_energy_note()), candidate_count(0), top(), plan(), fft(), in(), fft_res(),
+          arena_storage(tuner::ENGINE_ARENA_BYTES),
+          arena(arena_storage.data(), arena_storage.size()) {
+    if (sample_rate <= 0) {
+        throw tuner::InvalidSampleRateException();
+    }
+
+    plan = tuner::plan_cache::shared().plan(sample_rate, TUNER_SIZE);
+    fft = tuner::plan_cache::shared().lease_fft(TUNER_SIZE);
+}
+
+tuner::engine::~engine() = default;
+
+void tuner::engine::set_candidate_count(int count) {
+    if (count < 0) {
+        throw tuner::InvalidConfigurationException();
+    }
+    candidate_count = count;
+    top.reserve(size_t(count));
+    top.clear();
+}
+
+void tuner::engine::set_noise_floor(tuner::noise_floor *noise) {
+    if (noise != nullptr && noise->bins() != TUNER_SIZE / 2) {
+        throw tuner::InvalidConfigurationException();
+    }
+    this->noise = noise;
+}
+
+tuner::note_context tuner::engine::process(const std::array<float, TUNER_SIZE> &audio_stream_buffer) {
+    TUNER_METRICS_FRAME(metrics);
+    TUNER_METRICS_ALLOCATIONS(metrics);
+
+    bool too_low;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::signal_gate);
+        too_low = tuner::signal_energy_is_too_low(audio_stream_buffer);
+    }
+    if (too_low) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        top.clear();
+        previous = tuner::low_energy_note();
+        return previous;
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+        tuner::apply_window(audio_stream_buffer.data(), window().data(), in.data(), TUNER_SIZE);
+    }
+
+    return analyze();
+}
+
+tuner::note_context tuner::engine::process_pcm(const uint8_t *frames, const tuner::pcm_layout &layout) {
+    if (!tuner::is_valid_layout(layout)) {
+        throw tuner::InvalidPcmLayoutException();
+    }
+
+    float signal_power;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+        signal_power = tuner::convert_and_window(frames, layout, window().data(), in.data(), TUNER_SIZE);
+    }
+
+    return process_windowed(signal_power);
+}
+
+tuner::note_context tuner::engine::process(const int16_t *interleaved, int channels, int channel) {
+    tuner::pcm_layout layout;
+    layout.format = tuner::sample_format::pcm_s16;
+    layout.channels = channels;
+    layout.channel = channel;
+    return process_pcm(reinterpret_cast<const uint8_t *>(interleaved), layout);
+}
+
+tuner::note_context tuner::engine::process(const int32_t *interleaved, int channels, int channel) {
+    tuner::pcm_layout layout;
+    layout.format = tuner::sample_format::pcm_s32;
+    layout.channels = channels;
+    layout.channel = channel;
+    return process_pcm(reinterpret_cast<const uint8_t *>(interleaved), layout);
+}
+
+tuner::note_context tuner::engine::process_windowed(float signal_power) {
+    TUNER_METRICS_FRAME(metrics);
+    TUNER_METRICS_ALLOCATIONS(metrics);
+
+    if (signal_power < tuner::SIGNAL_POWER_THRESHOLD) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        top.clear();
+        previous = tuner::low_energy_note();
+        return previous;
+    }
+
+    return analyze();
+}
+
+tuner::note_context tuner::engine::analyze() {
+    float weight = 1;
+    if (onset != nullptr) {
+        bool transient;
+        {
+            TUNER_METRICS_STAGE(metrics, tuner::stage::onset_detection);
+            transient = onset->detect(in.data());
+        }
+        if (transient) {
+            weight = onset->config().weight;
+            if (weight == 0) {
+                top.clear();
+                tuner::note_context held = previous;
+                held.confidence = 0;
+                return held;
+            }
+        }
+    }
+
+    std::array<float, TUNER_SIZE / 2> mag_s;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::fft);
+        kiss_fftr(fft.get(), in.data(), fft_res.data());
+        // same values as calculate_magnitude_spec on the real parts, in one pass
+        tuner::real_magnitude(fft_res.data(), mag_s.data(), TUNER_SIZE / 2);
+    }
+
+    // suppress hums, with the bins of the plan instead of computing them again for every frame
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::hum_suppression);
+        std::fill(mag_s.begin(), mag_s.begin() + plan->hum_bins, 0.0f);
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::band_suppression);
+        if (noise == nullptr || !noise->gate(mag_s.data())) {
+            tuner::suppress_below_octave_bands(mag_s.data(), plan->bands.data(), int(plan->bands.size()));
+        }
+    }
+
+    float max_frequency;
+    float confidence;
+    {
+        // constructed on the arena, so the results are moved in instead of copied to the default resource
+        std::pmr::vector<float> i(&arena);
+        {
+            TUNER_METRICS_STAGE(metrics, tuner::stage::interpolation);
+            // interpolate_spec on the grid of the plan, which it would otherwise build for every frame
+            i.resize(size_t(plan->bins) * size_t(tuner::NUM_HPS));
+            if (!tuner::interpolate_spectrum(mag_s.data(), *plan, i.data(), 1)) {
+                // the noise floor gated every bin, so there is no pitch left to find
+                TUNER_METRICS_GATED_FRAME(metrics);
+                arena.release();
+                top.clear();
+                previous = tuner::low_energy_note();
+                return previous;
+            }
+        }
+
+        std::pmr::vector<float> hps_spec(&arena);
+        {
+            TUNER_METRICS_STAGE(metrics, tuner::stage::hps);
+            hps_spec = tuner::calculate_hps(i, &arena);
+        }
+
+        {
+            TUNER_METRICS_STAGE(metrics, tuner::stage::peak_pick);
+            max_frequency = tuner::get_max_frequency(hps_spec, rate);
+            top.resize(size_t(candidate_count));
+            top.resize(size_t(tuner::hps_candidates(hps_spec.data(), int(hps_spec.size()), rate, candidate_count,
+                                                    top.data())));
+            // the FFT has consumed the frame, so 'in' receives the power spectrum
+            tuner::power_spectrum(fft_res.data(), in.data(), TUNER_SIZE / 2);
+            confidence = tuner::pitch_confidence(hps_spec.data(), int(hps_spec.size()), 1, in.data(), rate,
+                                                 max_frequency);
+        }
+    }
+    // everything of this frame is gone, so the next one starts at the beginning of the arena again
+    arena.release();
+
+    tuner::note_context n;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::note_lookup);
+        tuner::note_context *found = tuner::get_note_for_frequency(max_frequency);
+        n = *found;
+        delete found;
+    }
+    n.confidence = confidence * weight;
+    previous = n;
+
+    return n;
+}
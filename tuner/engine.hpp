@@ -0,0 +1,192 @@
+#ifndef TUNER_ENGINE_H
+#define TUNER_ENGINE_H
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <kiss_fftr.h>
+
+#include <tuner/dsp.hpp>
+#include <tuner/global.hpp>
+#include <tuner/metrics.hpp>
+#include <tuner/note.hpp>
+#include <tuner/pcm.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/window_table.hpp>
+
+namespace tuner {
+
+    struct InvalidSampleRateException : public std::exception {
+        [[nodiscard]] const char* what() const noexcept override {
+            return "Invalid sample rate exception";
+        }
+    };
+
+    struct InvalidConfigurationException : public std::exception {
+        [[nodiscard]] const char* what() const noexcept override {
+            return "Invalid configuration exception";
+        }
+    };
+
+    class noise_floor;
+
+    class onset_detector;
+
+    // the per-frame arena of tuner::engine; the interpolated spectrum, the copy calculate_hps makes of it and its
+    // temporaries take about 86 KB
+    constexpr size_t ENGINE_ARENA_BYTES = 96 * 1024;
+
+    /**
+     * @brief Runs the tuning pipeline of tuner::tune for a fixed sample rate, keeping the FFT plan, the Hanning window
+     *        and the FFT input buffer alive between frames.
+     *
+     * Front ends that produce samples themselves (e.g. file decoders) can write windowed samples straight into input()
+     * and call process_windowed(), which saves the separate window pass and the copies made by tune().
+     *
+     * The vectors of the interpolation and HPS stages are allocated from a monotonic arena of ENGINE_ARENA_BYTES that
+     * is reset after every frame, so a frame does not go to the heap for them.
+     */
+    class engine {
+    public:
+        /**
+         * @param sample_rate The sample rate of the frames that will be processed.
+         * @param metrics Optional counters that receive stage timings when built with TUNER_INSTRUMENTATION.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         */
+        explicit engine(int sample_rate, tuner::metrics *metrics = nullptr);
+
+        ~engine();
+
+        engine(const engine &) = delete;
+
+        engine &operator=(const engine &) = delete;
+
+        /**
+         * @brief Performs tuning on one frame. Produces the same result as tuner::tune.
+         *
+         * @param audio_stream_buffer The input std::array<float, TUNER_SIZE> representing the audio stream buffer to be tuned.
+         *
+         * @return The note_context of the frame, named "LOW" with -1 frequencies when the signal energy is too low.
+         */
+        tuner::note_context process(const std::array<float, TUNER_SIZE> &audio_stream_buffer);
+
+        /**
+         * @brief Performs tuning on TUNER_SIZE interleaved PCM sample frames. Converting, deinterleaving (or mixing) and
+         *        windowing happen in one pass straight into the FFT input, without intermediate float buffers.
+         *
+         * @param frames The first byte of TUNER_SIZE little-endian sample frames laid out as described by 'layout'.
+         * @param layout The sample format, channel count and selected channel.
+         *
+         * @return The note_context of the frame, named "LOW" with -1 frequencies when the signal energy is too low.
+         * @throws InvalidPcmLayoutException If 'layout' does not satisfy tuner::is_valid_layout.
+         */
+        tuner::note_context process_pcm(const uint8_t *frames, const tuner::pcm_layout &layout);
+
+        /**
+         * @brief Performs tuning on TUNER_SIZE interleaved 16 bit sample frames, see process_pcm.
+         *
+         * @param channel The channel to analyze, -1 averages all channels.
+         */
+        tuner::note_context process(const int16_t *interleaved, int channels, int channel = 0);
+
+        /**
+         * @brief Performs tuning on TUNER_SIZE interleaved 32 bit sample frames, see process_pcm.
+         *
+         * @param channel The channel to analyze, -1 averages all channels.
+         */
+        tuner::note_context process(const int32_t *interleaved, int channels, int channel = 0);
+
+        /**
+         * @brief Performs tuning on the windowed samples the caller wrote into input().
+         *
+         * @param signal_power The mean power of the samples before windowing, used for the signal energy gate.
+         *
+         * @return The note_context of the frame, named "LOW" with -1 frequencies when 'signal_power' is too low.
+         */
+        tuner::note_context process_windowed(float signal_power);
+
+        /**
+         * @brief The FFT input buffer. Holds TUNER_SIZE windowed samples.
+         */
+        float *input() { return in.data(); }
+
+        /**
+         * @brief The Hanning window coefficients applied by process().
+         */
+        [[nodiscard]] const std::array<float, TUNER_SIZE> &window() const { return tuner::HANN_WINDOW<TUNER_SIZE>; }
+
+        [[nodiscard]] int sample_rate() const { return rate; }
+
+        /**
+         * @brief Records the following frames into 'metrics' instead, e.g. when one engine serves several callers.
+         *
+         * @param metrics Counters that receive stage timings when built with TUNER_INSTRUMENTATION, or nullptr.
+         */
+        void set_metrics(tuner::metrics *metrics) { this->metrics = metrics; }
+
+        /**
+         * @brief Gates the spectrum of every following frame against an adaptive noise floor that persists across
+         *        frames, instead of the octave band estimate of the frame itself. The octave bands are still used while
+         *        'noise' is training.
+         *
+         * @param noise The noise floor of this stream, or nullptr to go back to the octave bands. Not owned.
+         *
+         * @throws InvalidConfigurationException If 'noise' does not have TUNER_SIZE / 2 bins.
+         */
+        void set_noise_floor(tuner::noise_floor *noise);
+
+        /**
+         * @brief Looks for a pick attack in every following frame before it is transformed. A transient frame is not
+         *        analyzed when the weight of 'onset' is 0: the note of the previous frame is returned again with a
+         *        confidence of 0, so a display does not jump with every pluck. Otherwise it is analyzed and its
+         *        confidence is multiplied by the weight.
+         *
+         * @param onset The detector of this stream, or nullptr to analyze every frame. Not owned.
+         */
+        void set_onset_detector(tuner::onset_detector *onset) { this->onset = onset; }
+
+        /**
+         * @brief Keeps the highest local maxima of the HPS of every following frame, see tuner::hps_candidates, for a
+         *        tuner::pitch_tracker to choose from.
+         *
+         * @param count The number of candidates to keep, 0 to keep none.
+         *
+         * @throws InvalidConfigurationException If 'count' is negative.
+         */
+        void set_candidate_count(int count);
+
+        /**
+         * @brief The candidates of the last frame, highest first. Empty if the frame was not analyzed, e.g. because its
+         *        signal energy was too low.
+         */
+        [[nodiscard]] const std::vector<tuner::pitch_candidate> &candidates() const { return top; }
+
+    private:
+        tuner::note_context analyze();
+
+        int rate;
+        tuner::metrics *metrics;
+        tuner::noise_floor *noise;
+        tuner::onset_detector *onset;
+        // returned again for transient frames that are skipped
+        tuner::note_context previous;
+        int candidate_count;
+        std::vector<tuner::pitch_candidate> top;
+        std::shared_ptr<const tuner::frame_plan> plan;
+        tuner::fft_lease fft;
+        std::array<float, TUNER_SIZE> in;
+        std::array<kiss_fft_cpx, TUNER_SIZE / 2 + 1> fft_res;
+        std::vector<std::byte> arena_storage;
+        std::pmr::monotonic_buffer_resource arena;
+    };
+
+    /**
+     * @brief Creates the note_context reported for frames whose signal energy is too low.
+     */
+    tuner::note_context low_energy_note();
+}
+
+#endif //TUNER_ENGINE_H
@@ -0,0 +1,152 @@
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/dsp.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/noise_floor.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/test_signals.hpp>
+#include <tuner/tuner.hpp>
+
+TEST_CASE("[engine] sample rate is zero") {
+    try {
+        tuner::engine e(0);
+        REQUIRE(false);
+    } catch (tuner::InvalidSampleRateException &ie) {
+        REQUIRE(std::string(ie.what()) == "Invalid sample rate exception");
+    }
+}
+
+TEST_CASE("[engine] signal energy is too low") {
+    tuner::engine e(48000);
+    std::array<float, TUNER_SIZE> m = {};
+    tuner::note_context result = e.process(m);
+    REQUIRE(result.name == "LOW");
+    REQUIRE(result.closest_note_frequency == -1);
+    REQUIRE(result.actual_frequency == -1);
+    REQUIRE(result.confidence == 0);
+}
+
+TEST_CASE("[engine] process produces the same result as tune") {
+    tuner::engine e(48000);
+    for (float frequency: {82.41f, 110.0f, 196.0f, 329.63f}) {
+        std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(frequency, 48000);
+        tuner::note_context *expected = tuner::tune(m, 48000);
+        tuner::note_context result = e.process(m);
+        REQUIRE(result.name == expected->name);
+        REQUIRE(result.actual_frequency == expected->actual_frequency);
+        REQUIRE(result.closest_note_frequency == expected->closest_note_frequency);
+        delete expected;
+    }
+}
+
+TEST_CASE("[engine] clean tones are confident and noise is not") {
+    tuner::engine e(48000);
+    for (float frequency: {110.0f, 196.0f, 329.63f, 440.0f}) {
+        tuner::note_context result = e.process(tuner::test::harmonic_frame(frequency, 48000));
+        REQUIRE(result.confidence > 0.8f);
+        REQUIRE(result.confidence <= 1);
+    }
+
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0, 0.1f);
+    std::array<float, TUNER_SIZE> m = {};
+    for (float &sample : m) {
+        sample = noise(rng);
+    }
+    REQUIRE(e.process(m).confidence < 0.2f);
+
+    // the same tone buried in the noise is in between
+    std::array<float, TUNER_SIZE> tone = tuner::test::harmonic_frame(196.0f, 48000);
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        m[i] += tone[i];
+    }
+    tuner::note_context noisy = e.process(m);
+    REQUIRE(noisy.name == "G3");
+    REQUIRE(noisy.confidence > 0.2f);
+    REQUIRE(noisy.confidence < e.process(tone).confidence);
+}
+
+TEST_CASE("[engine] a frame gated away entirely is low energy") {
+    tuner::engine e(48000);
+    // a floor that is trained after one frame, so the same loud frame is all noise the second time
+    tuner::noise_floor floor(TUNER_SIZE / 2, {0, 8, 8, 4});
+    e.set_noise_floor(&floor);
+    std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(110.0f, 48000);
+    REQUIRE(e.process(m).name == "A2");
+
+    tuner::note_context n = e.process(m);
+    REQUIRE(n.name == "LOW");
+    REQUIRE(n.actual_frequency == -1);
+    REQUIRE(n.confidence == 0);
+}
+
+TEST_CASE("[engine] process_windowed matches process for a windowed frame") {
+    tuner::engine e(44100);
+    std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(146.83f, 44100);
+    tuner::note_context expected = e.process(m);
+
+    float power = 0;
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        e.input()[i] = e.window()[i] * m[i];
+        power += m[i] * m[i];
+    }
+    tuner::note_context result = e.process_windowed(power / float(TUNER_SIZE));
+
+    REQUIRE(result.name == expected.name);
+    REQUIRE(result.actual_frequency == expected.actual_frequency);
+}
+
+TEST_CASE("[engine] process_windowed with a low signal power") {
+    tuner::engine e(48000);
+    tuner::note_context result = e.process_windowed(0);
+    REQUIRE(result.name == "LOW");
+}
+
+TEST_CASE("[engine] candidates of a frame start with its note") {
+    tuner::engine e(48000);
+    REQUIRE_THROWS_AS(e.set_candidate_count(-1), tuner::InvalidConfigurationException);
+
+    std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(110, 48000);
+    e.process(m);
+    REQUIRE(e.candidates().empty());
+
+    e.set_candidate_count(4);
+    tuner::note_context result = e.process(m);
+    REQUIRE(e.candidates().size() == 4);
+    REQUIRE(e.candidates()[0].frequency == result.actual_frequency);
+    REQUIRE(e.candidates()[0].salience == 1.0f);
+    for (size_t i = 1; i < e.candidates().size(); i++) {
+        REQUIRE(e.candidates()[i].salience <= e.candidates()[i - 1].salience);
+    }
+
+    std::array<float, TUNER_SIZE> silence = {};
+    e.process(silence);
+    REQUIRE(e.candidates().empty());
+}
+
+TEST_CASE("[engine] interpolation and HPS of a frame fit in the arena") {
+    std::array<float, TUNER_SIZE / 2> mag_s{};
+    for (int i = 0; i < int(mag_s.size()); i++) {
+        mag_s[i] = float(i % 17);
+    }
+    std::vector<float> expected = tuner::calculate_hps(tuner::interpolate_spec(mag_s));
+    std::shared_ptr<const tuner::frame_plan> plan = tuner::plan_cache::shared().plan(48000, TUNER_SIZE);
+
+    // the allocations of tuner::engine::process; without an upstream, running out of the arena throws std::bad_alloc
+    std::vector<std::byte> storage(tuner::ENGINE_ARENA_BYTES);
+    std::pmr::monotonic_buffer_resource arena(storage.data(), storage.size(), std::pmr::null_memory_resource());
+    for (int frame = 0; frame < 3; frame++) {
+        {
+            std::pmr::vector<float> i(size_t(plan->bins) * size_t(tuner::NUM_HPS), &arena);
+            tuner::interpolate_spectrum(mag_s.data(), *plan, i.data(), 1);
+            std::pmr::vector<float> hps(&arena);
+            hps = tuner::calculate_hps(i, &arena);
+            REQUIRE(std::vector<float>(hps.begin(), hps.end()) == expected);
+        }
+        arena.release();
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef TUNER_GENERATOR_H
+#define TUNER_GENERATOR_H
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+// coroutine support needs both the language feature and the library header, e.g. -std=c++20
+#if defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine)
+#define TUNER_HAS_COROUTINES 1
+#endif
+
+#ifdef TUNER_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+namespace tuner {
+
+    /**
+     * @brief A lazily evaluated sequence produced by a coroutine with co_yield, the subset of C++23 std::generator
+     *        the library needs.
+     *
+     * The coroutine only runs while the consumer advances the iterator, so a generator nobody pulls from costs nothing.
+     * Exceptions thrown by the coroutine are rethrown from begin() or operator++.
+     */
+    template<typename T>
+    class generator {
+    public:
+        struct promise_type {
+            const T *current = nullptr;
+            std::exception_ptr exception;
+
+            generator get_return_object() noexcept {
+                return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            // the value lives in the suspended coroutine frame until the consumer resumes it
+            std::suspend_always yield_value(const T &value) noexcept {
+                current = &value;
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+            // co_await is not supported inside a generator
+            void await_transform() = delete;
+        };
+
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            iterator() noexcept = default;
+
+            explicit iterator(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+            iterator &operator++() {
+                advance(handle);
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            reference operator*() const noexcept { return *handle.promise().current; }
+
+            pointer operator->() const noexcept { return handle.promise().current; }
+
+            bool operator==(std::default_sentinel_t) const noexcept { return !handle || handle.done(); }
+
+        private:
+            std::coroutine_handle<promise_type> handle;
+        };
+
+        generator(generator &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+        generator &operator=(generator &&other) noexcept {
+            if (this != &other) {
+                if (handle) {
+                    handle.destroy();
+                }
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        generator(const generator &) = delete;
+
+        generator &operator=(const generator &) = delete;
+
+        ~generator() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        /**
+         * @brief Runs the coroutine up to its first co_yield. Can only be called once.
+         */
+        iterator begin() {
+            advance(handle);
+            return iterator(handle);
+        }
+
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        explicit generator(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+        static void advance(std::coroutine_handle<promise_type> handle) {
+            handle.resume();
+            if (handle.promise().exception) {
+                std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+            }
+        }
+
+        std::coroutine_handle<promise_type> handle;
+    };
+}
+
+#endif // TUNER_HAS_COROUTINES
+
+#endif //TUNER_GENERATOR_H
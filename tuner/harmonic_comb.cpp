@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <tuner/dsp.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/harmonic_comb.hpp>
+#include <tuner/kernels.hpp>
+#include <tuner/window_table.hpp>
+
+tuner::harmonic_comb::harmonic_comb(int sample_rate, const tuner::comb_config &config)
+        : rate(sample_rate), config(config), row_count(0), bin_count(0), width(0) {
+    if (sample_rate <= 0) {
+        throw tuner::InvalidSampleRateException();
+    }
+    if (tuner::hann_window(config.frame_size) == nullptr || config.cents <= 0 || config.harmonics <= 0 ||
+        !(config.harmonic_decay >= 0) ||
+        !(config.min_frequency > 0) || !(config.max_frequency > config.min_frequency) ||
+        !(config.max_frequency < float(sample_rate) / 2)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    const float delta_frequency = float(sample_rate) / float(config.frame_size);
+    bin_count = config.frame_size / 2;
+    width = 2 * config.harmonics;
+    row_count = int(std::floor(1200.0f * std::log2(config.max_frequency / config.min_frequency) / float(config.cents))) + 1;
+    columns.assign(size_t(row_count) * size_t(width), 0);
+    weights.assign(columns.size(), 0.0f);
+
+    for (int r = 0; r < row_count; r++) {
+        const float fundamental = frequency(r);
+        int *c = columns.data() + size_t(r) * size_t(width);
+        float *w = weights.data() + size_t(r) * size_t(width);
+        for (int h = 1; h <= config.harmonics; h++) {
+            float weight = std::pow(float(h), -config.harmonic_decay);
+            float position = fundamental * float(h) / delta_frequency;
+            int low = int(position);
+            if (low + 1 >= bin_count) {
+                // the higher harmonics are past the last bin as well and keep their zero weights
+                break;
+            }
+            float fraction = position - float(low);
+            c[2 * (h - 1)] = low;
+            w[2 * (h - 1)] = (1 - fraction) * weight;
+            c[2 * (h - 1) + 1] = low + 1;
+            w[2 * (h - 1) + 1] = fraction * weight;
+        }
+    }
+}
+
+void tuner::harmonic_comb::score(const float *mag_s, float *scores) const noexcept {
+    score_batch(mag_s, 1, scores);
+}
+
+void tuner::harmonic_comb::score_batch(const float *spectra, int frames, float *scores) const noexcept {
+    tuner::sparse_matrix_product(columns.data(), weights.data(), row_count, width, spectra, frames, scores);
+}
+
+float tuner::harmonic_comb::best_frequency(const float *scores, int frames, int frame) const noexcept {
+    int best = 0;
+    for (int r = 1; r < row_count; r++) {
+        if (scores[size_t(r) * frames + frame] > scores[size_t(best) * frames + frame]) {
+            best = r;
+        }
+    }
+    return frequency(best);
+}
+
+float tuner::harmonic_comb::refine(const float *mag_s, int stride, float fundamental) const noexcept {
+    // linear interpolation between bins puts the best comb of a clean harmonic on the bin grid, so each harmonic peak
+    // is located by a parabola through the log magnitudes around it, as tuner::strum_analyzer does
+    const float delta_frequency = float(rate) / float(config.frame_size);
+    auto magnitude = [mag_s, stride](int k) { return mag_s[size_t(k) * stride]; };
+    float weighted = 0;
+    float total = 0;
+    for (int h = 1; h <= config.harmonics; h++) {
+        int k = int(std::lround(fundamental * float(h) / delta_frequency));
+        if (k < 1 || k + 1 >= bin_count) {
+            break;
+        }
+        if (magnitude(k - 1) > magnitude(k)) {
+            k--;
+        } else if (magnitude(k + 1) > magnitude(k)) {
+            k++;
+        }
+        if (k < 1 || k + 1 >= bin_count || magnitude(k) <= 0) {
+            continue;
+        }
+
+        float a = std::log(magnitude(k - 1) + 1e-12f);
+        float b = std::log(magnitude(k) + 1e-12f);
+        float c = std::log(magnitude(k + 1) + 1e-12f);
+        float denominator = a - 2 * b + c;
+        float offset = denominator < 0 ? 0.5f * (a - c) / denominator : 0;
+        float peak = (float(k) + offset) * delta_frequency / float(h);
+
+        // a peak more than a bin away is not this harmonic
+        if (std::abs(peak - fundamental) * float(h) > delta_frequency) {
+            continue;
+        }
+
+        float weight = magnitude(k) * float(h);
+        weighted += peak * weight;
+        total += weight;
+    }
+
+    return total > 0 ? weighted / total : fundamental;
+}
+
+float tuner::harmonic_comb::frequency(int row) const noexcept {
+    return config.min_frequency * std::exp2(float(row) * float(config.cents) / 1200.0f);
+}
+
+tuner::comb_engine::comb_engine(int sample_rate, const tuner::comb_config &config, tuner::metrics *metrics)
+        : config(config), metrics(metrics), matrix(sample_rate, config) {
+    if (config.batch <= 0) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    plan = tuner::plan_cache::shared().plan(sample_rate, config.frame_size);
+    fft = tuner::plan_cache::shared().lease_fft(config.frame_size);
+
+    const size_t batch = size_t(config.batch);
+    in.resize(size_t(config.frame_size));
+    fft_res.resize(size_t(matrix.bins() + 1));
+    spectra.resize(size_t(matrix.bins()) * batch);
+    scores.resize(size_t(matrix.rows()) * batch);
+    power.resize(size_t(matrix.bins()) * batch);
+    voiced.resize(batch);
+}
+
+tuner::realtime_status tuner::comb_engine::process(const float *samples, tuner::realtime_note &out) noexcept {
+    if (fft.get() == nullptr) {
+        return tuner::realtime_status::not_ready;
+    }
+    if (samples == nullptr) {
+        return tuner::realtime_status::invalid_input;
+    }
+    TUNER_METRICS_FRAME(metrics);
+    TUNER_METRICS_ALLOCATIONS(metrics);
+
+    if (!transform(samples, 0, 1)) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        out = tuner::realtime_note();
+        std::memcpy(out.name, "LOW", sizeof("LOW"));
+        return tuner::realtime_status::low_energy;
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::harmonic_comb);
+        matrix.score(spectra.data(), scores.data());
+    }
+    finish(0, 1, out);
+
+    return tuner::realtime_status::ok;
+}
+
+int tuner::comb_engine::process_batch(const float *samples, int frames, int hop, tuner::realtime_note *out) noexcept {
+    if (samples == nullptr || out == nullptr || hop <= 0) {
+        return -1;
+    }
+    if (fft.get() == nullptr) {
+        return 0;
+    }
+    TUNER_METRICS_ALLOCATIONS(metrics);
+
+    int detected = 0;
+    for (int first = 0; first < frames; first += config.batch) {
+        const int n = std::min(config.batch, frames - first);
+        for (int slot = 0; slot < n; slot++) {
+            TUNER_METRICS_FRAME(metrics);
+            voiced[slot] = transform(samples + size_t(first + slot) * size_t(hop), slot, n);
+        }
+
+        {
+            TUNER_METRICS_STAGE(metrics, tuner::stage::harmonic_comb);
+            matrix.score_batch(spectra.data(), n, scores.data());
+        }
+
+        for (int slot = 0; slot < n; slot++) {
+            tuner::realtime_note &note = out[first + slot];
+            if (voiced[slot]) {
+                finish(slot, n, note);
+                detected++;
+            } else {
+                TUNER_METRICS_GATED_FRAME(metrics);
+                note = tuner::realtime_note();
+                std::memcpy(note.name, "LOW", sizeof("LOW"));
+            }
+        }
+    }
+
+    return detected;
+}
+
+bool tuner::comb_engine::transform(const float *samples, int slot, int frames) noexcept {
+    const int n = config.frame_size;
+    const int bins = matrix.bins();
+    float signal_power;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+        signal_power = tuner::apply_window_and_sum_squares(samples, plan->window, in.data(), n) / float(n);
+    }
+
+    float *frame_power = power.data() + size_t(slot) * size_t(bins);
+    if (signal_power < tuner::SIGNAL_POWER_THRESHOLD) {
+        // the column still takes part in the matrix product of its batch
+        for (int k = 0; k < bins; k++) {
+            spectra[size_t(k) * frames + slot] = 0;
+        }
+        return false;
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::fft);
+        kiss_fftr(fft.get(), in.data(), fft_res.data());
+        tuner::power_spectrum(fft_res.data(), frame_power, bins);
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::hum_suppression);
+        for (int k = 0; k < bins; k++) {
+            spectra[size_t(k) * frames + slot] = k < plan->hum_bins ? 0.0f : std::sqrt(frame_power[k]);
+        }
+    }
+
+    return true;
+}
+
+void tuner::comb_engine::finish(int slot, int frames, tuner::realtime_note &out) noexcept {
+    float frequency;
+    float confidence;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::peak_pick);
+        frequency = matrix.best_frequency(scores.data(), frames, slot);
+        frequency = matrix.refine(spectra.data() + slot, frames, frequency);
+        const float *frame_power = power.data() + size_t(slot) * size_t(matrix.bins());
+        confidence = tuner::harmonic_energy_fraction(frame_power, matrix.bins(), plan->hum_bins,
+                                                     frequency / plan->delta_frequency);
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::note_lookup);
+        tuner::find_note_for_frequency(frequency, out);
+    }
+    out.confidence = confidence;
+}
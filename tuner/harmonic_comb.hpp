@@ -0,0 +1,204 @@
+#ifndef TUNER_HARMONIC_COMB_H
+#define TUNER_HARMONIC_COMB_H
+
+#include <memory>
+#include <vector>
+
+#include <kiss_fftr.h>
+
+#include <tuner/global.hpp>
+#include <tuner/metrics.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/realtime.hpp>
+
+namespace tuner {
+
+    struct comb_config {
+        // the candidate fundamentals, one comb every 'cents' cents from 'min_frequency' up to 'max_frequency'
+        float min_frequency = 60;
+        float max_frequency = 1400;
+        int cents = 1;
+        // harmonics in each comb, the fundamental included
+        int harmonics = 8;
+        // harmonic h is weighted by h^-harmonic_decay; 1 is the comb of tuner::strum_analyzer, which lets a strong second
+        // harmonic win an octave above, 0 ties a pure sine with the combs an octave and more below
+        float harmonic_decay = 0.2f;
+        // samples per frame, a power of two with a precomputed Hanning window (see tuner::hann_window)
+        int frame_size = TUNER_SIZE;
+        // the frames comb_engine::process_batch transforms before scoring them with one matrix product
+        int batch = 16;
+    };
+
+    /**
+     * @brief The harmonic comb matrix: one row per candidate fundamental at cent resolution, one column per bin of a
+     *        magnitude spectrum.
+     *
+     * Row r holds the fundamental f = min_frequency * 2^(r * cents / 1200) and its harmonics up to 'harmonics' f, each
+     * weighted by h^-harmonic_decay and spread linearly over the two bins around it, as tuner::strum_analyzer scores its
+     * combs. The product of the matrix and a magnitude spectrum is the harmonic sum of every candidate at once.
+     *
+     * A dense matrix of a 60 Hz to 1400 Hz range at one cent has over 5000 rows of TUNER_SIZE / 2 bins, 22 MB. Each row
+     * has only 2 * 'harmonics' entries, so the matrix is stored as fixed width sparse rows: a column index and a weight
+     * per entry. Harmonics above the last bin get a weight of 0.
+     */
+    class harmonic_comb {
+    public:
+        /**
+         * @param sample_rate The sample rate of the spectra that will be scored.
+         * @param config The candidate range and resolution, the number of harmonics and the frame size.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         * @throws InvalidConfigurationException If 'frame_size' has no precomputed Hanning window, 'cents' or
+         *                                       'harmonics' is not positive, 'harmonic_decay' is negative, or the
+         *                                       candidate range is empty or above the Nyquist frequency.
+         */
+        harmonic_comb(int sample_rate, const tuner::comb_config &config = {});
+
+        /**
+         * @brief Scores every candidate of one magnitude spectrum.
+         *
+         * @param mag_s bins() magnitudes.
+         * @param scores Receives rows() scores.
+         */
+        void score(const float *mag_s, float *scores) const noexcept;
+
+        /**
+         * @brief Scores every candidate of 'frames' magnitude spectra with one matrix product, see
+         *        tuner::sparse_matrix_product. Gives exactly the scores of score() for each frame.
+         *
+         * @param spectra bins() x 'frames' magnitudes, the frames of each bin next to each other: bin k of frame f is
+         *                spectra[k * frames + f].
+         * @param scores Receives rows() x 'frames' scores in the same layout.
+         */
+        void score_batch(const float *spectra, int frames, float *scores) const noexcept;
+
+        /**
+         * @brief Picks the best candidate of a frame.
+         *
+         * @param scores The scores of score() or score_batch().
+         * @param frames The number of frames of 'scores', 1 for score().
+         * @param frame The frame to pick the candidate of.
+         *
+         * @return The fundamental of the best row in Hz.
+         */
+        float best_frequency(const float *scores, int frames, int frame) const noexcept;
+
+        /**
+         * @brief Refines a fundamental below the resolution of the bins from the harmonic peaks of its spectrum.
+         *
+         * @param mag_s The magnitude spectrum of bins() values at mag_s[0], mag_s[stride], ...
+         * @param fundamental The fundamental of best_frequency().
+         *
+         * @return The magnitude weighted mean of the fundamentals of the harmonic peaks within a bin of the comb, or
+         *         'fundamental' if there is none.
+         */
+        float refine(const float *mag_s, int stride, float fundamental) const noexcept;
+
+        /**
+         * @brief The fundamental of row 'row' in Hz.
+         */
+        [[nodiscard]] float frequency(int row) const noexcept;
+
+        [[nodiscard]] int rows() const noexcept { return row_count; }
+
+        [[nodiscard]] int bins() const noexcept { return bin_count; }
+
+        [[nodiscard]] int sample_rate() const noexcept { return rate; }
+
+    private:
+        int rate;
+        tuner::comb_config config;
+        int row_count;
+        int bin_count;
+        // 2 * harmonics entries per row
+        int width;
+        std::vector<int> columns;
+        std::vector<float> weights;
+    };
+
+    /**
+     * @brief Detects the pitch of a frame with a harmonic sum over a tuner::harmonic_comb instead of the harmonic product
+     *        spectrum.
+     *
+     * The HPS multiplies decimated copies of the spectrum, so one weak harmonic is enough to lose the fundamental and a
+     * strong second harmonic easily wins an octave above. The harmonic sum adds the weighted harmonics instead: the comb
+     * an octave below only matches every other harmonic at a lower weight, and the comb an octave above misses the
+     * fundamental and every odd harmonic. It needs no 5x interpolation, and its cost only depends on the number of
+     * candidates and harmonics. The best comb is refined with harmonic_comb::refine.
+     *
+     * process_batch() transforms up to 'batch' frames and scores them with a single cache-blocked matrix product, which
+     * is what file analysis should use. The window, the hum bins and the FFT plan come from tuner::plan_cache. Like
+     * tuner::realtime_engine, everything is allocated by the constructor and processing is noexcept. The confidence of a
+     * note is the tuner::harmonic_energy_fraction of its frame.
+     */
+    class comb_engine {
+    public:
+        /**
+         * @param sample_rate The sample rate of the frames that will be processed.
+         * @param config The comb and the batch size.
+         * @param metrics Optional counters that receive stage timings when built with TUNER_INSTRUMENTATION.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         * @throws InvalidConfigurationException If the comb is invalid (see tuner::harmonic_comb) or 'batch' is not
+         *                                       positive.
+         */
+        explicit comb_engine(int sample_rate, const tuner::comb_config &config = {}, tuner::metrics *metrics = nullptr);
+
+        comb_engine(const comb_engine &) = delete;
+
+        comb_engine &operator=(const comb_engine &) = delete;
+
+        /**
+         * @brief Performs tuning on frame_size() samples.
+         *
+         * @param samples The first of frame_size() samples.
+         * @param out Receives the detected note. Set to the "LOW" note for realtime_status::low_energy, untouched otherwise.
+         *
+         * @return realtime_status::ok if a note was detected.
+         */
+        tuner::realtime_status process(const float *samples, tuner::realtime_note &out) noexcept;
+
+        /**
+         * @brief Performs tuning on 'frames' frames of a stream, 'batch' of them per matrix product.
+         *
+         * @param samples The first sample of the first frame. Frame i starts at samples + i * hop and holds frame_size()
+         *                samples.
+         * @param frames The number of frames.
+         * @param hop The distance between the starts of two frames in samples.
+         * @param out Receives one note per frame, the "LOW" note for frames whose signal energy is too low.
+         *
+         * @return The number of frames with a detected note, or -1 if 'samples' or 'out' is null or 'hop' is not
+         *         positive.
+         */
+        int process_batch(const float *samples, int frames, int hop, tuner::realtime_note *out) noexcept;
+
+        [[nodiscard]] const tuner::harmonic_comb &comb() const noexcept { return matrix; }
+
+        [[nodiscard]] int frame_size() const noexcept { return config.frame_size; }
+
+        [[nodiscard]] int sample_rate() const noexcept { return matrix.sample_rate(); }
+
+    private:
+        // windows and transforms the frame into column 'slot' of 'spectra'; returns false if it is too quiet
+        bool transform(const float *samples, int slot, int frames) noexcept;
+
+        // looks up the note of column 'slot' of 'scores'
+        void finish(int slot, int frames, tuner::realtime_note &out) noexcept;
+
+        tuner::comb_config config;
+        tuner::metrics *metrics;
+        tuner::harmonic_comb matrix;
+        std::shared_ptr<const tuner::frame_plan> plan;
+        tuner::fft_lease fft;
+        std::vector<float> in;
+        std::vector<kiss_fft_cpx> fft_res;
+        // bins x batch magnitude spectra and rows x batch scores, see harmonic_comb::score_batch
+        std::vector<float> spectra;
+        std::vector<float> scores;
+        // the power spectra of the batch for the confidence, one frame after the other
+        std::vector<float> power;
+        std::vector<bool> voiced;
+    };
+}
+
+#endif //TUNER_HARMONIC_COMB_H
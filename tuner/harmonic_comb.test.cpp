@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/harmonic_comb.hpp>
+#include <tuner/realtime.hpp>
+
+namespace {
+    constexpr int SAMPLE_RATE = 48000;
+
+    // 'size' samples of a tone with the given harmonic amplitudes and a little noise
+    std::vector<float> comb_test_tone(float frequency, const std::vector<float> &amplitudes, int size = TUNER_SIZE) {
+        std::mt19937 rng(11);
+        std::normal_distribution<float> noise(0, 0.01f);
+        std::vector<float> m(static_cast<size_t>(size));
+        for (int i = 0; i < size; i++) {
+            m[i] = noise(rng);
+            for (size_t h = 0; h < amplitudes.size(); h++) {
+                float harmonic = frequency * float(h + 1);
+                m[i] += amplitudes[h] * std::sin(2.0f * float(M_PI) * harmonic * float(i) / float(SAMPLE_RATE) + float(h));
+            }
+        }
+        return m;
+    }
+
+    float cents_between(float a, float b) {
+        return 1200.0f * std::log2(a / b);
+    }
+}
+
+TEST_CASE("[harmonic_comb] invalid configuration") {
+    REQUIRE_THROWS_AS(tuner::harmonic_comb(0), tuner::InvalidSampleRateException);
+    REQUIRE_THROWS_AS(tuner::harmonic_comb(SAMPLE_RATE, {60, 1400, 1, 8, 0.2f, 1000}),
+                      tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::harmonic_comb(SAMPLE_RATE, {60, 1400, 0}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::harmonic_comb(SAMPLE_RATE, {60, 1400, 1, 0}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::harmonic_comb(SAMPLE_RATE, {60, 1400, 1, 8, -1}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::harmonic_comb(SAMPLE_RATE, {500, 100}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::harmonic_comb(SAMPLE_RATE, {60, 30000}), tuner::InvalidConfigurationException);
+
+    tuner::comb_config no_batch;
+    no_batch.batch = 0;
+    REQUIRE_THROWS_AS(tuner::comb_engine(SAMPLE_RATE, no_batch), tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[harmonic_comb] one row per cent") {
+    tuner::harmonic_comb comb(SAMPLE_RATE);
+    REQUIRE(comb.bins() == TUNER_SIZE / 2);
+    REQUIRE(comb.rows() == int(std::floor(1200 * std::log2(1400.0 / 60.0))) + 1);
+    REQUIRE(comb.frequency(0) == 60.0f);
+    REQUIRE(std::abs(comb.frequency(1200) - 120.0f) < 1e-3f);
+
+    tuner::harmonic_comb coarse(SAMPLE_RATE, {60, 1400, 10});
+    REQUIRE(coarse.rows() == comb.rows() / 10 + 1);
+}
+
+TEST_CASE("[harmonic_comb] scores are weighted harmonic sums") {
+    tuner::comb_config config;
+    tuner::harmonic_comb comb(SAMPLE_RATE, config);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> magnitude(0, 1);
+    std::vector<float> mag_s(static_cast<size_t>(comb.bins()));
+    for (float &m: mag_s) {
+        m = magnitude(rng);
+    }
+
+    std::vector<float> scores(static_cast<size_t>(comb.rows()));
+    comb.score(mag_s.data(), scores.data());
+
+    const float delta_frequency = float(SAMPLE_RATE) / float(TUNER_SIZE);
+    for (int r = 0; r < comb.rows(); r += 97) {
+        float expected = 0;
+        for (int h = 1; h <= config.harmonics; h++) {
+            float position = comb.frequency(r) * float(h) / delta_frequency;
+            int low = int(position);
+            float fraction = position - float(low);
+            expected += (mag_s[low] * (1 - fraction) + mag_s[low + 1] * fraction) * std::pow(float(h), -config.harmonic_decay);
+        }
+        REQUIRE(std::abs(scores[r] - expected) < 1e-4f * expected);
+    }
+}
+
+TEST_CASE("[harmonic_comb] a batch gives exactly the scores of its frames") {
+    tuner::harmonic_comb comb(SAMPLE_RATE);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> magnitude(0, 1);
+    for (int frames: {1, 3, 16, 37}) {
+        std::vector<float> spectra(size_t(comb.bins()) * size_t(frames));
+        for (float &m: spectra) {
+            m = magnitude(rng);
+        }
+        std::vector<float> scores(size_t(comb.rows()) * size_t(frames));
+        comb.score_batch(spectra.data(), frames, scores.data());
+
+        std::vector<float> mag_s(static_cast<size_t>(comb.bins()));
+        std::vector<float> single(static_cast<size_t>(comb.rows()));
+        for (int f = 0; f < frames; f++) {
+            for (int k = 0; k < comb.bins(); k++) {
+                mag_s[k] = spectra[size_t(k) * frames + f];
+            }
+            comb.score(mag_s.data(), single.data());
+            for (int r = 0; r < comb.rows(); r++) {
+                REQUIRE(scores[size_t(r) * frames + f] == single[r]);
+            }
+        }
+    }
+}
+
+TEST_CASE("[comb_engine] notes from E2 to E6 within ten cents") {
+    tuner::comb_engine e(SAMPLE_RATE);
+    for (float frequency: {82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f, 440.0f, 659.26f, 1318.51f}) {
+        for (const std::vector<float> &amplitudes: {std::vector<float>{0.5f}, {0.2f, 0.1f, 0.067f, 0.05f, 0.04f}}) {
+            std::vector<float> m = comb_test_tone(frequency, amplitudes);
+            tuner::realtime_note n;
+            REQUIRE(e.process(m.data(), n) == tuner::realtime_status::ok);
+            REQUIRE(std::abs(cents_between(n.actual_frequency, frequency)) < 10);
+            // the main lobe of E2 reaches into the hum bins, which do not count towards the confidence
+            if (frequency > 100) {
+                REQUIRE(n.confidence > 0.5f);
+            }
+        }
+    }
+
+    std::vector<float> silence(TUNER_SIZE, 0.0f);
+    tuner::realtime_note n;
+    REQUIRE(e.process(silence.data(), n) == tuner::realtime_status::low_energy);
+    REQUIRE(std::string(n.name) == "LOW");
+    REQUIRE(e.process(nullptr, n) == tuner::realtime_status::invalid_input);
+}
+
+TEST_CASE("[comb_engine] a strong second harmonic does not win an octave above") {
+    tuner::comb_engine comb(SAMPLE_RATE);
+    tuner::realtime_engine hps(SAMPLE_RATE);
+    int comb_right = 0;
+    int hps_right = 0;
+    int notes = 0;
+    // E2 to E5 with a weak fundamental, as on the wound strings of a guitar
+    for (int midi = 40; midi <= 76; midi++) {
+        float frequency = 440.0f * std::exp2(float(midi - 69) / 12.0f);
+        std::vector<float> m = comb_test_tone(frequency, {0.1f, 0.5f, 0.3f, 0.2f, 0.1f, 0.05f});
+        tuner::realtime_note c;
+        tuner::realtime_note h;
+        comb.process(m.data(), c);
+        hps.process(m.data(), h);
+        comb_right += std::abs(cents_between(c.actual_frequency, frequency)) < 50 ? 1 : 0;
+        hps_right += std::abs(cents_between(h.actual_frequency, frequency)) < 50 ? 1 : 0;
+        notes++;
+    }
+    REQUIRE(comb_right == notes);
+    REQUIRE(comb_right > hps_right);
+}
+
+TEST_CASE("[comb_engine] process_batch matches process frame by frame") {
+    tuner::comb_config config;
+    config.batch = 4;
+    tuner::comb_engine batched(SAMPLE_RATE, config);
+    tuner::comb_engine single(SAMPLE_RATE);
+
+    // an A2 with a silent gap, cut into 11 frames so the last batch is not full
+    constexpr int HOP = TUNER_SIZE / 2;
+    constexpr int FRAMES = 11;
+    std::vector<float> samples = comb_test_tone(110.0f, {0.2f, 0.1f, 0.067f}, TUNER_SIZE + HOP * (FRAMES - 1));
+    std::fill(samples.begin() + 3 * HOP, samples.begin() + 6 * HOP + TUNER_SIZE, 0.0f);
+
+    std::vector<tuner::realtime_note> notes(FRAMES);
+    REQUIRE(batched.process_batch(nullptr, FRAMES, HOP, notes.data()) == -1);
+    REQUIRE(batched.process_batch(samples.data(), FRAMES, 0, notes.data()) == -1);
+    int detected = batched.process_batch(samples.data(), FRAMES, HOP, notes.data());
+    REQUIRE(detected == FRAMES - 4);
+
+    for (int f = 0; f < FRAMES; f++) {
+        tuner::realtime_note n;
+        single.process(samples.data() + f * HOP, n);
+        REQUIRE(std::string(notes[f].name) == n.name);
+        REQUIRE(notes[f].actual_frequency == n.actual_frequency);
+        REQUIRE(notes[f].confidence == n.confidence);
+    }
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <tuner/kernels.hpp>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+void tuner::apply_window(const float *samples, const float *window, float *out, int n) {
+    int i = 0;
+#if defined(__wasm_simd128__)
+    for (; i + 4 <= n; i += 4) {
+        wasm_v128_store(out + i, wasm_f32x4_mul(wasm_v128_load(samples + i), wasm_v128_load(window + i)));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = window[i] * samples[i];
+    }
+}
+
+float tuner::apply_window_and_sum_squares(const float *samples, const float *window, float *out, int n) {
+    float sum = 0;
+    int i = 0;
+#if defined(__wasm_simd128__)
+    v128_t sums = wasm_f32x4_splat(0);
+    for (; i + 4 <= n; i += 4) {
+        v128_t s = wasm_v128_load(samples + i);
+        sums = wasm_f32x4_add(sums, wasm_f32x4_mul(s, s));
+        wasm_v128_store(out + i, wasm_f32x4_mul(s, wasm_v128_load(window + i)));
+    }
+    sum = wasm_f32x4_extract_lane(sums, 0) + wasm_f32x4_extract_lane(sums, 1) +
+          wasm_f32x4_extract_lane(sums, 2) + wasm_f32x4_extract_lane(sums, 3);
+#endif
+    for (; i < n; i++) {
+        float s = samples[i];
+        sum += s * s;
+        out[i] = window[i] * s;
+    }
+
+    return sum;
+}
+
+void tuner::real_magnitude(const kiss_fft_cpx *spectrum, float *out, int n) {
+    int i = 0;
+#if defined(__wasm_simd128__)
+    // kiss_fft_cpx is an interleaved (r, i) pair, so two vectors hold four bins
+    const auto *interleaved = reinterpret_cast<const float *>(spectrum);
+    for (; i + 4 <= n; i += 4) {
+        v128_t low = wasm_v128_load(interleaved + 2 * i);
+        v128_t high = wasm_v128_load(interleaved + 2 * i + 4);
+        wasm_v128_store(out + i, wasm_f32x4_abs(wasm_i32x4_shuffle(low, high, 0, 2, 4, 6)));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = std::abs(spectrum[i].r);
+    }
+}
+
+void tuner::power_spectrum(const kiss_fft_cpx *spectrum, float *out, int n) {
+    int i = 0;
+#if defined(__wasm_simd128__)
+    const auto *interleaved = reinterpret_cast<const float *>(spectrum);
+    for (; i + 4 <= n; i += 4) {
+        v128_t low = wasm_v128_load(interleaved + 2 * i);
+        v128_t high = wasm_v128_load(interleaved + 2 * i + 4);
+        v128_t r = wasm_i32x4_shuffle(low, high, 0, 2, 4, 6);
+        v128_t im = wasm_i32x4_shuffle(low, high, 1, 3, 5, 7);
+        wasm_v128_store(out + i, wasm_f32x4_add(wasm_f32x4_mul(r, r), wasm_f32x4_mul(im, im)));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = spectrum[i].r * spectrum[i].r + spectrum[i].i * spectrum[i].i;
+    }
+}
+
+namespace {
+    constexpr float SQRT_2 = 1.41421356f;
+    // 2 / ln(2) times the atanh series coefficients 1, 1 / 3 and 1 / 5
+    constexpr float LOG2_C1 = 2.88539008f;
+    constexpr float LOG2_C3 = 0.96179669f;
+    constexpr float LOG2_C5 = 0.57707802f;
+}
+
+void tuner::fast_log2(const float *in, float *out, int n, float floor) {
+    int i = 0;
+#if defined(__wasm_simd128__)
+    const v128_t floors = wasm_f32x4_splat(floor);
+    const v128_t mantissa_mask = wasm_i32x4_splat(0x007fffff);
+    const v128_t one_bits = wasm_i32x4_splat(0x3f800000);
+    const v128_t ones = wasm_f32x4_splat(1.0f);
+    for (; i + 4 <= n; i += 4) {
+        v128_t x = wasm_f32x4_max(wasm_v128_load(in + i), floors);
+        v128_t exponent = wasm_i32x4_sub(wasm_u32x4_shr(x, 23), wasm_i32x4_splat(127));
+        v128_t m = wasm_v128_or(wasm_v128_and(x, mantissa_mask), one_bits);
+        // move the mantissa into [sqrt(2) / 2, sqrt(2)), the lanes of 'large' are -1 where it was halved
+        v128_t large = wasm_f32x4_gt(m, wasm_f32x4_splat(SQRT_2));
+        m = wasm_v128_bitselect(wasm_f32x4_mul(m, wasm_f32x4_splat(0.5f)), m, large);
+        exponent = wasm_i32x4_sub(exponent, large);
+        v128_t t = wasm_f32x4_div(wasm_f32x4_sub(m, ones), wasm_f32x4_add(m, ones));
+        v128_t t2 = wasm_f32x4_mul(t, t);
+        v128_t series = wasm_f32x4_add(wasm_f32x4_splat(LOG2_C3), wasm_f32x4_mul(t2, wasm_f32x4_splat(LOG2_C5)));
+        series = wasm_f32x4_add(wasm_f32x4_splat(LOG2_C1), wasm_f32x4_mul(t2, series));
+        wasm_v128_store(out + i, wasm_f32x4_add(wasm_f32x4_convert_i32x4(exponent), wasm_f32x4_mul(t, series)));
+    }
+#endif
+    for (; i < n; i++) {
+        float x = in[i] > floor ? in[i] : floor;
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        int exponent = int(bits >> 23) - 127;
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+        // move the mantissa into [sqrt(2) / 2, sqrt(2)) so the series converges quickly
+        if (m > SQRT_2) {
+            m *= 0.5f;
+            exponent++;
+        }
+        float t = (m - 1) / (m + 1);
+        float t2 = t * t;
+        out[i] = float(exponent) + t * (LOG2_C1 + t2 * (LOG2_C3 + t2 * LOG2_C5));
+    }
+}
+
+void tuner::sparse_matrix_product(const int *columns, const float *weights, int rows, int width, const float *vectors,
+                                  int frames, float *out) {
+    // 64 rows of a 16 harmonic comb are 8 KB of entries, which stay in L1 while every tile of frames passes by
+    constexpr int ROW_BLOCK = 64;
+    constexpr int FRAME_TILE = 16;
+
+    for (int block = 0; block < rows; block += ROW_BLOCK) {
+        const int block_end = std::min(rows, block + ROW_BLOCK);
+        for (int first = 0; first < frames; first += FRAME_TILE) {
+            const int tile = std::min(FRAME_TILE, frames - first);
+            for (int r = block; r < block_end; r++) {
+                const int *c = columns + size_t(r) * size_t(width);
+                const float *w = weights + size_t(r) * size_t(width);
+                float *products = out + size_t(r) * size_t(frames) + first;
+                int f = 0;
+#if defined(__wasm_simd128__)
+                for (; f + 4 <= tile; f += 4) {
+                    v128_t sum = wasm_f32x4_splat(0);
+                    for (int e = 0; e < width; e++) {
+                        const float *v = vectors + size_t(c[e]) * size_t(frames) + first + f;
+                        sum = wasm_f32x4_add(sum, wasm_f32x4_mul(wasm_f32x4_splat(w[e]), wasm_v128_load(v)));
+                    }
+                    wasm_v128_store(products + f, sum);
+                }
+#endif
+                float sums[FRAME_TILE] = {};
+                for (int e = 0; e < width; e++) {
+                    const float *v = vectors + size_t(c[e]) * size_t(frames) + first;
+                    for (int i = f; i < tile; i++) {
+                        sums[i] += w[e] * v[i];
+                    }
+                }
+                for (; f < tile; f++) {
+                    products[f] = sums[f];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef TUNER_KERNELS_H
+#define TUNER_KERNELS_H
+
+#include <kiss_fft.h>
+
+namespace tuner {
+
+    /**
+     * @brief Whether the kernels below were compiled with WebAssembly SIMD128 instructions (-msimd128).
+     */
+    constexpr bool kernels_use_simd() {
+#if defined(__wasm_simd128__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Multiplies 'samples' element-wise with 'window' into 'out'.
+     *
+     * @param n The number of samples. 'out' may alias 'samples'.
+     */
+    void apply_window(const float *samples, const float *window, float *out, int n);
+
+    /**
+     * @brief Multiplies 'samples' element-wise with 'window' into 'out' and sums the squares of the unwindowed samples
+     *        in the same pass.
+     *
+     * @param n The number of samples. 'out' may alias 'samples'.
+     *
+     * @return The sum of the squared samples before windowing.
+     */
+    float apply_window_and_sum_squares(const float *samples, const float *window, float *out, int n);
+
+    /**
+     * @brief Writes the absolute value of the real part of each of the first 'n' bins of 'spectrum' into 'out'.
+     */
+    void real_magnitude(const kiss_fft_cpx *spectrum, float *out, int n);
+
+    /**
+     * @brief Writes the squared magnitude of each of the first 'n' bins of 'spectrum' into 'out'.
+     */
+    void power_spectrum(const kiss_fft_cpx *spectrum, float *out, int n);
+
+    /**
+     * @brief Writes log2(max(in[i], floor)) of 'n' values into 'out', accurate to about 1e-5.
+     *
+     * The exponent is taken from the float bits and only the mantissa goes through a short atanh series, so there is
+     * no call to std::log2 and the loop vectorizes.
+     *
+     * @param floor The smallest value taken the logarithm of. Must be a positive normal float.
+     * @param n The number of values. 'out' may alias 'in'.
+     */
+    void fast_log2(const float *in, float *out, int n, float floor);
+
+    /**
+     * @brief Multiplies a sparse matrix with 'width' entries per row by a block of 'frames' column vectors, e.g. the
+     *        harmonic comb of tuner::harmonic_comb by a batch of magnitude spectra.
+     *
+     * The rows are processed in blocks whose entries stay in cache while every tile of frames is multiplied with them,
+     * and each entry is applied to a whole tile of frames at once, so the innermost loop is a contiguous multiply-add.
+     * The sum of each row and frame is taken in entry order whatever the number of frames, so a frame gets the same
+     * result in any batch.
+     *
+     * @param columns The column of each entry, 'rows' x 'width' row after row.
+     * @param weights The value of each entry, in the layout of 'columns'.
+     * @param vectors The column vectors, the frames of each column next to each other: column k of frame f is
+     *                vectors[k * frames + f].
+     * @param out Receives 'rows' x 'frames' products in the layout of 'vectors'.
+     */
+    void sparse_matrix_product(const int *columns, const float *weights, int rows, int width, const float *vectors,
+                               int frames, float *out);
+}
+
+#endif //TUNER_KERNELS_H
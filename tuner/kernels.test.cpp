@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/kernels.hpp>
+
+TEST_CASE("[apply_window] multiplies element-wise including the tail") {
+    std::array<float, 11> samples = {};
+    std::array<float, 11> window = {};
+    std::array<float, 11> out = {};
+    for (int i = 0; i < 11; i++) {
+        samples[i] = float(i) - 5;
+        window[i] = 0.5f + float(i) / 10;
+    }
+
+    tuner::apply_window(samples.data(), window.data(), out.data(), 11);
+    for (int i = 0; i < 11; i++) {
+        REQUIRE(out[i] == samples[i] * window[i]);
+    }
+}
+
+TEST_CASE("[apply_window_and_sum_squares] windows in place and sums the unwindowed squares") {
+    std::array<float, 9> samples = {1, -2, 3, -4, 5, -6, 7, -8, 9};
+    std::array<float, 9> window = {};
+    window.fill(0.5f);
+
+    float sum = tuner::apply_window_and_sum_squares(samples.data(), window.data(), samples.data(), 9);
+    REQUIRE(sum == 285);
+    REQUIRE(samples[0] == 0.5f);
+    REQUIRE(samples[7] == -4);
+    REQUIRE(samples[8] == 4.5f);
+}
+
+TEST_CASE("[real_magnitude] takes the absolute real part of each bin") {
+    std::array<kiss_fft_cpx, 6> spectrum = {};
+    for (int i = 0; i < 6; i++) {
+        spectrum[i].r = (i % 2 == 0 ? -1.0f : 1.0f) * float(i);
+        spectrum[i].i = 100;
+    }
+
+    std::array<float, 6> out = {};
+    tuner::real_magnitude(spectrum.data(), out.data(), 6);
+    for (int i = 0; i < 6; i++) {
+        REQUIRE(out[i] == float(i));
+    }
+}
+
+TEST_CASE("[power_spectrum] squares the magnitude of each bin") {
+    std::array<kiss_fft_cpx, 6> spectrum = {};
+    for (int i = 0; i < 6; i++) {
+        spectrum[i].r = -float(i);
+        spectrum[i].i = 2;
+    }
+
+    std::array<float, 6> out = {};
+    tuner::power_spectrum(spectrum.data(), out.data(), 6);
+    for (int i = 0; i < 6; i++) {
+        REQUIRE(out[i] == float(i * i + 4));
+    }
+}
+
+TEST_CASE("[fast_log2] matches std::log2 and clamps to the floor") {
+    std::vector<float> values;
+    for (float x = 1e-30f; x < 1e30f; x *= 1.37f) {
+        values.push_back(x);
+    }
+    values.push_back(0);
+    values.push_back(-5);
+
+    std::vector<float> out(values.size());
+    tuner::fast_log2(values.data(), out.data(), int(values.size()), 1e-20f);
+    for (size_t i = 0; i < values.size(); i++) {
+        float expected = std::log2(std::max(values[i], 1e-20f));
+        REQUIRE(std::abs(out[i] - expected) < 1e-5f);
+    }
+    REQUIRE(out[out.size() - 1] == out[out.size() - 2]);
+}
+
+TEST_CASE("[kernels_use_simd] is off for native builds") {
+    REQUIRE_FALSE(tuner::kernels_use_simd());
+}
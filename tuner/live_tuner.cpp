@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <cstring>
+
+#include <tuner/kernels.hpp>
+#include <tuner/live_tuner.hpp>
+
+tuner::live_tuner::live_tuner(int sample_rate, const tuner::live_tuner_config &config)
+        : config(config), e(sample_rate), noise(TUNER_SIZE / 2, config.noise_floor), onset(config.onset),
+          ring(config.ring_capacity), history(), consumed(0), sequence(0), dropped(0), stopping(false) {
+    if (config.hop_size <= 0 || config.hop_size > TUNER_SIZE || config.ring_capacity < size_t(config.hop_size)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    hop.resize(size_t(config.hop_size));
+    if (config.adaptive_noise_floor) {
+        e.set_noise_floor(&noise);
+    }
+    if (config.onset_detection) {
+        e.set_onset_detector(&onset);
+    }
+    worker = std::thread(&tuner::live_tuner::run, this);
+}
+
+tuner::live_tuner::~live_tuner() {
+    stopping.store(true, std::memory_order_relaxed);
+    worker.join();
+}
+
+size_t tuner::live_tuner::push(const float *samples, size_t count) noexcept {
+    size_t accepted = ring.push(samples, count);
+    if (accepted < count) {
+        dropped.fetch_add(count - accepted, std::memory_order_relaxed);
+    }
+
+    return accepted;
+}
+
+void tuner::live_tuner::run() {
+    while (!stopping.load(std::memory_order_relaxed)) {
+        if (ring.size() < hop.size()) {
+            std::this_thread::sleep_for(config.idle_wait);
+            continue;
+        }
+
+        // slide the window by one hop
+        ring.pop(hop.data(), hop.size());
+        std::move(history.begin() + std::ptrdiff_t(hop.size()), history.end(), history.begin());
+        std::copy(hop.begin(), hop.end(), history.end() - std::ptrdiff_t(hop.size()));
+        consumed += hop.size();
+
+        if (consumed >= TUNER_SIZE) {
+            analyze_window();
+        }
+    }
+}
+
+void tuner::live_tuner::analyze_window() {
+    float power = tuner::apply_window_and_sum_squares(history.data(), e.window().data(), e.input(), TUNER_SIZE);
+    tuner::note_context n = e.process_windowed(power / float(TUNER_SIZE));
+
+    tuner::pitch_snapshot s;
+    s.sequence = ++sequence;
+    s.sample_offset = consumed - TUNER_SIZE;
+    s.actual_frequency = n.actual_frequency;
+    s.closest_note_frequency = n.closest_note_frequency;
+    s.confidence = n.confidence;
+    std::strncpy(s.name, n.name.c_str(), sizeof(s.name) - 1);
+    results.write(s);
+}
@@ -0,0 +1,118 @@
+#ifndef TUNER_LIVE_TUNER_H
+#define TUNER_LIVE_TUNER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <tuner/engine.hpp>
+#include <tuner/global.hpp>
+#include <tuner/noise_floor.hpp>
+#include <tuner/onset.hpp>
+#include <tuner/spsc_ring.hpp>
+#include <tuner/triple_buffer.hpp>
+
+namespace tuner {
+
+    /**
+     * @brief The result of one analyzed window, small and trivially copyable so it can be published without allocating.
+     */
+    struct pitch_snapshot {
+        // increases with every published result, 0 until the first window has been analyzed
+        uint64_t sequence = 0;
+        // index of the first sample of the analyzed window, counted from the first pushed sample
+        uint64_t sample_offset = 0;
+        float actual_frequency = -1;
+        float closest_note_frequency = -1;
+        // how much 'actual_frequency' can be trusted, from 0 (noise) to 1 (a clean harmonic tone), 0 when LOW
+        float confidence = 0;
+        // the note name, e.g. "A#2", or "LOW" when the signal energy was too low
+        char name[8] = {};
+    };
+
+    struct live_tuner_config {
+        // samples between the starts of two consecutive analysis windows
+        int hop_size = TUNER_SIZE / 4;
+        // samples the ring between the audio callback and the worker holds before new samples are dropped
+        size_t ring_capacity = 8 * TUNER_SIZE;
+        // how long the worker sleeps when less than 'hop_size' samples are waiting
+        std::chrono::microseconds idle_wait{1000};
+        // gate every window against a tuner::noise_floor that the worker keeps across windows, for steady hum and drones
+        bool adaptive_noise_floor = false;
+        tuner::noise_floor_config noise_floor;
+        // hold the previous result while a window holds a pick attack, see tuner::engine::set_onset_detector
+        bool onset_detection = false;
+        tuner::onset_config onset;
+    };
+
+    /**
+     * @brief A real-time-safe front end that analyzes a live stream on a background worker thread.
+     *
+     * The audio callback hands samples to push(), which only copies them into a lock-free single-producer/single-consumer
+     * ring: it never allocates, locks or runs the FFT. The worker slides a TUNER_SIZE window over the stream by 'hop_size'
+     * samples, analyzes it with its own tuner::engine and publishes each result through a wait-free triple buffer
+     * that the UI reads with latest().
+     */
+    class live_tuner {
+    public:
+        /**
+         * @param sample_rate The sample rate of the pushed samples.
+         * @param config The hop size, ring capacity, worker idle wait, noise floor and onset detection.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         * @throws InvalidConfigurationException If 'hop_size' is not in [1, TUNER_SIZE], 'ring_capacity' is smaller than 'hop_size'
+         *                                       or the noise floor or onset configuration is invalid.
+         */
+        explicit live_tuner(int sample_rate, const tuner::live_tuner_config &config = {});
+
+        /**
+         * @brief Stops and joins the worker. Samples still in the ring are discarded.
+         */
+        ~live_tuner();
+
+        live_tuner(const live_tuner &) = delete;
+
+        live_tuner &operator=(const live_tuner &) = delete;
+
+        /**
+         * @brief Hands 'count' samples to the worker. Safe to call from a real-time audio callback; only one thread may push.
+         *
+         * @return The number of samples accepted. The rest were dropped because the worker fell behind.
+         */
+        size_t push(const float *samples, size_t count) noexcept;
+
+        /**
+         * @brief The most recently published result. Wait-free; only one thread may read.
+         */
+        const tuner::pitch_snapshot &latest() noexcept { return results.read(); }
+
+        /**
+         * @brief The number of samples push() dropped so far because the ring was full.
+         */
+        [[nodiscard]] uint64_t dropped_samples() const noexcept { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        void run();
+
+        void analyze_window();
+
+        tuner::live_tuner_config config;
+        tuner::engine e;
+        tuner::noise_floor noise;
+        tuner::onset_detector onset;
+        tuner::spsc_ring<float> ring;
+        tuner::triple_buffer<tuner::pitch_snapshot> results;
+        std::array<float, TUNER_SIZE> history;
+        std::vector<float> hop;
+        uint64_t consumed;
+        uint64_t sequence;
+        std::atomic<uint64_t> dropped;
+        std::atomic<bool> stopping;
+        std::thread worker;
+    };
+}
+
+#endif //TUNER_LIVE_TUNER_H
@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/live_tuner.hpp>
+#include <tuner/test_signals.hpp>
+
+tuner::pitch_snapshot wait_for_sequence(tuner::live_tuner &t, uint64_t sequence) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    tuner::pitch_snapshot s = t.latest();
+    while (s.sequence < sequence && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        s = t.latest();
+    }
+
+    return s;
+}
+
+TEST_CASE("[live_tuner] invalid configuration") {
+    tuner::live_tuner_config config;
+    config.hop_size = 0;
+    REQUIRE_THROWS_AS(tuner::live_tuner(48000, config), tuner::InvalidConfigurationException);
+
+    config.hop_size = TUNER_SIZE + 1;
+    REQUIRE_THROWS_AS(tuner::live_tuner(48000, config), tuner::InvalidConfigurationException);
+
+    REQUIRE_THROWS_AS(tuner::live_tuner(0), tuner::InvalidSampleRateException);
+}
+
+TEST_CASE("[live_tuner] nothing is published before a full window arrived") {
+    tuner::live_tuner t(48000);
+    std::vector<float> tone = tuner::test::harmonic_tone(110.0f, 48000, TUNER_SIZE - 1);
+    REQUIRE(t.push(tone.data(), tone.size()) == tone.size());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(t.latest().sequence == 0);
+}
+
+TEST_CASE("[live_tuner] render quanta pushed from another thread are analyzed") {
+    constexpr int sample_rate = 48000;
+    tuner::live_tuner t(sample_rate);
+    std::vector<float> tone = tuner::test::harmonic_tone(110.0f, sample_rate, 4 * TUNER_SIZE);
+
+    std::thread audio([&]() {
+        for (size_t offset = 0; offset < tone.size(); offset += 128) {
+            t.push(tone.data() + offset, 128);
+        }
+    });
+    audio.join();
+
+    // 4 * TUNER_SIZE samples with a hop of TUNER_SIZE / 4 give 13 windows
+    tuner::pitch_snapshot s = wait_for_sequence(t, 13);
+    REQUIRE(s.sequence == 13);
+    REQUIRE(s.sample_offset == 3 * TUNER_SIZE);
+    REQUIRE(s.actual_frequency > 100);
+    REQUIRE(s.actual_frequency < 120);
+    REQUIRE(std::abs(s.closest_note_frequency - 110.0f) < 0.01f);
+    REQUIRE(std::string(s.name) == "A2");
+    REQUIRE(t.dropped_samples() == 0);
+}
+
+TEST_CASE("[live_tuner] silence is published as LOW") {
+    tuner::live_tuner t(48000);
+    std::vector<float> silence(TUNER_SIZE, 0.0f);
+    t.push(silence.data(), silence.size());
+
+    tuner::pitch_snapshot s = wait_for_sequence(t, 1);
+    REQUIRE(std::string(s.name) == "LOW");
+    REQUIRE(s.actual_frequency == -1);
+}
+
+TEST_CASE("[live_tuner] push drops samples when the ring is full") {
+    tuner::live_tuner_config config;
+    config.ring_capacity = TUNER_SIZE;
+    config.idle_wait = std::chrono::microseconds(1000000);
+    tuner::live_tuner t(48000, config);
+
+    // the worker is asleep for a second, so nothing drains the ring
+    std::vector<float> samples(2 * TUNER_SIZE, 0.0f);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    REQUIRE(t.push(samples.data(), samples.size()) == TUNER_SIZE);
+    REQUIRE(t.dropped_samples() == TUNER_SIZE);
+}
@@ -0,0 +1,120 @@
+#include <fstream>
+#include <utility>
+
+#include <tuner/mapped_file.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define TUNER_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+tuner::mapped_file::mapped_file(const std::string &file_path) {
+#if defined(TUNER_HAS_MMAP)
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw tuner::FileOpenException();
+    }
+
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw tuner::FileOpenException();
+    }
+
+    length = size_t(st.st_size);
+    if (length > 0) {
+        void *p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw tuner::FileOpenException();
+        }
+        bytes = static_cast<const uint8_t *>(p);
+        is_mapped = true;
+    }
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+#else
+    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        throw tuner::FileOpenException();
+    }
+
+    fallback.resize(size_t(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(fallback.data()), std::streamsize(fallback.size()));
+    bytes = fallback.data();
+    length = fallback.size();
+#endif
+}
+
+tuner::mapped_file::~mapped_file() {
+    close();
+}
+
+tuner::mapped_file::mapped_file(tuner::mapped_file &&other) noexcept {
+    *this = std::move(other);
+}
+
+tuner::mapped_file &tuner::mapped_file::operator=(tuner::mapped_file &&other) noexcept {
+    if (this != &other) {
+        close();
+        fallback = std::move(other.fallback);
+        bytes = other.is_mapped ? other.bytes : fallback.data();
+        length = other.length;
+        is_mapped = other.is_mapped;
+        other.bytes = nullptr;
+        other.length = 0;
+        other.is_mapped = false;
+    }
+
+    return *this;
+}
+
+void tuner::mapped_file::close() {
+#if defined(TUNER_HAS_MMAP)
+    if (is_mapped) {
+        ::munmap(const_cast<uint8_t *>(bytes), length);
+    }
+#endif
+    bytes = nullptr;
+    length = 0;
+    is_mapped = false;
+    fallback.clear();
+}
+
+#if defined(TUNER_HAS_MMAP)
+namespace {
+    // madvise needs page aligned addresses, so round the start of the range down to a page boundary
+    void advise(const uint8_t *bytes, size_t length, size_t offset, size_t count, int advice) {
+        if (offset >= length) {
+            return;
+        }
+        if (count > length - offset) {
+            count = length - offset;
+        }
+
+        auto page_size = size_t(::sysconf(_SC_PAGESIZE));
+        size_t aligned_offset = offset - offset % page_size;
+        ::madvise(const_cast<uint8_t *>(bytes) + aligned_offset, count + (offset - aligned_offset), advice);
+    }
+}
+#endif
+
+void tuner::mapped_file::advise_sequential(size_t offset, size_t count) const {
+#if defined(TUNER_HAS_MMAP)
+    if (is_mapped) {
+        advise(bytes, length, offset, count, MADV_SEQUENTIAL);
+    }
+#endif
+}
+
+void tuner::mapped_file::release(size_t offset, size_t count) const {
+#if defined(TUNER_HAS_MMAP)
+    if (is_mapped) {
+        advise(bytes, length, offset, count, MADV_DONTNEED);
+    }
+#endif
+}
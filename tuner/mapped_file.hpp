@@ -0,0 +1,69 @@
+#ifndef TUNER_MAPPED_FILE_H
+#define TUNER_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace tuner {
+
+    struct FileOpenException : public std::exception {
+        [[nodiscard]] const char* what() const noexcept override {
+            return "File open exception";
+        }
+    };
+
+    /**
+     * @brief A read-only view of a whole file. The file is memory-mapped where the platform supports it,
+     *        otherwise it is read into an owned buffer once.
+     */
+    class mapped_file {
+    public:
+        /**
+         * @brief Maps the file at 'file_path' into memory.
+         *
+         * @param file_path The path to the file to be mapped.
+         *
+         * @throws FileOpenException If the file cannot be opened or mapped.
+         */
+        explicit mapped_file(const std::string &file_path);
+
+        ~mapped_file();
+
+        mapped_file(const mapped_file &) = delete;
+
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        mapped_file(mapped_file &&other) noexcept;
+
+        mapped_file &operator=(mapped_file &&other) noexcept;
+
+        [[nodiscard]] const uint8_t *data() const { return bytes; }
+
+        [[nodiscard]] size_t size() const { return length; }
+
+        /**
+         * @brief Tells the kernel that the range [offset, offset + count) will be read front to back, so it can read ahead
+         *        and drop pages behind the reader. Does nothing when the file is not memory-mapped.
+         */
+        void advise_sequential(size_t offset, size_t count) const;
+
+        /**
+         * @brief Tells the kernel that the range [offset, offset + count) is no longer needed, which keeps the resident
+         *        set bounded when streaming through files larger than memory. Does nothing when the file is not memory-mapped.
+         */
+        void release(size_t offset, size_t count) const;
+
+    private:
+        void close();
+
+        const uint8_t *bytes = nullptr;
+        size_t length = 0;
+        bool is_mapped = false;
+        std::vector<uint8_t> fallback;
+    };
+}
+
+#endif //TUNER_MAPPED_FILE_H
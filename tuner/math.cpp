@@ -32,14 +32,25 @@ float tuner::euclidean_norm(std::array<float, TUNER_SIZE> m) {
     return sum;
 }
 
-float tuner::euclidean_norm(std::vector<float> m) {
-    float sum = 0;
-    int order = 2;
-    for (float i: m) {
-        sum += std::pow(std::abs(i), float(order));
+namespace {
+    template<typename Floats>
+    float vector_euclidean_norm(const Floats &m) {
+        float sum = 0;
+        int order = 2;
+        for (float i: m) {
+            sum += std::pow(std::abs(i), float(order));
+        }
+
+        sum = std::pow(sum, (float(1) / float(order)));
+
+        return sum;
     }
+}
 
-    sum = std::pow(sum, (float(1) / float(order)));
+float tuner::euclidean_norm(std::vector<float> m) {
+    return vector_euclidean_norm(m);
+}
 
-    return sum;
-}
\ No newline at end of file
+float tuner::euclidean_norm(const std::pmr::vector<float> &m) {
+    return vector_euclidean_norm(m);
+}
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cmath>
+#include <memory_resource>
 #include <vector>
 
 #include <tuner/global.hpp>
@@ -55,6 +56,11 @@ namespace tuner {
      * @return A float representing the p-norm of the std::vector 'm'.
      */
     float euclidean_norm(std::vector<float> m);
+
+    /**
+     * @brief euclidean_norm of a std::pmr::vector, without copying it.
+     */
+    float euclidean_norm(const std::pmr::vector<float> &m);
 }
 
 #endif //TUNER_MATH_H
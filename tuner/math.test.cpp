@@ -166,3 +166,9 @@ TEST_CASE("[euclidean_norm | vector | full] with non-empty array and negative va
 
 
 
+TEST_CASE("[euclidean_norm | pmr] matches the std::vector overload") {
+    std::vector<float> m = {-1.0f, -2.0f, 3.0f, -4.0f, 5.0f};
+    std::pmr::vector<float> pmr_m(m.begin(), m.end());
+
+    REQUIRE(tuner::euclidean_norm(pmr_m) == tuner::euclidean_norm(m));
+}
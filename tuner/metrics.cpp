@@ -0,0 +1,147 @@
+#include <tuner/metrics.hpp>
+
+namespace {
+    thread_local uint64_t thread_allocations = 0;
+    // the scoped_allocation_counters alive on this thread
+    thread_local int allocation_scopes = 0;
+}
+
+const char *tuner::stage_name(tuner::stage s) {
+    switch (s) {
+        case tuner::stage::signal_gate:
+            return "signal_gate";
+        case tuner::stage::window:
+            return "window";
+        case tuner::stage::fft:
+            return "fft";
+        case tuner::stage::hum_suppression:
+            return "hum_suppression";
+        case tuner::stage::band_suppression:
+            return "band_suppression";
+        case tuner::stage::interpolation:
+            return "interpolation";
+        case tuner::stage::hps:
+            return "hps";
+        case tuner::stage::peak_pick:
+            return "peak_pick";
+        case tuner::stage::note_lookup:
+            return "note_lookup";
+        case tuner::stage::cepstrum:
+            return "cepstrum";
+        case tuner::stage::onset_detection:
+            return "onset_detection";
+        case tuner::stage::harmonic_comb:
+            return "harmonic_comb";
+    }
+
+    return "unknown";
+}
+
+int tuner::latency_histogram_bucket(uint64_t ns) {
+    int bucket = 0;
+    while (ns != 0 && bucket < tuner::LATENCY_HISTOGRAM_BUCKETS - 1) {
+        ns >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+void tuner::count_allocation() noexcept {
+    thread_allocations++;
+}
+
+uint64_t tuner::thread_allocation_count() noexcept {
+    return thread_allocations;
+}
+
+tuner::metrics::metrics() {
+    reset();
+}
+
+void tuner::metrics::record_stage(tuner::stage s, uint64_t ns) noexcept {
+    stage_counters &c = stages[static_cast<int>(s)];
+    c.calls.fetch_add(1, std::memory_order_relaxed);
+    c.total_ns.fetch_add(ns, std::memory_order_relaxed);
+    c.histogram[tuner::latency_histogram_bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    // only the owning thread records, so a plain load/store pair is enough to keep min/max
+    if (ns < c.min_ns.load(std::memory_order_relaxed)) {
+        c.min_ns.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > c.max_ns.load(std::memory_order_relaxed)) {
+        c.max_ns.store(ns, std::memory_order_relaxed);
+    }
+}
+
+void tuner::metrics::record_frame() noexcept {
+    frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void tuner::metrics::record_gated_frame() noexcept {
+    gated_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+void tuner::metrics::record_allocation(uint64_t count) noexcept {
+    allocations.fetch_add(count, std::memory_order_relaxed);
+}
+
+tuner::metrics_snapshot tuner::metrics::snapshot() const noexcept {
+    tuner::metrics_snapshot out;
+    out.frames = frames.load(std::memory_order_relaxed);
+    out.gated_frames = gated_frames.load(std::memory_order_relaxed);
+    out.allocations = allocations.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < tuner::STAGE_COUNT; i++) {
+        const stage_counters &c = stages[i];
+        tuner::stage_snapshot &s = out.stages[i];
+        s.calls = c.calls.load(std::memory_order_relaxed);
+        s.total_ns = c.total_ns.load(std::memory_order_relaxed);
+        s.min_ns = s.calls == 0 ? 0 : c.min_ns.load(std::memory_order_relaxed);
+        s.max_ns = c.max_ns.load(std::memory_order_relaxed);
+        for (int j = 0; j < tuner::LATENCY_HISTOGRAM_BUCKETS; j++) {
+            s.histogram[j] = c.histogram[j].load(std::memory_order_relaxed);
+        }
+    }
+
+    return out;
+}
+
+void tuner::metrics::reset() noexcept {
+    frames.store(0, std::memory_order_relaxed);
+    gated_frames.store(0, std::memory_order_relaxed);
+    allocations.store(0, std::memory_order_relaxed);
+
+    for (stage_counters &c: stages) {
+        c.calls.store(0, std::memory_order_relaxed);
+        c.total_ns.store(0, std::memory_order_relaxed);
+        c.min_ns.store(UINT64_MAX, std::memory_order_relaxed);
+        c.max_ns.store(0, std::memory_order_relaxed);
+        for (std::atomic<uint64_t> &bucket: c.histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+tuner::scoped_allocation_counter::scoped_allocation_counter(tuner::metrics *m) noexcept
+        : m(m), outermost(allocation_scopes++ == 0), start(thread_allocations) {}
+
+tuner::scoped_allocation_counter::~scoped_allocation_counter() {
+    allocation_scopes--;
+    if (m != nullptr && outermost) {
+        m->record_allocation(thread_allocations - start);
+    }
+}
+
+tuner::scoped_stage_timer::scoped_stage_timer(tuner::metrics *m, tuner::stage s) noexcept: m(m), s(s) {
+    if (m != nullptr) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+tuner::scoped_stage_timer::~scoped_stage_timer() {
+    if (m != nullptr) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        m->record_stage(s, uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+}
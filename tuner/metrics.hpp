@@ -0,0 +1,192 @@
+#ifndef TUNER_METRICS_H
+#define TUNER_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace tuner {
+
+    /**
+     * @brief The processing stages of the tuning pipeline that can be timed individually.
+     */
+    enum class stage : int {
+        signal_gate = 0,
+        window,
+        fft,
+        hum_suppression,
+        band_suppression,
+        interpolation,
+        hps,
+        peak_pick,
+        note_lookup,
+        // the log spectrum and the inverse FFT of tuner::cepstrum_engine
+        cepstrum,
+        // the block energies of tuner::onset_detector
+        onset_detection,
+        // the comb matrix product of tuner::comb_engine
+        harmonic_comb
+    };
+
+    constexpr int STAGE_COUNT = 12;
+
+    // bucket i counts stage durations in [2^(i - 1), 2^i) nanoseconds, the last bucket is open ended
+    constexpr int LATENCY_HISTOGRAM_BUCKETS = 32;
+
+    struct stage_snapshot {
+        uint64_t calls = 0;
+        uint64_t total_ns = 0;
+        uint64_t min_ns = 0;
+        uint64_t max_ns = 0;
+        std::array<uint64_t, LATENCY_HISTOGRAM_BUCKETS> histogram = {};
+    };
+
+    struct metrics_snapshot {
+        uint64_t frames = 0;
+        uint64_t gated_frames = 0;
+        // heap allocations made on the recording thread during tune() calls and engine frames, as counted by
+        // tuner::count_allocation
+        uint64_t allocations = 0;
+        std::array<stage_snapshot, STAGE_COUNT> stages = {};
+    };
+
+    /**
+     * @brief Retrieves a printable name for the given stage, e.g. "fft" or "band_suppression".
+     *
+     * @param s The stage to name.
+     *
+     * @return A null terminated string with static storage duration.
+     */
+    const char *stage_name(tuner::stage s);
+
+    /**
+     * @brief Retrieves the index of the latency histogram bucket a duration of 'ns' nanoseconds falls into.
+     *
+     * @param ns The duration in nanoseconds.
+     *
+     * @return An index in the range [0, LATENCY_HISTOGRAM_BUCKETS).
+     */
+    int latency_histogram_bucket(uint64_t ns);
+
+    /**
+     * @brief Counts one heap allocation of the calling thread.
+     *
+     * The library does not replace the global operator new, so it does not get in the way of the allocator, sanitizer
+     * or test hooks of the host. A host that wants allocations in tuner::metrics calls this from its own operator new.
+     */
+    void count_allocation() noexcept;
+
+    /**
+     * @brief Retrieves the number of tuner::count_allocation calls made on the calling thread so far.
+     *
+     * @return The count since the thread started, 0 if the host does not call tuner::count_allocation.
+     */
+    uint64_t thread_allocation_count() noexcept;
+
+    /**
+     * @brief Per-instance counters and latency histograms for the tuning pipeline.
+     *
+     * Counters are relaxed atomics, so a snapshot can be taken from another thread (e.g. a metrics exporter)
+     * while the owning thread keeps recording.
+     */
+    class metrics {
+    public:
+        metrics();
+
+        metrics(const metrics &) = delete;
+
+        metrics &operator=(const metrics &) = delete;
+
+        void record_stage(tuner::stage s, uint64_t ns) noexcept;
+
+        void record_frame() noexcept;
+
+        void record_gated_frame() noexcept;
+
+        void record_allocation(uint64_t count = 1) noexcept;
+
+        /**
+         * @brief Copies the current counters into a plain struct that can be exported into an external metrics system.
+         *
+         * @return A metrics_snapshot holding the counters recorded since construction or the last reset.
+         */
+        [[nodiscard]] tuner::metrics_snapshot snapshot() const noexcept;
+
+        void reset() noexcept;
+
+    private:
+        struct stage_counters {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> total_ns{0};
+            std::atomic<uint64_t> min_ns{UINT64_MAX};
+            std::atomic<uint64_t> max_ns{0};
+            std::array<std::atomic<uint64_t>, LATENCY_HISTOGRAM_BUCKETS> histogram;
+        };
+
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> gated_frames{0};
+        std::atomic<uint64_t> allocations{0};
+        std::array<stage_counters, STAGE_COUNT> stages;
+    };
+
+    /**
+     * @brief Records the allocations of the calling thread during its lifetime, see tuner::thread_allocation_count. A
+     *        null 'm' records nothing.
+     *
+     * Only the outermost counter of a thread records, so an engine frame inside tune() is not counted twice.
+     */
+    class scoped_allocation_counter {
+    public:
+        explicit scoped_allocation_counter(tuner::metrics *m) noexcept;
+
+        ~scoped_allocation_counter();
+
+        scoped_allocation_counter(const scoped_allocation_counter &) = delete;
+
+        scoped_allocation_counter &operator=(const scoped_allocation_counter &) = delete;
+
+    private:
+        tuner::metrics *m;
+        bool outermost;
+        uint64_t start;
+    };
+
+    /**
+     * @brief Records the lifetime of the timer as one call of the given stage. A null 'm' records nothing.
+     */
+    class scoped_stage_timer {
+    public:
+        scoped_stage_timer(tuner::metrics *m, tuner::stage s) noexcept;
+
+        ~scoped_stage_timer();
+
+        scoped_stage_timer(const scoped_stage_timer &) = delete;
+
+        scoped_stage_timer &operator=(const scoped_stage_timer &) = delete;
+
+    private:
+        tuner::metrics *m;
+        tuner::stage s;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+// The pipeline records through these macros so that a build without TUNER_INSTRUMENTATION
+// carries no timers, no clock reads and no counter updates.
+#define TUNER_METRICS_CONCAT_INNER(a, b) a##b
+#define TUNER_METRICS_CONCAT(a, b) TUNER_METRICS_CONCAT_INNER(a, b)
+
+#if defined(TUNER_INSTRUMENTATION)
+#define TUNER_METRICS_STAGE(m, s) tuner::scoped_stage_timer TUNER_METRICS_CONCAT(tuner_stage_timer_, __LINE__)(m, s)
+#define TUNER_METRICS_FRAME(m) do { if (m) { (m)->record_frame(); } } while (0)
+#define TUNER_METRICS_GATED_FRAME(m) do { if (m) { (m)->record_gated_frame(); } } while (0)
+#define TUNER_METRICS_ALLOCATIONS(m) tuner::scoped_allocation_counter TUNER_METRICS_CONCAT(tuner_allocations_, __LINE__)(m)
+#else
+#define TUNER_METRICS_STAGE(m, s) ((void) 0)
+#define TUNER_METRICS_FRAME(m) ((void) 0)
+#define TUNER_METRICS_GATED_FRAME(m) ((void) 0)
+#define TUNER_METRICS_ALLOCATIONS(m) ((void) 0)
+#endif
+
+#endif //TUNER_METRICS_H
@@ -0,0 +1,192 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <tuner/metrics.hpp>
+#include <tuner/tuner.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(TUNER_INSTRUMENTATION)
+// the library leaves operator new alone, so this executable counts its allocations the way a host would; the array
+// and nothrow forms of the standard library call these, and the default operator delete frees what std::malloc and
+// std::aligned_alloc return
+void *operator new(size_t size) {
+    tuner::count_allocation();
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+    tuner::count_allocation();
+    const auto a = static_cast<size_t>(alignment);
+    // std::aligned_alloc wants a multiple of the alignment
+    if (void *p = std::aligned_alloc(a, (std::max<size_t>(size, 1) + a - 1) / a * a)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
+
+TEST_CASE("[stage_name] every stage has a name") {
+    for (int i = 0; i < tuner::STAGE_COUNT; i++) {
+        REQUIRE(std::string(tuner::stage_name(static_cast<tuner::stage>(i))) != "unknown");
+    }
+}
+
+TEST_CASE("[latency_histogram_bucket] zero nanoseconds falls into the first bucket") {
+    REQUIRE(tuner::latency_histogram_bucket(0) == 0);
+}
+
+TEST_CASE("[latency_histogram_bucket] buckets are powers of two") {
+    REQUIRE(tuner::latency_histogram_bucket(1) == 1);
+    REQUIRE(tuner::latency_histogram_bucket(2) == 2);
+    REQUIRE(tuner::latency_histogram_bucket(3) == 2);
+    REQUIRE(tuner::latency_histogram_bucket(1024) == 11);
+}
+
+TEST_CASE("[latency_histogram_bucket] large durations fall into the last bucket") {
+    REQUIRE(tuner::latency_histogram_bucket(UINT64_MAX) == tuner::LATENCY_HISTOGRAM_BUCKETS - 1);
+}
+
+TEST_CASE("[metrics] a new instance has no recorded values") {
+    tuner::metrics m;
+    tuner::metrics_snapshot s = m.snapshot();
+    REQUIRE(s.frames == 0);
+    REQUIRE(s.gated_frames == 0);
+    REQUIRE(s.allocations == 0);
+    for (const tuner::stage_snapshot &stage: s.stages) {
+        REQUIRE(stage.calls == 0);
+        REQUIRE(stage.min_ns == 0);
+        REQUIRE(stage.max_ns == 0);
+    }
+}
+
+TEST_CASE("[metrics] stage timings are accumulated") {
+    tuner::metrics m;
+    m.record_stage(tuner::stage::fft, 100);
+    m.record_stage(tuner::stage::fft, 300);
+    m.record_stage(tuner::stage::hps, 50);
+
+    tuner::metrics_snapshot s = m.snapshot();
+    const tuner::stage_snapshot &fft = s.stages[static_cast<int>(tuner::stage::fft)];
+    REQUIRE(fft.calls == 2);
+    REQUIRE(fft.total_ns == 400);
+    REQUIRE(fft.min_ns == 100);
+    REQUIRE(fft.max_ns == 300);
+    REQUIRE(fft.histogram[tuner::latency_histogram_bucket(100)] == 1);
+    REQUIRE(fft.histogram[tuner::latency_histogram_bucket(300)] == 1);
+    REQUIRE(s.stages[static_cast<int>(tuner::stage::hps)].calls == 1);
+    REQUIRE(s.stages[static_cast<int>(tuner::stage::window)].calls == 0);
+}
+
+TEST_CASE("[metrics] frame, gated frame and allocation counters") {
+    tuner::metrics m;
+    m.record_frame();
+    m.record_frame();
+    m.record_gated_frame();
+    m.record_allocation();
+    m.record_allocation(4);
+
+    tuner::metrics_snapshot s = m.snapshot();
+    REQUIRE(s.frames == 2);
+    REQUIRE(s.gated_frames == 1);
+    REQUIRE(s.allocations == 5);
+}
+
+TEST_CASE("[metrics] reset clears all counters") {
+    tuner::metrics m;
+    m.record_frame();
+    m.record_stage(tuner::stage::window, 10);
+    m.reset();
+
+    tuner::metrics_snapshot s = m.snapshot();
+    REQUIRE(s.frames == 0);
+    REQUIRE(s.stages[static_cast<int>(tuner::stage::window)].calls == 0);
+    REQUIRE(s.stages[static_cast<int>(tuner::stage::window)].histogram[tuner::latency_histogram_bucket(10)] == 0);
+}
+
+TEST_CASE("[scoped_allocation_counter] records the allocations of its scope once") {
+    tuner::metrics m;
+    uint64_t before = tuner::thread_allocation_count();
+    {
+        tuner::scoped_allocation_counter outer(&m);
+        tuner::scoped_allocation_counter inner(&m);
+        auto v = std::make_unique<std::vector<float>>(64);
+        REQUIRE(v->size() == 64);
+    }
+    uint64_t counted = tuner::thread_allocation_count() - before;
+
+    REQUIRE(m.snapshot().allocations == counted);
+#if defined(TUNER_INSTRUMENTATION)
+    REQUIRE(counted >= 2);
+#else
+    REQUIRE(counted == 0);
+#endif
+}
+
+TEST_CASE("[metrics] tune records the allocations of the whole call") {
+    std::array<float, TUNER_SIZE> buffer = {};
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        buffer[i] = 0.5f * std::sin(2.0f * float(M_PI) * 110.0f * float(i) / 48000.0f);
+    }
+
+    tuner::metrics m;
+    uint64_t before = tuner::thread_allocation_count();
+    tuner::note_context *n = tuner::tune(buffer, 48000, &m);
+    uint64_t counted = tuner::thread_allocation_count() - before;
+    delete n;
+
+    REQUIRE(m.snapshot().allocations == counted);
+#if defined(TUNER_INSTRUMENTATION)
+    // at least the returned note
+    REQUIRE(counted >= 1);
+#endif
+}
+
+TEST_CASE("[metrics] tune keeps its engine while the sample rate stays the same") {
+    std::array<float, TUNER_SIZE> buffer = {};
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        buffer[i] = 0.5f * std::sin(2.0f * float(M_PI) * 110.0f * float(i) / 48000.0f);
+    }
+
+    delete tuner::tune(buffer, 44100);
+    tuner::metrics changed;
+    delete tuner::tune(buffer, 48000, &changed);
+    tuner::metrics same;
+    delete tuner::tune(buffer, 48000, &same);
+
+#if defined(TUNER_INSTRUMENTATION)
+    REQUIRE(same.snapshot().frames == 1);
+    // the engine built for the new sample rate is not built again
+    REQUIRE(same.snapshot().allocations < changed.snapshot().allocations);
+#endif
+}
+
+TEST_CASE("[scoped_stage_timer] records one call when it goes out of scope") {
+    tuner::metrics m;
+    {
+        tuner::scoped_stage_timer t(&m, tuner::stage::interpolation);
+    }
+
+    REQUIRE(m.snapshot().stages[static_cast<int>(tuner::stage::interpolation)].calls == 1);
+}
+
+TEST_CASE("[scoped_stage_timer] null metrics records nothing") {
+    tuner::scoped_stage_timer t(nullptr, tuner::stage::interpolation);
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#include <tuner/dsp.hpp>
+#include <tuner/kernels.hpp>
+#include <tuner/multichannel.hpp>
+#include <tuner/window_table.hpp>
+
+namespace {
+    constexpr int HPS_SIZE = tuner::INTERPOLATED_SIZE / 5;
+}
+
+tuner::multichannel_engine::multichannel_engine(int sample_rate, int channels,
+                                                const std::vector<tuner::search_range> &ranges)
+        : rate(sample_rate), channel_count(channels), lanes(0), plan(), fft(), pair_fft(TUNER_SIZE), fft_res(),
+          pair_res(), mag_s() {
+    if (sample_rate <= 0) {
+        throw tuner::InvalidSampleRateException();
+    }
+    if (channels <= 0 || (!ranges.empty() && int(ranges.size()) != channels)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    lanes = (channels + tuner::CHANNEL_LANES - 1) / tuner::CHANNEL_LANES * tuner::CHANNEL_LANES;
+    frames.resize(size_t(channels));
+    powers.resize(size_t(channels));
+    gated.resize(size_t(channels));
+    voiced.reserve(size_t(channels));
+    interpolated.resize(size_t(tuner::INTERPOLATED_SIZE) * lanes);
+    hps.resize(size_t(tuner::INTERPOLATED_SIZE) * lanes);
+    peak.resize(size_t(lanes));
+    peak_bin.resize(size_t(lanes));
+    notes.resize(size_t(channels));
+
+    // HPS bin i corresponds to i * sample_rate / TUNER_SIZE / NUM_HPS Hz
+    float bins_per_hz = float(TUNER_SIZE) * float(tuner::NUM_HPS) / float(sample_rate);
+    min_bin.assign(size_t(lanes), 0);
+    max_bin.assign(size_t(lanes), 0);
+    for (int c = 0; c < channels; c++) {
+        max_bin[c] = HPS_SIZE;
+        if (!ranges.empty()) {
+            min_bin[c] = std::clamp(int(std::ceil(ranges[c].min_frequency * bins_per_hz)), 0, HPS_SIZE);
+            if (ranges[c].max_frequency > 0) {
+                max_bin[c] = std::clamp(int(std::floor(ranges[c].max_frequency * bins_per_hz)) + 1, min_bin[c], HPS_SIZE);
+            }
+        }
+    }
+
+    plan = tuner::plan_cache::shared().plan(sample_rate, TUNER_SIZE);
+    fft = tuner::plan_cache::shared().lease_fft(TUNER_SIZE);
+    if (fft.get() == nullptr) {
+        throw std::bad_alloc();
+    }
+}
+
+tuner::multichannel_engine::~multichannel_engine() = default;
+
+const std::vector<tuner::realtime_note> &tuner::multichannel_engine::process(const float *interleaved) noexcept {
+    // deinterleave once into the structure-of-arrays buffer, then window each channel in place
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        const float *frame = interleaved + size_t(i) * channel_count;
+        for (int c = 0; c < channel_count; c++) {
+            frames[c].samples[i] = frame[c];
+        }
+    }
+    for (int c = 0; c < channel_count; c++) {
+        float *samples = frames[c].samples.data();
+        powers[c] = tuner::apply_window_and_sum_squares(samples, tuner::HANN_WINDOW<TUNER_SIZE>.data(), samples, TUNER_SIZE) / float(TUNER_SIZE);
+    }
+
+    analyze(powers.data());
+    return notes;
+}
+
+const std::vector<tuner::realtime_note> &
+tuner::multichannel_engine::process_pcm(const uint8_t *frames_in, tuner::sample_format format) noexcept {
+    tuner::pcm_layout layout;
+    layout.format = format;
+    layout.channels = channel_count;
+    for (int c = 0; c < channel_count; c++) {
+        layout.channel = c;
+        powers[c] = tuner::convert_and_window(frames_in, layout, tuner::HANN_WINDOW<TUNER_SIZE>.data(), frames[c].samples.data(), TUNER_SIZE);
+    }
+
+    analyze(powers.data());
+    return notes;
+}
+
+bool tuner::multichannel_engine::interpolate_channel(const kiss_fft_cpx *spectrum, int channel) noexcept {
+    tuner::real_magnitude(spectrum, mag_s.data(), TUNER_SIZE / 2);
+    // the FFT has consumed the channel's frame, so it receives the power spectrum for the confidence
+    tuner::power_spectrum(spectrum, frames[channel].samples.data(), TUNER_SIZE / 2);
+    tuner::suppress_noise(mag_s.data(), *plan);
+    return tuner::interpolate_spectrum(mag_s.data(), *plan, interpolated.data() + channel, lanes);
+}
+
+void tuner::multichannel_engine::analyze(const float *signal_power) noexcept {
+    voiced.clear();
+    for (int c = 0; c < channel_count; c++) {
+        gated[c] = signal_power[c] < tuner::SIGNAL_POWER_THRESHOLD;
+        if (gated[c]) {
+            // gated channels are reported as LOW below, so their transform can be skipped
+            for (int k = 0; k < tuner::INTERPOLATED_SIZE; k++) {
+                interpolated[size_t(k) * lanes + c] = 0;
+            }
+            continue;
+        }
+        voiced.push_back(c);
+    }
+
+    // two real channels per complex FFT, and kiss_fftr for an odd one out
+    size_t v = 0;
+    for (; v + 1 < voiced.size(); v += 2) {
+        pair_fft.transform(frames[voiced[v]].samples.data(), frames[voiced[v + 1]].samples.data(), fft_res.data(),
+                           pair_res.data());
+        gated[voiced[v]] = !interpolate_channel(fft_res.data(), voiced[v]);
+        gated[voiced[v + 1]] = !interpolate_channel(pair_res.data(), voiced[v + 1]);
+    }
+    if (v < voiced.size()) {
+        kiss_fftr(fft.get(), frames[voiced[v]].samples.data(), fft_res.data());
+        gated[voiced[v]] = !interpolate_channel(fft_res.data(), voiced[v]);
+    }
+
+    // the HPS of tuner::calculate_hps for all channels at once; each row holds one bin of every channel
+    const int stride = lanes;
+    for (size_t k = 0; k < interpolated.size(); k++) {
+        hps[k] = interpolated[k] * interpolated[k];
+    }
+    for (int h = 2; h <= tuner::NUM_HPS; h++) {
+        int hps_len = tuner::INTERPOLATED_SIZE / h;
+        for (int j = 0; j < hps_len; j++) {
+            float *row = hps.data() + size_t(j) * stride;
+            const float *harmonic = interpolated.data() + size_t(j) * h * stride;
+            for (int c = 0; c < stride; c++) {
+                row[c] = row[c] * harmonic[c];
+            }
+        }
+    }
+
+    std::fill(peak.begin(), peak.end(), 0.0f);
+    std::fill(peak_bin.begin(), peak_bin.end(), 0);
+    for (int j = 0; j < HPS_SIZE; j++) {
+        const float *row = hps.data() + size_t(j) * stride;
+        for (int c = 0; c < stride; c++) {
+            bool better = j >= min_bin[c] && j < max_bin[c] && row[c] > peak[c];
+            peak[c] = better ? row[c] : peak[c];
+            peak_bin[c] = better ? j : peak_bin[c];
+        }
+    }
+
+    for (int c = 0; c < channel_count; c++) {
+        if (gated[c]) {
+            notes[c] = tuner::realtime_note();
+            std::strncpy(notes[c].name, "LOW", sizeof(notes[c].name) - 1);
+            continue;
+        }
+
+        float frequency = float(peak_bin[c]) * (float(rate) / float(TUNER_SIZE)) / float(tuner::NUM_HPS);
+        tuner::find_note_for_frequency(frequency, notes[c]);
+        notes[c].confidence = tuner::pitch_confidence(hps.data() + size_t(min_bin[c]) * stride + c,
+                                                      max_bin[c] - min_bin[c], stride, frames[c].samples.data(), rate,
+                                                      frequency);
+    }
+}
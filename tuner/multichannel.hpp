@@ -0,0 +1,125 @@
+#ifndef TUNER_MULTICHANNEL_H
+#define TUNER_MULTICHANNEL_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <kiss_fftr.h>
+
+#include <tuner/engine.hpp>
+#include <tuner/global.hpp>
+#include <tuner/paired_fft.hpp>
+#include <tuner/pcm.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/realtime.hpp>
+
+namespace tuner {
+
+    // channels are padded to a multiple of this so the per-bin loops over channels map onto whole SIMD vectors
+    constexpr int CHANNEL_LANES = 4;
+
+    /**
+     * @brief The frequencies a channel's pitch is searched in, e.g. the range of the string a hexaphonic pickup channel
+     *        belongs to. A 'max_frequency' of 0 searches up to the highest frequency the HPS can report.
+     */
+    struct search_range {
+        float min_frequency = 0;
+        float max_frequency = 0;
+    };
+
+    /**
+     * @brief Analyzes every channel of an interleaved multichannel frame, e.g. one channel per string of a hexaphonic pickup.
+     *
+     * process() deinterleaves the frame once into a cache-aligned structure-of-arrays buffer and windows each channel in
+     * place. After the per-channel FFTs, the interpolated spectra are stored bin by bin with the channels side by side,
+     * so the HPS and the peak search run across all channels at once with SIMD lanes mapped to channels. Voiced
+     * channels are transformed two at a time with tuner::paired_fft, so the spectra can differ from kiss_fftr by float
+     * rounding. Like
+     * tuner::realtime_engine, everything is allocated by the constructor and processing is noexcept and allocation free;
+     * with full search ranges the results match tuner::realtime_engine run on each channel to within that rounding.
+     */
+    class multichannel_engine {
+    public:
+        /**
+         * @param sample_rate The sample rate of the frames that will be processed.
+         * @param channels The number of interleaved channels.
+         * @param ranges One search range per channel, or empty to search every channel over the full range.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         * @throws InvalidConfigurationException If 'channels' is not positive or 'ranges' has neither 0 nor 'channels' entries.
+         * @throws std::bad_alloc If the FFT plan cannot be allocated.
+         */
+        multichannel_engine(int sample_rate, int channels, const std::vector<tuner::search_range> &ranges = {});
+
+        ~multichannel_engine();
+
+        multichannel_engine(const multichannel_engine &) = delete;
+
+        multichannel_engine &operator=(const multichannel_engine &) = delete;
+
+        /**
+         * @brief Performs tuning on every channel of TUNER_SIZE interleaved float sample frames.
+         *
+         * @param interleaved TUNER_SIZE * channels() samples, channel 0 of frame 0 first.
+         *
+         * @return One note per channel. Channels whose signal energy is too low, or whose spectrum is suppressed entirely,
+         *         are named "LOW" with -1 frequencies, like the realtime_status::low_energy results of
+         *         tuner::realtime_engine.
+         */
+        const std::vector<tuner::realtime_note> &process(const float *interleaved) noexcept;
+
+        /**
+         * @brief Performs tuning on every channel of TUNER_SIZE interleaved little-endian PCM sample frames.
+         *
+         * @param frames The first byte of the first sample frame, tightly packed.
+         * @param format The format of each sample.
+         *
+         * @return One note per channel, see process().
+         */
+        const std::vector<tuner::realtime_note> &process_pcm(const uint8_t *frames, tuner::sample_format format) noexcept;
+
+        [[nodiscard]] int channels() const noexcept { return channel_count; }
+
+        [[nodiscard]] int sample_rate() const noexcept { return rate; }
+
+    private:
+        struct alignas(64) channel_frame {
+            std::array<float, TUNER_SIZE> samples;
+        };
+
+        void analyze(const float *signal_power) noexcept;
+
+        // false if nothing of the channel's spectrum is left after the noise suppression
+        bool interpolate_channel(const kiss_fft_cpx *spectrum, int channel) noexcept;
+
+        int rate;
+        int channel_count;
+        int lanes;
+        std::shared_ptr<const tuner::frame_plan> plan;
+        // the plan of the odd voiced channel out, lent by tuner::plan_cache
+        tuner::fft_lease fft;
+        tuner::paired_fft pair_fft;
+        // one windowed frame per channel, replaced by its power spectrum once transformed
+        std::vector<channel_frame> frames;
+        std::vector<float> powers;
+        // the channels reported as LOW: too little signal energy, or no spectrum left after the noise suppression
+        std::vector<uint8_t> gated;
+        std::array<kiss_fft_cpx, TUNER_SIZE / 2 + 1> fft_res;
+        std::array<kiss_fft_cpx, TUNER_SIZE / 2 + 1> pair_res;
+        // the voiced channels of the current frame
+        std::vector<int> voiced;
+        std::array<float, TUNER_SIZE / 2> mag_s;
+        // INTERPOLATED_SIZE rows of 'lanes' channels
+        std::vector<float> interpolated;
+        std::vector<float> hps;
+        // per channel HPS bin range [min_bin, max_bin)
+        std::vector<int> min_bin;
+        std::vector<int> max_bin;
+        std::vector<float> peak;
+        std::vector<int> peak_bin;
+        std::vector<tuner::realtime_note> notes;
+    };
+}
+
+#endif //TUNER_MULTICHANNEL_H
@@ -0,0 +1,126 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/multichannel.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/test_signals.hpp>
+
+const std::vector<float> STANDARD_TUNING = {82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f};
+
+std::vector<float> hexaphonic_frame(int sample_rate) {
+    std::vector<float> interleaved(STANDARD_TUNING.size() * TUNER_SIZE);
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        for (size_t c = 0; c < STANDARD_TUNING.size(); c++) {
+            interleaved[i * STANDARD_TUNING.size() + c] = tuner::test::harmonic_sample(STANDARD_TUNING[c], sample_rate, i);
+        }
+    }
+
+    return interleaved;
+}
+
+TEST_CASE("[multichannel_engine] invalid configuration") {
+    REQUIRE_THROWS_AS(tuner::multichannel_engine(0, 2), tuner::InvalidSampleRateException);
+    REQUIRE_THROWS_AS(tuner::multichannel_engine(48000, 0), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::multichannel_engine(48000, 2, {{}}), tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[multichannel_engine] every channel matches the realtime engine") {
+    constexpr int sample_rate = 48000;
+    std::vector<float> interleaved = hexaphonic_frame(sample_rate);
+
+    tuner::multichannel_engine e(sample_rate, int(STANDARD_TUNING.size()));
+    const std::vector<tuner::realtime_note> &notes = e.process(interleaved.data());
+    REQUIRE(notes.size() == STANDARD_TUNING.size());
+
+    tuner::realtime_engine reference(sample_rate);
+    std::vector<float> channel(TUNER_SIZE);
+    for (size_t c = 0; c < STANDARD_TUNING.size(); c++) {
+        for (int i = 0; i < TUNER_SIZE; i++) {
+            channel[i] = interleaved[i * STANDARD_TUNING.size() + c];
+        }
+        tuner::realtime_note expected;
+        reference.process(channel.data(), expected);
+        // channels are transformed in pairs, so the peak may move by one HPS bin of float rounding
+        REQUIRE(std::abs(notes[c].actual_frequency - expected.actual_frequency) <=
+                float(sample_rate) / float(TUNER_SIZE) / float(tuner::NUM_HPS));
+        REQUIRE(std::string(notes[c].name) == expected.name);
+        REQUIRE(std::abs(notes[c].confidence - expected.confidence) < 0.05f);
+    }
+}
+
+TEST_CASE("[multichannel_engine] silent channels are LOW") {
+    std::vector<float> interleaved(3 * TUNER_SIZE, 0.0f);
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        interleaved[i * 3 + 1] = tuner::test::harmonic_sample(196.0f, 48000, i);
+    }
+
+    tuner::multichannel_engine e(48000, 3);
+    const std::vector<tuner::realtime_note> &notes = e.process(interleaved.data());
+    REQUIRE(std::string(notes[0].name) == "LOW");
+    REQUIRE(notes[0].actual_frequency == -1);
+    REQUIRE(notes[1].actual_frequency > 180);
+    REQUIRE(notes[1].actual_frequency < 205);
+    REQUIRE(std::string(notes[2].name) == "LOW");
+}
+
+TEST_CASE("[multichannel_engine] a channel without spectrum is LOW next to a tone") {
+    // a click on the first sample has signal energy, but the Hann window is zero there, so no spectrum is left; it is
+    // the odd channel out, whose kiss_fftr spectrum is exactly zero instead of the rounding left by a paired transform
+    std::vector<float> interleaved(3 * TUNER_SIZE, 0.0f);
+    interleaved[2] = 1.0f;
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        interleaved[i * 3] = tuner::test::harmonic_sample(110.0f, 48000, i);
+        interleaved[i * 3 + 1] = tuner::test::harmonic_sample(146.83f, 48000, i);
+    }
+
+    tuner::multichannel_engine e(48000, 3);
+    const std::vector<tuner::realtime_note> &notes = e.process(interleaved.data());
+    REQUIRE(std::string(notes[0].name) == "A2");
+    REQUIRE(std::string(notes[1].name) == "D3");
+    REQUIRE(std::string(notes[2].name) == "LOW");
+    REQUIRE(notes[2].actual_frequency == -1);
+    REQUIRE(notes[2].confidence == 0);
+
+    tuner::realtime_engine reference(48000);
+    std::vector<float> click(TUNER_SIZE, 0.0f);
+    click[0] = 1.0f;
+    tuner::realtime_note n;
+    REQUIRE(reference.process(click.data(), n) == tuner::realtime_status::low_energy);
+}
+
+TEST_CASE("[multichannel_engine] search ranges limit each channel") {
+    constexpr int sample_rate = 48000;
+    std::vector<float> interleaved = hexaphonic_frame(sample_rate);
+
+    std::vector<tuner::search_range> ranges;
+    for (float f: STANDARD_TUNING) {
+        ranges.push_back({f * 0.85f, f * 1.15f});
+    }
+    tuner::multichannel_engine e(sample_rate, int(STANDARD_TUNING.size()), ranges);
+    const std::vector<tuner::realtime_note> &notes = e.process(interleaved.data());
+    for (size_t c = 0; c < STANDARD_TUNING.size(); c++) {
+        REQUIRE(notes[c].actual_frequency >= ranges[c].min_frequency);
+        REQUIRE(notes[c].actual_frequency <= ranges[c].max_frequency);
+    }
+}
+
+TEST_CASE("[multichannel_engine] pcm input matches float input") {
+    constexpr int sample_rate = 44100;
+    std::vector<float> interleaved = hexaphonic_frame(sample_rate);
+    std::vector<int16_t> pcm(interleaved.size());
+    for (size_t i = 0; i < pcm.size(); i++) {
+        pcm[i] = int16_t(interleaved[i] * 32767.0f);
+        interleaved[i] = float(pcm[i]) / 32768.0f;
+    }
+
+    tuner::multichannel_engine from_float(sample_rate, int(STANDARD_TUNING.size()));
+    tuner::multichannel_engine from_pcm(sample_rate, int(STANDARD_TUNING.size()));
+    const std::vector<tuner::realtime_note> &expected = from_float.process(interleaved.data());
+    const std::vector<tuner::realtime_note> &notes =
+            from_pcm.process_pcm(reinterpret_cast<const uint8_t *>(pcm.data()), tuner::sample_format::pcm_s16);
+    for (size_t c = 0; c < STANDARD_TUNING.size(); c++) {
+        REQUIRE(notes[c].actual_frequency == expected[c].actual_frequency);
+    }
+}
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <tuner/dsp.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/kernels.hpp>
+#include <tuner/multires.hpp>
+#include <tuner/window_table.hpp>
+
+namespace {
+    void set_low(tuner::realtime_note &out) {
+        out = tuner::realtime_note();
+        std::strncpy(out.name, "LOW", sizeof(out.name) - 1);
+    }
+}
+
+tuner::multires_engine::multires_engine(int sample_rate, const tuner::multires_config &config, tuner::metrics *metrics)
+        : rate(sample_rate), config(config), metrics(metrics), last_size(0) {
+    if (sample_rate <= 0) {
+        throw tuner::InvalidSampleRateException();
+    }
+    if (tuner::hann_window(config.small_size) == nullptr || tuner::hann_window(config.large_size) == nullptr ||
+        config.small_size >= config.large_size || !(config.min_confidence >= 0 && config.min_confidence <= 1) ||
+        !(config.escalate_below >= 0) || !(config.hum_cutoff >= 0)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    allocate(coarse, config.small_size);
+    allocate(fine, config.large_size);
+}
+
+tuner::multires_engine::~multires_engine() = default;
+
+void tuner::multires_engine::allocate(resolution &r, int size) {
+    const int bins = size / 2;
+    r.size = size;
+    r.plan = tuner::plan_cache::shared().plan(rate, size, config.hum_cutoff);
+    r.fft = tuner::plan_cache::shared().lease_fft(size);
+    r.in.resize(size_t(size));
+    r.fft_res.resize(size_t(bins + 1));
+    r.mag_s.resize(size_t(bins));
+    r.interpolated.resize(size_t(bins) * size_t(tuner::NUM_HPS));
+    r.hps.resize(r.interpolated.size());
+}
+
+tuner::realtime_status tuner::multires_engine::process(const float *history, tuner::realtime_note &out) noexcept {
+    if (history == nullptr) {
+        return tuner::realtime_status::invalid_input;
+    }
+    TUNER_METRICS_FRAME(metrics);
+    TUNER_METRICS_ALLOCATIONS(metrics);
+    last_size = 0;
+
+    // the small window holds the latest samples
+    float power;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+        const float *latest = history + (fine.size - coarse.size);
+        power = tuner::apply_window_and_sum_squares(latest, coarse.plan->window, coarse.in.data(), coarse.size) /
+                float(coarse.size);
+    }
+    if (power < tuner::SIGNAL_POWER_THRESHOLD) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        set_low(out);
+        return tuner::realtime_status::low_energy;
+    }
+
+    float confidence;
+    float frequency = analyze(coarse, confidence);
+    last_size = coarse.size;
+    // a frame with nothing left of its small window spectrum, -1, is escalated as well
+    if (frequency < config.escalate_below || confidence < config.min_confidence) {
+        {
+            TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+            tuner::apply_window(history, fine.plan->window, fine.in.data(), fine.size);
+        }
+        frequency = analyze(fine, confidence);
+        last_size = fine.size;
+    }
+    if (frequency < 0) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        last_size = 0;
+        set_low(out);
+        return tuner::realtime_status::low_energy;
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::note_lookup);
+        tuner::find_note_for_frequency(frequency, out);
+    }
+    out.confidence = confidence;
+
+    return tuner::realtime_status::ok;
+}
+
+float tuner::multires_engine::analyze(resolution &r, float &confidence) noexcept {
+    const tuner::frame_plan &plan = *r.plan;
+    const int bins = plan.bins;
+    const float delta_frequency = plan.delta_frequency;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::fft);
+        kiss_fftr(r.fft.get(), r.in.data(), r.fft_res.data());
+        // the FFT has consumed the frame, so 'in' receives the power spectrum; unlike tuner::engine the magnitude is
+        // that of the complex bins, not of their real parts, which a small window cannot afford to lose
+        tuner::power_spectrum(r.fft_res.data(), r.in.data(), bins);
+        for (int k = 0; k < bins; k++) {
+            r.mag_s[k] = std::sqrt(r.in[k]);
+        }
+    }
+
+    const int first_bin = plan.hum_bins;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::hum_suppression);
+        std::fill(r.mag_s.begin(), r.mag_s.begin() + first_bin, 0.0f);
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::band_suppression);
+        tuner::suppress_below_octave_bands(r.mag_s.data(), plan.bands.data(), int(plan.bands.size()));
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::interpolation);
+        if (!tuner::interpolate_spectrum(r.mag_s.data(), plan, r.interpolated.data(), 1)) {
+            confidence = 0;
+            return -1;
+        }
+    }
+
+    int hps_len;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::hps);
+        hps_len = tuner::harmonic_product_spectrum(r.interpolated.data(), int(r.interpolated.size()), r.hps.data());
+    }
+
+    float frequency;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::peak_pick);
+        int max_index = 0;
+        float tmp_max = 0;
+        for (int i = 0; i < hps_len; i++) {
+            if (r.hps[i] > tmp_max) {
+                tmp_max = r.hps[i];
+                max_index = i;
+            }
+        }
+        frequency = float(max_index) * delta_frequency / float(tuner::NUM_HPS);
+        confidence = tuner::hps_clarity(r.hps.data(), hps_len) *
+                     tuner::harmonic_energy_fraction(r.in.data(), bins, first_bin, frequency / delta_frequency);
+    }
+
+    return frequency;
+}
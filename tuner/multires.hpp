@@ -0,0 +1,123 @@
+#ifndef TUNER_MULTIRES_H
+#define TUNER_MULTIRES_H
+
+#include <vector>
+
+#include <kiss_fftr.h>
+
+#include <tuner/global.hpp>
+#include <tuner/metrics.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/realtime.hpp>
+
+namespace tuner {
+
+    struct multires_config {
+        // the window every frame is analyzed with first, a power of two from MIN_WINDOW_TABLE_SIZE
+        int small_size = TUNER_SIZE / 2;
+        // the window of escalated frames, a larger power of two up to MAX_WINDOW_TABLE_SIZE
+        int large_size = 2 * TUNER_SIZE;
+        // pitches of the small window below this are escalated; the default small window holds less than five periods of
+        // them at 48 kHz
+        float escalate_below = 200;
+        // and so are pitches whose tuner::realtime_note::confidence is below this
+        float min_confidence = 0.5f;
+        // bins below this are zeroed as mains hum, as in the other engines; lower it to reach the low B of a 7-string
+        float hum_cutoff = 62;
+    };
+
+    /**
+     * @brief Detects the pitch of a stream with a small window first and a large one only when the small one is not
+     *        good enough.
+     *
+     * A fixed TUNER_SIZE frame is longer than the high strings need and too short to resolve the harmonics of the low
+     * ones. Here every frame is analyzed over the latest 'small_size' samples first. Only a pitch below
+     * 'escalate_below' or a confidence below 'min_confidence' escalates the frame to the latest 'large_size' samples,
+     * which the caller already holds in its history. With the defaults, high notes take about half the time of
+     * tuner::realtime_engine and half its latency. Low notes take about three times as long but get twice the
+     * resolution.
+     *
+     * The pipeline is that of tuner::realtime_engine, except that the magnitude spectrum is the magnitude of the
+     * complex bins instead of the absolute real parts that tuner::tune uses. A window of TUNER_SIZE / 2 resolves the
+     * harmonics too coarsely to lose half of their energy to the phase.
+     *
+     * Both FFT plans and every buffer are allocated by the constructor and process() is noexcept, so it can run on a
+     * real-time audio thread. tuner::noise_floor and tuner::onset_detector work on TUNER_SIZE frames and cannot be used
+     * here.
+     */
+    class multires_engine {
+    public:
+        /**
+         * @param sample_rate The sample rate of the stream.
+         * @param config The two window sizes and when to escalate.
+         * @param metrics Optional counters that receive stage timings when built with TUNER_INSTRUMENTATION.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         * @throws InvalidConfigurationException If a window size has no precomputed Hanning window (see
+         *                                       tuner::hann_window), 'small_size' is not below 'large_size',
+         *                                       'min_confidence' is not in [0, 1] or 'escalate_below' or 'hum_cutoff'
+         *                                       is negative.
+         */
+        explicit multires_engine(int sample_rate, const tuner::multires_config &config = {},
+                                 tuner::metrics *metrics = nullptr);
+
+        ~multires_engine();
+
+        multires_engine(const multires_engine &) = delete;
+
+        multires_engine &operator=(const multires_engine &) = delete;
+
+        /**
+         * @brief Performs tuning on the latest samples of a stream.
+         *
+         * @param history The latest large_size() samples of the stream, oldest first. The first large_size() -
+         *                small_size() of them are only read when the frame is escalated.
+         * @param out Receives the detected note. Set to the "LOW" note for realtime_status::low_energy, untouched
+         *            otherwise.
+         *
+         * @return realtime_status::ok if a note was detected, realtime_status::low_energy if the signal energy of the
+         *         small window is too low or nothing of the spectrum is left after the hum and band suppression.
+         */
+        tuner::realtime_status process(const float *history, tuner::realtime_note &out) noexcept;
+
+        /**
+         * @brief The window the last note was detected with, small_size() or large_size(), 0 if there was none.
+         */
+        [[nodiscard]] int last_frame_size() const noexcept { return last_size; }
+
+        [[nodiscard]] int small_size() const noexcept { return coarse.size; }
+
+        [[nodiscard]] int large_size() const noexcept { return fine.size; }
+
+        [[nodiscard]] int sample_rate() const noexcept { return rate; }
+
+    private:
+        // the plan and the buffers of one window size
+        struct resolution {
+            int size = 0;
+            std::shared_ptr<const tuner::frame_plan> plan;
+            tuner::fft_lease fft;
+            // the windowed samples, then their power spectrum
+            std::vector<float> in;
+            std::vector<kiss_fft_cpx> fft_res;
+            std::vector<float> mag_s;
+            std::vector<float> interpolated;
+            std::vector<float> hps;
+        };
+
+        void allocate(resolution &r, int size);
+
+        // returns the detected pitch of the windowed samples in 'r.in' and stores its confidence in 'confidence', or -1
+        // if nothing is left of the spectrum after the hum and band suppression
+        float analyze(resolution &r, float &confidence) noexcept;
+
+        int rate;
+        tuner::multires_config config;
+        tuner::metrics *metrics;
+        int last_size;
+        resolution coarse;
+        resolution fine;
+    };
+}
+
+#endif //TUNER_MULTIRES_H
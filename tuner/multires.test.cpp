@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/multires.hpp>
+#include <tuner/test_signals.hpp>
+
+namespace {
+    constexpr int SAMPLE_RATE = 48000;
+}
+
+TEST_CASE("[multires_engine] invalid configuration") {
+    REQUIRE_THROWS_AS(tuner::multires_engine(0), tuner::InvalidSampleRateException);
+    REQUIRE_THROWS_AS(tuner::multires_engine(SAMPLE_RATE, {1000}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::multires_engine(SAMPLE_RATE, {TUNER_SIZE, 8 * TUNER_SIZE}),
+                      tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::multires_engine(SAMPLE_RATE, {TUNER_SIZE, TUNER_SIZE}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::multires_engine(SAMPLE_RATE, {TUNER_SIZE / 2, TUNER_SIZE, -1}),
+                      tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::multires_engine(SAMPLE_RATE, {TUNER_SIZE / 2, TUNER_SIZE, 200, 1.5f}),
+                      tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::multires_engine(SAMPLE_RATE, {TUNER_SIZE / 2, TUNER_SIZE, 200, 0.5f, -1}),
+                      tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[multires_engine] null history and silence") {
+    tuner::multires_engine e(SAMPLE_RATE);
+    tuner::realtime_note n;
+    REQUIRE(e.process(nullptr, n) == tuner::realtime_status::invalid_input);
+
+    std::vector<float> silence(size_t(e.large_size()), 0.0f);
+    REQUIRE(e.process(silence.data(), n) == tuner::realtime_status::low_energy);
+    REQUIRE(std::string(n.name) == "LOW");
+    REQUIRE(e.last_frame_size() == 0);
+}
+
+TEST_CASE("[multires_engine] high notes are found in the small window alone") {
+    tuner::multires_engine e(SAMPLE_RATE);
+    for (auto [frequency, name]: {std::pair<float, const char *>{293.66f, "D4"}, {329.63f, "E4"}, {440.0f, "A4"},
+                                  {659.26f, "E5"}, {1318.5f, "E6"}}) {
+        std::vector<float> history = tuner::test::harmonic_tone(frequency, SAMPLE_RATE, 2 * TUNER_SIZE);
+        // the older samples are not read, or the NaN would spread into the result
+        std::fill(history.begin(), history.end() - e.small_size(), std::numeric_limits<float>::quiet_NaN());
+
+        tuner::realtime_note n;
+        REQUIRE(e.process(history.data(), n) == tuner::realtime_status::ok);
+        REQUIRE(std::string(n.name) == name);
+        REQUIRE(e.last_frame_size() == e.small_size());
+        REQUIRE(n.confidence > 0.5f);
+    }
+}
+
+TEST_CASE("[multires_engine] low notes escalate to the large window") {
+    tuner::multires_engine e(SAMPLE_RATE);
+    for (auto [frequency, name]: {std::pair<float, const char *>{82.41f, "E2"}, {110.0f, "A2"}, {146.83f, "D3"}}) {
+        std::vector<float> history = tuner::test::harmonic_tone(frequency, SAMPLE_RATE, 2 * TUNER_SIZE);
+        tuner::realtime_note n;
+        REQUIRE(e.process(history.data(), n) == tuner::realtime_status::ok);
+        REQUIRE(std::string(n.name) == name);
+        REQUIRE(e.last_frame_size() == e.large_size());
+    }
+}
+
+TEST_CASE("[multires_engine] the low B of a 7-string below the hum cutoff") {
+    tuner::multires_config config;
+    config.large_size = 4 * TUNER_SIZE;
+    config.hum_cutoff = 50;
+    tuner::multires_engine e(SAMPLE_RATE, config);
+    std::vector<float> history = tuner::test::harmonic_tone(61.74f, SAMPLE_RATE, e.large_size());
+    tuner::realtime_note n;
+    REQUIRE(e.process(history.data(), n) == tuner::realtime_status::ok);
+    REQUIRE(std::string(n.name) == "B1");
+}
+
+TEST_CASE("[multires_engine] noise is not trusted to the small window") {
+    tuner::multires_engine e(SAMPLE_RATE);
+    std::mt19937 rng(5);
+    std::normal_distribution<float> noise(0, 0.1f);
+    std::vector<float> history(size_t(e.large_size()));
+    for (float &s: history) {
+        s = noise(rng);
+    }
+    tuner::realtime_note n;
+    REQUIRE(e.process(history.data(), n) == tuner::realtime_status::ok);
+    REQUIRE(e.last_frame_size() == e.large_size());
+    REQUIRE(n.confidence < 0.5f);
+}
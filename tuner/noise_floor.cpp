@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <limits>
+
+#include <tuner/engine.hpp>
+#include <tuner/noise_floor.hpp>
+
+tuner::noise_floor::noise_floor(int bins, const tuner::noise_floor_config &config)
+        : config(config), frame_count(0), subwindow_frames(0), oldest_subwindow(0) {
+    if (bins <= 0 || !(config.smoothing >= 0 && config.smoothing < 1) || config.subwindows < 1 ||
+        config.subwindows > config.window_frames || !(config.threshold >= 0)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    smoothed.resize(size_t(bins));
+    current_minimum.resize(size_t(bins));
+    window_minimum.resize(size_t(bins));
+    subwindow_minima.resize(size_t(bins) * size_t(config.subwindows));
+    reset();
+}
+
+bool tuner::noise_floor::gate(float *mag_s) noexcept {
+    const int n = bins();
+    const float alpha = config.smoothing;
+    if (frame_count == 0) {
+        // start from the first frame instead of from zero, which would hold the minimum at zero for a whole window
+        for (int k = 0; k < n; k++) {
+            smoothed[k] = mag_s[k] * mag_s[k];
+        }
+    }
+
+    // zeroes nothing while training
+    const float threshold = trained() ? config.threshold : -1;
+    for (int k = 0; k < n; k++) {
+        float power = mag_s[k] * mag_s[k];
+        smoothed[k] = alpha * (smoothed[k] - power) + power;
+        current_minimum[k] = std::min(current_minimum[k], smoothed[k]);
+        float noise = std::min(current_minimum[k], window_minimum[k]);
+        if (power <= threshold * noise) {
+            mag_s[k] = 0;
+        }
+    }
+    bool gated = trained();
+    frame_count++;
+
+    if (++subwindow_frames < config.window_frames / config.subwindows) {
+        return gated;
+    }
+
+    // the subwindow is complete: it replaces the oldest one and the window minimum is rebuilt from all of them
+    float *completed = subwindow_minima.data() + size_t(oldest_subwindow) * size_t(n);
+    std::copy(current_minimum.begin(), current_minimum.end(), completed);
+    oldest_subwindow = (oldest_subwindow + 1) % config.subwindows;
+    subwindow_frames = 0;
+
+    std::fill(window_minimum.begin(), window_minimum.end(), std::numeric_limits<float>::infinity());
+    for (int s = 0; s < config.subwindows; s++) {
+        const float *minima = subwindow_minima.data() + size_t(s) * size_t(n);
+        for (int k = 0; k < n; k++) {
+            window_minimum[k] = std::min(window_minimum[k], minima[k]);
+        }
+    }
+    std::fill(current_minimum.begin(), current_minimum.end(), std::numeric_limits<float>::infinity());
+
+    return gated;
+}
+
+float tuner::noise_floor::noise_power(int bin) const noexcept {
+    float noise = std::min(current_minimum[bin], window_minimum[bin]);
+    return frame_count == 0 ? 0 : noise;
+}
+
+void tuner::noise_floor::reset() noexcept {
+    frame_count = 0;
+    subwindow_frames = 0;
+    oldest_subwindow = 0;
+    std::fill(smoothed.begin(), smoothed.end(), 0.0f);
+    std::fill(current_minimum.begin(), current_minimum.end(), std::numeric_limits<float>::infinity());
+    std::fill(window_minimum.begin(), window_minimum.end(), std::numeric_limits<float>::infinity());
+    std::fill(subwindow_minima.begin(), subwindow_minima.end(), std::numeric_limits<float>::infinity());
+}
@@ -0,0 +1,96 @@
+#ifndef TUNER_NOISE_FLOOR_H
+#define TUNER_NOISE_FLOOR_H
+
+#include <cstdint>
+#include <vector>
+
+namespace tuner {
+
+    struct noise_floor_config {
+        // the weight of the previous smoothed power of a bin, 0 follows every frame and values close to 1 average many
+        float smoothing = 0.85f;
+        // the noise power of a bin is the minimum of its smoothed power over the last 'window_frames' frames, so a note
+        // has to ring longer than this before it is mistaken for noise; 384 frames are 4 s at a hop of 512 at 48 kHz
+        int window_frames = 384;
+        // the window is tracked in this many parts, so a falling minimum is followed at once and a rising one after at
+        // most 'window_frames' + 'window_frames' / 'subwindows' frames
+        int subwindows = 8;
+        // bins whose power is at most 'threshold' times their noise power are zeroed, 4 is 6 dB above the floor
+        float threshold = 4;
+    };
+
+    /**
+     * @brief Tracks the noise power of every bin of a magnitude spectrum across frames with minimum statistics and gates
+     *        the bins that do not rise above it.
+     *
+     * tuner::suppress_below_octave_bands estimates the noise of each octave band from scratch in every frame, so a loud
+     * room raises and lowers the threshold with every note, and steady hum or drone partials inside a band are never
+     * told apart from the note. Here the power of each bin is smoothed exponentially and its
+     * noise power is the minimum of the smoothed power over a sliding window of frames: a note lifts the smoothed power,
+     * but not the minimum, until it has rung for longer than the window. That costs a multiply-add and two comparisons
+     * per bin and frame; the window minimum is rebuilt once per subwindow.
+     *
+     * An instance belongs to one stream. Pass it to tuner::engine::set_noise_floor or
+     * tuner::realtime_engine::set_noise_floor to gate against it instead of the octave bands.
+     */
+    class noise_floor {
+    public:
+        /**
+         * @param bins The number of bins of the magnitude spectra that will be gated, TUNER_SIZE / 2 for the engines.
+         * @param config The smoothing, the window and the gate threshold.
+         *
+         * @throws InvalidConfigurationException If 'bins' is not positive, 'smoothing' is not in [0, 1), 'subwindows' is
+         *                                       not in [1, 'window_frames'] or 'threshold' is negative.
+         */
+        explicit noise_floor(int bins, const tuner::noise_floor_config &config = {});
+
+        /**
+         * @brief Updates the noise power with one frame and zeroes the bins of 'mag_s' at or below the gate threshold.
+         *
+         * @param mag_s The magnitude spectrum of the frame, bins() values. Gated in place.
+         *
+         * @return Whether 'mag_s' was gated. The first window_frames / subwindows frames only train the estimate and
+         *         are left untouched, so the caller can fall back to another noise suppression for them.
+         */
+        bool gate(float *mag_s) noexcept;
+
+        /**
+         * @brief Whether enough frames were seen for gate() to gate.
+         */
+        [[nodiscard]] bool trained() const noexcept { return frame_count >= uint64_t(config.window_frames / config.subwindows); }
+
+        /**
+         * @brief The current noise power estimate of a bin, i.e. a squared magnitude.
+         */
+        [[nodiscard]] float noise_power(int bin) const noexcept;
+
+        [[nodiscard]] int bins() const noexcept { return int(smoothed.size()); }
+
+        /**
+         * @brief The number of frames gated since construction or the last reset().
+         */
+        [[nodiscard]] uint64_t frames() const noexcept { return frame_count; }
+
+        /**
+         * @brief Forgets every frame, e.g. when the input device changes.
+         */
+        void reset() noexcept;
+
+    private:
+        tuner::noise_floor_config config;
+        uint64_t frame_count;
+        // frames in the current subwindow
+        int subwindow_frames;
+        // the next entry of subwindow_minima to overwrite
+        int oldest_subwindow;
+        std::vector<float> smoothed;
+        // the minimum of the current subwindow
+        std::vector<float> current_minimum;
+        // the minimum of the completed subwindows
+        std::vector<float> window_minimum;
+        // 'subwindows' rows of bins() minima
+        std::vector<float> subwindow_minima;
+    };
+}
+
+#endif //TUNER_NOISE_FLOOR_H
@@ -0,0 +1,170 @@
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/noise_floor.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/test_signals.hpp>
+
+namespace {
+    constexpr int BINS = 256;
+
+    // a steady hum partial in bin 40 over random noise in every bin
+    std::vector<float> noisy_frame(std::mt19937 &rng) {
+        std::uniform_real_distribution<float> noise(0.5f, 1.5f);
+        std::vector<float> frame(BINS);
+        for (float &m : frame) {
+            m = noise(rng);
+        }
+        frame[40] = 50;
+        return frame;
+    }
+
+    // 60 Hz mains hum with its harmonics and a steady 233 Hz drone, the loudest partials at the level of the note
+    float hum(int i, int sample_rate) {
+        float t = float(i) / float(sample_rate);
+        float s = 0.1f / 2 * std::sin(2.0f * float(M_PI) * 233.0f * t);
+        for (int h = 1; h <= 6; h++) {
+            s += 0.1f / float(h) * std::sin(2.0f * float(M_PI) * 60.0f * float(h) * t + float(h));
+        }
+        return s;
+    }
+}
+
+TEST_CASE("[noise_floor] invalid configuration") {
+    REQUIRE_THROWS_AS(tuner::noise_floor(0), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::noise_floor(BINS, {1.0f}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::noise_floor(BINS, {0.5f, 16, 0}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::noise_floor(BINS, {0.5f, 16, 17}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::noise_floor(BINS, {0.5f, 16, 4, -1}), tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[noise_floor] the first subwindow only trains") {
+    tuner::noise_floor floor(BINS, {0.8f, 32, 4});
+    std::mt19937 rng(1);
+    for (int frame = 0; frame < 8; frame++) {
+        std::vector<float> m = noisy_frame(rng);
+        std::vector<float> original = m;
+        REQUIRE_FALSE(floor.gate(m.data()));
+        REQUIRE(m == original);
+    }
+    REQUIRE(floor.trained());
+
+    std::vector<float> m = noisy_frame(rng);
+    REQUIRE(floor.gate(m.data()));
+    REQUIRE(floor.frames() == 9);
+}
+
+TEST_CASE("[noise_floor] steady partials are gated and a new note passes") {
+    tuner::noise_floor floor(BINS, {0.8f, 64, 8, 4});
+    std::mt19937 rng(2);
+    for (int frame = 0; frame < 100; frame++) {
+        std::vector<float> m = noisy_frame(rng);
+        floor.gate(m.data());
+    }
+
+    std::vector<float> m = noisy_frame(rng);
+    m[100] = 20;
+    REQUIRE(floor.gate(m.data()));
+    REQUIRE(m[100] == 20);
+    REQUIRE(m[40] == 0);
+    int survivors = 0;
+    for (float value : m) {
+        survivors += value > 0 ? 1 : 0;
+    }
+    REQUIRE(survivors < BINS / 10);
+}
+
+TEST_CASE("[noise_floor] falling levels are followed at once and rising ones after the window") {
+    tuner::noise_floor floor(4, {0.5f, 16, 4});
+    std::vector<float> loud(4, 10.0f);
+    std::vector<float> quiet(4, 1.0f);
+    for (int frame = 0; frame < 32; frame++) {
+        std::vector<float> m = loud;
+        floor.gate(m.data());
+    }
+    REQUIRE(floor.noise_power(0) == 100.0f);
+
+    for (int frame = 0; frame < 8; frame++) {
+        std::vector<float> m = quiet;
+        floor.gate(m.data());
+    }
+    REQUIRE(floor.noise_power(0) < 1.5f);
+
+    // the quiet frames leave the window one subwindow at a time
+    for (int frame = 0; frame < 12; frame++) {
+        std::vector<float> m = loud;
+        floor.gate(m.data());
+    }
+    REQUIRE(floor.noise_power(0) < 1.5f);
+    for (int frame = 0; frame < 8; frame++) {
+        std::vector<float> m = loud;
+        floor.gate(m.data());
+    }
+    REQUIRE(floor.noise_power(0) > 90.0f);
+}
+
+TEST_CASE("[noise_floor] reset forgets every frame") {
+    tuner::noise_floor floor(4, {0.5f, 16, 4});
+    std::vector<float> m(4, 1.0f);
+    for (int frame = 0; frame < 8; frame++) {
+        floor.gate(m.data());
+    }
+    floor.reset();
+    REQUIRE(floor.frames() == 0);
+    REQUIRE_FALSE(floor.trained());
+    REQUIRE(floor.noise_power(0) == 0);
+}
+
+TEST_CASE("[noise_floor] the engines only take TUNER_SIZE / 2 bins") {
+    tuner::noise_floor wrong(BINS);
+    tuner::engine e(48000);
+    REQUIRE_THROWS_AS(e.set_noise_floor(&wrong), tuner::InvalidConfigurationException);
+    tuner::realtime_engine r(48000);
+    REQUIRE_FALSE(r.set_noise_floor(&wrong));
+
+    tuner::noise_floor right(TUNER_SIZE / 2);
+    e.set_noise_floor(&right);
+    REQUIRE(r.set_noise_floor(&right));
+    e.set_noise_floor(nullptr);
+    REQUIRE(r.set_noise_floor(nullptr));
+}
+
+TEST_CASE("[noise_floor] a note is found through steady hum") {
+    constexpr int sample_rate = 48000;
+    constexpr int hop = TUNER_SIZE / 4;
+    // two seconds of hum to learn from, then a note over the hum
+    std::vector<float> samples(size_t(3 * sample_rate));
+    for (int i = 0; i < int(samples.size()); i++) {
+        samples[i] = hum(i, sample_rate);
+        if (i >= 2 * sample_rate) {
+            samples[i] += tuner::test::harmonic_sample(196.0f, sample_rate, i - 2 * sample_rate);
+        }
+    }
+
+    tuner::realtime_engine plain(sample_rate);
+    tuner::realtime_engine gated(sample_rate);
+    tuner::noise_floor floor(TUNER_SIZE / 2);
+    REQUIRE(gated.set_noise_floor(&floor));
+
+    int frames = 0;
+    int plain_found = 0;
+    int gated_found = 0;
+    for (int start = 0; start + TUNER_SIZE <= int(samples.size()); start += hop) {
+        tuner::realtime_note p;
+        tuner::realtime_note g;
+        plain.process(samples.data() + start, p);
+        gated.process(samples.data() + start, g);
+        if (start >= 2 * sample_rate) {
+            frames++;
+            plain_found += std::string(p.name) == "G3" ? 1 : 0;
+            gated_found += std::string(g.name) == "G3" ? 1 : 0;
+        }
+    }
+
+    REQUIRE(gated_found > frames * 3 / 4);
+    REQUIRE(gated_found > plain_found);
+}
@@ -3,10 +3,12 @@
 
 #include <string>
 
+#include <tuner/note_table.hpp>
+
 namespace tuner {
     const float a1_hz = 440;
-    const float c0_hz = 16.3516;
-    const float b8_hz = 7902.13184;
+    const float c0_hz = tuner::note_table<>::frequency(0);
+    const float b8_hz = tuner::note_table<>::frequency(tuner::NOTE_COUNT - 1);
     const std::string notes[12] = {
             "A",
             "A#",
@@ -26,10 +28,13 @@ namespace tuner {
         std::string name;
         float closest_note_frequency;
         float actual_frequency;
+        // how much 'actual_frequency' can be trusted, from 0 (noise) to 1 (a clean harmonic tone), see tuner::engine
+        float confidence;
     };
 
     /**
      * @brief Retrieves the note context for a given pitch value, represented by the float 'pitch', and returns a pointer to the note_context struct.
+     *        The note is looked up in tuner::note_table for A4 = 440 Hz.
      *
      * @param frequency The float value representing the pitch for which the note context is to be retrieved.
      *
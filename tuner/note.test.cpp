@@ -56,4 +56,15 @@ TEST_CASE("[get_note_for_frequency] pitch outside the valid frequency range (abo
     REQUIRE(result != nullptr);
     REQUIRE(result->name == "B8");
     REQUIRE((result->closest_note_frequency - tuner::b8_hz) < 1e-6);
-}
\ No newline at end of file
+}
+TEST_CASE("[get_note_for_frequency] notes below C4 are in the lower octave") {
+    tuner::note_context *b3 = tuner::get_note_for_frequency(246.94);
+    REQUIRE(b3->name == "B3");
+    tuner::note_context *e2 = tuner::get_note_for_frequency(82.41);
+    REQUIRE(e2->name == "E2");
+    tuner::note_context *c4 = tuner::get_note_for_frequency(261.63);
+    REQUIRE(c4->name == "C4");
+    delete b3;
+    delete e2;
+    delete c4;
+}
@@ -0,0 +1,170 @@
+#ifndef TUNER_NOTE_TABLE_HPP
+#define TUNER_NOTE_TABLE_HPP
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string_view>
+
+namespace tuner {
+
+    // C0 to B8
+    constexpr int NOTE_COUNT = 9 * 12;
+    // the index of A4 in a note table
+    constexpr int A4_INDEX = 4 * 12 + 9;
+
+    namespace detail {
+        // 2^(1 / n) by Newton's method, std::pow is not constexpr
+        constexpr double nth_root_of_two(int n) {
+            double x = 1.1;
+            for (int iteration = 0; iteration < 64; iteration++) {
+                double power = 1;
+                for (int i = 0; i < n - 1; i++) {
+                    power *= x;
+                }
+                x -= (power * x - 2) / (n * power);
+            }
+            return x;
+        }
+
+        constexpr double SEMITONE = nth_root_of_two(12);
+        constexpr double QUARTER_TONE = nth_root_of_two(24);
+
+        constexpr std::array<float, NOTE_COUNT> make_note_frequencies(int reference_hz) {
+            std::array<float, NOTE_COUNT> frequencies{};
+            for (int i = 0; i < NOTE_COUNT; i++) {
+                double f = reference_hz;
+                for (int semitones = i - A4_INDEX; semitones > 0; semitones--) {
+                    f *= SEMITONE;
+                }
+                for (int semitones = i - A4_INDEX; semitones < 0; semitones++) {
+                    f /= SEMITONE;
+                }
+                frequencies[i] = float(f);
+            }
+            return frequencies;
+        }
+
+        // a frequency at or above the boundary of a note belongs to the next one, like std::round of the semitones
+        template<int SIZE>
+        constexpr std::array<float, SIZE> make_upper_boundaries(const std::array<float, NOTE_COUNT> &frequencies) {
+            std::array<float, SIZE> boundaries{};
+            for (int i = 0; i < SIZE; i++) {
+                boundaries[i] = i < NOTE_COUNT - 1 ? float(double(frequencies[i]) * QUARTER_TONE)
+                                                   : std::numeric_limits<float>::infinity();
+            }
+            return boundaries;
+        }
+
+        constexpr std::array<std::array<char, 4>, NOTE_COUNT> make_note_name_storage() {
+            constexpr std::array<std::string_view, 12> pitch_classes = {
+                    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+            std::array<std::array<char, 4>, NOTE_COUNT> storage{};
+            for (int i = 0; i < NOTE_COUNT; i++) {
+                std::string_view pitch_class = pitch_classes[i % 12];
+                size_t length = 0;
+                for (char c : pitch_class) {
+                    storage[i][length++] = c;
+                }
+                storage[i][length] = char('0' + i / 12);
+            }
+            return storage;
+        }
+
+        inline constexpr std::array<std::array<char, 4>, NOTE_COUNT> NOTE_NAME_STORAGE = make_note_name_storage();
+
+        constexpr std::array<std::string_view, NOTE_COUNT> make_note_names() {
+            std::array<std::string_view, NOTE_COUNT> names{};
+            for (int i = 0; i < NOTE_COUNT; i++) {
+                names[i] = std::string_view(NOTE_NAME_STORAGE[i].data());
+            }
+            return names;
+        }
+    }
+
+    // "C0", "C#0", ..., "B8"; the views point into static storage
+    inline constexpr std::array<std::string_view, NOTE_COUNT> NOTE_NAMES = detail::make_note_names();
+
+    struct note_match {
+        int index;
+        // e.g. "A#3"
+        std::string_view name;
+        float closest_note_frequency;
+        // the offset of the frequency from the closest note, positive when sharp
+        float cents;
+    };
+
+    /**
+     * @brief The frequencies of the notes C0 to B8 of equal temperament for the reference pitch REFERENCE_HZ of A4,
+     *        computed at compile time.
+     *
+     * Each supported reference is its own table type, e.g. note_table<432> or note_table<442>, so switching references
+     * never rebuilds a table at runtime. match() needs no allocation, no std::log2 or std::pow and no branch on the
+     * note: the note is found by a fixed seven step search over the boundaries halfway (in cents) between notes.
+     */
+    template<int REFERENCE_HZ = 440>
+    class note_table {
+    public:
+        static_assert(REFERENCE_HZ > 0, "the reference pitch must be positive");
+
+        static constexpr float reference_hz = float(REFERENCE_HZ);
+
+        /**
+         * @return The frequency of the note 'index' semitones above C0.
+         */
+        static constexpr float frequency(int index) { return FREQUENCIES[index]; }
+
+        static constexpr std::string_view name(int index) { return NOTE_NAMES[index]; }
+
+        /**
+         * @return The index of the note closest to 'frequency', clamped to C0 and B8. NaN maps to C0.
+         */
+        static constexpr int index_for_frequency(float frequency) noexcept {
+            int index = 0;
+            for (int step = SEARCH_SIZE / 2; step > 0; step /= 2) {
+                index += UPPER_BOUNDARIES[index + step - 1] <= frequency ? step : 0;
+            }
+            return index;
+        }
+
+        /**
+         * @return The closest note to 'frequency' and its offset in cents.
+         */
+        static note_match match(float frequency) noexcept {
+            int index = index_for_frequency(frequency);
+            float closest = FREQUENCIES[index];
+            return {index, NOTE_NAMES[index], closest, cents(frequency, closest)};
+        }
+
+        /**
+         * @return The offset of 'frequency' from 'reference' in cents. Exact to a small fraction of a cent within a
+         *         semitone of 'reference'.
+         */
+        static float cents(float frequency, float reference) noexcept {
+            float ratio = frequency / reference;
+            if (!(ratio > MIN_FAST_RATIO && ratio < MAX_FAST_RATIO)) {
+                // only reached for frequencies clamped to C0 or B8
+                return 1200.0f * std::log2(ratio);
+            }
+
+            // ln(r) = 2 atanh((r - 1) / (r + 1)), and |t| < 0.03 so three terms are plenty
+            float t = (ratio - 1) / (ratio + 1);
+            float t2 = t * t;
+            float ln = 2 * t * (1 + t2 * (1.0f / 3 + t2 * (1.0f / 5)));
+            return ln * CENTS_PER_NEPER;
+        }
+
+    private:
+        // the upper boundaries padded to a power of two
+        static constexpr int SEARCH_SIZE = 128;
+        static constexpr float MIN_FAST_RATIO = float(1 / detail::SEMITONE);
+        static constexpr float MAX_FAST_RATIO = float(detail::SEMITONE);
+        static constexpr float CENTS_PER_NEPER = float(1200 / 0.693147180559945309417);
+
+        static constexpr std::array<float, NOTE_COUNT> FREQUENCIES = detail::make_note_frequencies(REFERENCE_HZ);
+        static constexpr std::array<float, SEARCH_SIZE> UPPER_BOUNDARIES =
+                detail::make_upper_boundaries<SEARCH_SIZE>(FREQUENCIES);
+    };
+}
+
+#endif //TUNER_NOTE_TABLE_HPP
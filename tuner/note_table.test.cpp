@@ -0,0 +1,58 @@
+#include <cmath>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/note_table.hpp>
+
+// the table is built and searched at compile time
+static_assert(tuner::note_table<>::name(0) == "C0");
+static_assert(tuner::note_table<>::name(tuner::NOTE_COUNT - 1) == "B8");
+static_assert(tuner::note_table<>::frequency(tuner::A4_INDEX) == 440.0f);
+static_assert(tuner::note_table<432>::frequency(tuner::A4_INDEX) == 432.0f);
+static_assert(tuner::note_table<>::index_for_frequency(440.0f) == tuner::A4_INDEX);
+
+TEST_CASE("[note_table] names and frequencies of every note") {
+    const std::string pitch_classes[12] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+    for (int i = 0; i < tuner::NOTE_COUNT; i++) {
+        REQUIRE(std::string(tuner::note_table<>::name(i)) == pitch_classes[i % 12] + std::to_string(i / 12));
+        float expected = 440.0f * std::pow(2.0f, float(i - tuner::A4_INDEX) / 12.0f);
+        REQUIRE(std::abs(tuner::note_table<>::frequency(i) - expected) < expected * 1e-5f);
+    }
+}
+
+TEST_CASE("[note_table] the closest note matches rounding the semitones") {
+    for (float frequency = 16.0f; frequency < 8000; frequency *= 1.0013f) {
+        int semitones = int(std::lround(std::log2(double(frequency) / 440.0) * 12));
+        int expected = std::min(std::max(semitones + tuner::A4_INDEX, 0), tuner::NOTE_COUNT - 1);
+        REQUIRE(tuner::note_table<>::index_for_frequency(frequency) == expected);
+    }
+}
+
+TEST_CASE("[note_table] out of range frequencies are clamped") {
+    REQUIRE(tuner::note_table<>::match(1.0f).name == "C0");
+    REQUIRE(tuner::note_table<>::match(0.0f).name == "C0");
+    REQUIRE(tuner::note_table<>::match(std::nanf("")).name == "C0");
+    REQUIRE(tuner::note_table<>::match(20000.0f).name == "B8");
+}
+
+TEST_CASE("[note_table] cents match log2") {
+    for (float frequency = 16.0f; frequency < 8000; frequency *= 1.0037f) {
+        tuner::note_match match = tuner::note_table<>::match(frequency);
+        float expected = 1200.0f * std::log2(frequency / match.closest_note_frequency);
+        REQUIRE(std::abs(match.cents - expected) < 0.01f);
+    }
+}
+
+TEST_CASE("[note_table] alternate reference pitches") {
+    tuner::note_match a432 = tuner::note_table<432>::match(432.5f);
+    REQUIRE(a432.name == "A4");
+    REQUIRE(a432.closest_note_frequency == 432.0f);
+    REQUIRE(std::abs(a432.cents - 2.003f) < 0.01f);
+
+    // 440 Hz is 7.85 cents flat of A4 at A = 442, and 1.27 cents sharp of A#4 at the baroque A = 415
+    REQUIRE(tuner::note_table<442>::match(440.0f).name == "A4");
+    REQUIRE(std::abs(tuner::note_table<442>::match(440.0f).cents + 7.85f) < 0.01f);
+    REQUIRE(tuner::note_table<415>::match(440.0f).name == "A#4");
+    float expected = 1200.0f * std::log2(440.0f / 415.0f) - 100;
+    REQUIRE(std::abs(tuner::note_table<415>::match(440.0f).cents - expected) < 0.01f);
+}
@@ -0,0 +1,46 @@
+#include <algorithm>
+
+#include <tuner/dsp.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/onset.hpp>
+#include <tuner/window_table.hpp>
+
+tuner::onset_detector::onset_detector(const tuner::onset_config &config) : settings(config), rise(0) {
+    if (config.block_size <= 0 || TUNER_SIZE % config.block_size != 0 || config.history < 0 ||
+        config.history >= TUNER_SIZE || !(config.threshold > 1) || !(config.weight >= 0 && config.weight <= 1)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    window_energy.resize(size_t(TUNER_SIZE / config.block_size));
+    const std::array<float, TUNER_SIZE> &window = tuner::HANN_WINDOW<TUNER_SIZE>;
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        window_energy[size_t(i / config.block_size)] += window[i] * window[i];
+    }
+}
+
+bool tuner::onset_detector::detect(const float *windowed) noexcept {
+    const int block_size = settings.block_size;
+    const int blocks = int(window_energy.size());
+    // the first block with 'history' samples before it, and at least one
+    const int first = std::max((settings.history + block_size - 1) / block_size, 1);
+
+    rise = 0;
+    // a rise out of silence is measured against the energy gate
+    float loudest = tuner::SIGNAL_POWER_THRESHOLD;
+    for (int b = 0; b < blocks; b++) {
+        const float *x = windowed + size_t(b) * size_t(block_size);
+        float sum = 0;
+        for (int i = 0; i < block_size; i++) {
+            sum += x[i] * x[i];
+        }
+        // the mean power of the samples before windowing
+        float power = sum / window_energy[b];
+
+        if (b >= first && power >= tuner::SIGNAL_POWER_THRESHOLD) {
+            rise = std::max(rise, power / loudest);
+        }
+        loudest = std::max(loudest, power);
+    }
+
+    return rise >= settings.threshold;
+}
@@ -0,0 +1,73 @@
+#ifndef TUNER_ONSET_H
+#define TUNER_ONSET_H
+
+#include <vector>
+
+#include <tuner/global.hpp>
+
+namespace tuner {
+
+    struct onset_config {
+        // samples averaged into one energy value, a divisor of TUNER_SIZE; 256 samples are 5.3 ms at 48 kHz
+        int block_size = 256;
+        // a block is only compared once this many samples precede it; longer than a period of the lowest note, so the
+        // loudest block before it has caught the loudest part of a steady period. 768 samples cover a low E at 48 kHz
+        int history = 768;
+        // a frame is a transient when the energy of a block is at least 'threshold' times that of the loudest block
+        // before it, 4 is a rise of 6 dB
+        float threshold = 4;
+        // the confidence of transient frames is multiplied by this; 0 skips their analysis and holds the previous note
+        float weight = 0;
+    };
+
+    /**
+     * @brief Flags the frames that hold the attack of a note by the rise of their short time energy.
+     *
+     * A pick attack is broadband, so the HPS peak of a frame that holds it is mostly wrong. The detector splits the
+     * frame into blocks of 'block_size' samples and compares the energy of each block with the loudest block before
+     * it. A ringing or decaying note never rises above its own loudest block, an attack does. That runs on the samples,
+     * before the FFT, and costs one multiply-add per sample, so the engines can skip the transform of the frames it
+     * flags.
+     *
+     * It reads windowed frames, the FFT input of the engines, and undoes the Hanning window by dividing the energy of a
+     * block by the energy of the window over it. Rises in the first 'history' samples are not looked at, the window
+     * hides most of them from the spectrum anyway.
+     *
+     * An instance keeps the rise of the last frame it looked at, so each engine needs its own. Pass it to
+     * tuner::engine::set_onset_detector or tuner::realtime_engine::set_onset_detector.
+     */
+    class onset_detector {
+    public:
+        /**
+         * @param config The block size, the rise threshold and the weight of transient frames.
+         *
+         * @throws InvalidConfigurationException If 'block_size' is not a positive divisor of TUNER_SIZE, 'history' is not
+         *                                       in [0, TUNER_SIZE), 'threshold' is not above 1 or 'weight' is not in
+         *                                       [0, 1].
+         */
+        explicit onset_detector(const tuner::onset_config &config = {});
+
+        /**
+         * @brief Whether a frame holds a transient.
+         *
+         * @param windowed TUNER_SIZE samples multiplied by tuner::HANN_WINDOW<TUNER_SIZE>.
+         */
+        bool detect(const float *windowed) noexcept;
+
+        /**
+         * @brief The largest rise of a block over the loudest block before it in the last detected frame, 0 if the frame
+         *        was silent. Rises out of silence are measured against SIGNAL_POWER_THRESHOLD.
+         */
+        [[nodiscard]] float last_rise() const noexcept { return rise; }
+
+        [[nodiscard]] const tuner::onset_config &config() const noexcept { return settings; }
+
+    private:
+        tuner::onset_config settings;
+        float rise;
+        // the energy of the window over each block
+        std::vector<float> window_energy;
+    };
+}
+
+#endif //TUNER_ONSET_H
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/kernels.hpp>
+#include <tuner/onset.hpp>
+#include <tuner/test_signals.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/window_table.hpp>
+
+namespace {
+    constexpr int SAMPLE_RATE = 48000;
+    constexpr int HOP = TUNER_SIZE / 4;
+
+    // D3 plucked after half a second of silence and G3 plucked a second later over the ringing D3; each pluck starts
+    // with a 5 ms noise burst
+    std::vector<float> two_plucks() {
+        std::mt19937 rng(3);
+        std::normal_distribution<float> noise(0, 1);
+        std::vector<float> samples(size_t(3 * SAMPLE_RATE));
+        for (auto [start, frequency]: {std::pair<int, float>{SAMPLE_RATE / 2, 146.83f}, {3 * SAMPLE_RATE / 2, 196.0f}}) {
+            for (int i = start; i < int(samples.size()); i++) {
+                float t = float(i - start) / float(SAMPLE_RATE);
+                float s = 0;
+                for (int h = 1; h <= 5; h++) {
+                    s += 0.3f / float(h) * std::sin(2.0f * float(M_PI) * frequency * float(h) * t);
+                }
+                samples[i] += s * std::exp(-t);
+            }
+            for (int i = start; i < start + 240; i++) {
+                samples[i] += 0.6f * noise(rng) * std::exp(-float(i - start) / 80.0f);
+            }
+        }
+        return samples;
+    }
+
+    bool holds_attack(int start) {
+        for (int attack: {SAMPLE_RATE / 2, 3 * SAMPLE_RATE / 2}) {
+            if (attack >= start && attack < start + TUNER_SIZE) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool detect(tuner::onset_detector &d, const float *samples) {
+        std::array<float, TUNER_SIZE> windowed{};
+        tuner::apply_window(samples, tuner::HANN_WINDOW<TUNER_SIZE>.data(), windowed.data(), TUNER_SIZE);
+        return d.detect(windowed.data());
+    }
+
+    bool is_played_note(const char *name) {
+        std::string n(name);
+        return n == "LOW" || n == "D3" || n == "G3";
+    }
+}
+
+TEST_CASE("[onset_detector] invalid configuration") {
+    REQUIRE_THROWS_AS(tuner::onset_detector({0}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::onset_detector({300}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::onset_detector({256, -1}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::onset_detector({256, TUNER_SIZE}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::onset_detector({256, 768, 1}), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::onset_detector({256, 768, 4, 1.5f}), tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[onset_detector] steady notes and noise are not transient") {
+    tuner::onset_detector d;
+    std::vector<float> m(TUNER_SIZE);
+    for (float frequency: {82.41f, 110.0f, 329.63f}) {
+        for (int start = 0; start < SAMPLE_RATE; start += HOP) {
+            for (int i = 0; i < TUNER_SIZE; i++) {
+                m[i] = tuner::test::harmonic_sample(frequency, SAMPLE_RATE, start + i);
+            }
+            REQUIRE_FALSE(detect(d, m.data()));
+        }
+    }
+
+    std::mt19937 rng(1);
+    std::normal_distribution<float> noise(0, 0.1f);
+    for (int frame = 0; frame < 50; frame++) {
+        for (float &s: m) {
+            s = noise(rng);
+        }
+        REQUIRE_FALSE(detect(d, m.data()));
+        REQUIRE(d.last_rise() < 2);
+    }
+
+    std::fill(m.begin(), m.end(), 0.0f);
+    REQUIRE_FALSE(detect(d, m.data()));
+    REQUIRE(d.last_rise() == 0);
+}
+
+TEST_CASE("[onset_detector] plucks out of silence and over a ringing note are transient") {
+    std::vector<float> samples = two_plucks();
+    tuner::onset_detector d;
+    int flagged = 0;
+    for (int start = 0; start + TUNER_SIZE <= int(samples.size()); start += HOP) {
+        bool transient = detect(d, samples.data() + start);
+        if (!holds_attack(start)) {
+            REQUIRE_FALSE(transient);
+        }
+        flagged += transient ? 1 : 0;
+    }
+    // each attack is seen by at least two of the four windows that hold it
+    REQUIRE(flagged >= 4);
+}
+
+TEST_CASE("[onset_detector] the realtime engine holds the previous note during an attack") {
+    std::vector<float> samples = two_plucks();
+    tuner::onset_detector d;
+    tuner::realtime_engine plain(SAMPLE_RATE);
+    tuner::realtime_engine held(SAMPLE_RATE);
+    held.set_onset_detector(&d);
+
+    int transients = 0;
+    int plain_wrong = 0;
+    tuner::realtime_note h;
+    for (int start = 0; start + TUNER_SIZE <= int(samples.size()); start += HOP) {
+        tuner::realtime_note p;
+        plain.process(samples.data() + start, p);
+
+        tuner::realtime_note before = h;
+        if (held.process(samples.data() + start, h) == tuner::realtime_status::transient) {
+            transients++;
+            plain_wrong += is_played_note(p.name) ? 0 : 1;
+            REQUIRE(holds_attack(start));
+            REQUIRE(std::string(h.name) == before.name);
+            REQUIRE(h.actual_frequency == before.actual_frequency);
+        } else {
+            REQUIRE(std::string(h.name) == p.name);
+        }
+    }
+    REQUIRE(transients >= 4);
+    // the attack out of silence is broadband enough to move the HPS peak
+    REQUIRE(plain_wrong > 0);
+}
+
+TEST_CASE("[onset_detector] engine skips or down-weights transient frames") {
+    std::vector<float> samples = two_plucks();
+    // a window with the first attack in its middle, and one of the ringing D3 before the second attack
+    int attack = SAMPLE_RATE / 2 - TUNER_SIZE / 2;
+    int ringing = attack + SAMPLE_RATE * 3 / 4;
+    std::array<float, TUNER_SIZE> frame{};
+
+    tuner::onset_detector skip;
+    tuner::engine e(SAMPLE_RATE);
+    e.set_onset_detector(&skip);
+    std::copy(samples.begin() + attack, samples.begin() + attack + TUNER_SIZE, frame.begin());
+    tuner::note_context n = e.process(frame);
+    REQUIRE(n.name == "LOW");
+    REQUIRE(n.confidence == 0);
+
+    std::copy(samples.begin() + ringing, samples.begin() + ringing + TUNER_SIZE, frame.begin());
+    tuner::note_context ringing_note = e.process(frame);
+    REQUIRE(ringing_note.name != "LOW");
+    std::copy(samples.begin() + attack + SAMPLE_RATE, samples.begin() + attack + SAMPLE_RATE + TUNER_SIZE, frame.begin());
+    n = e.process(frame);
+    REQUIRE(n.name == ringing_note.name);
+    REQUIRE(n.actual_frequency == ringing_note.actual_frequency);
+    REQUIRE(n.confidence == 0);
+
+    tuner::onset_config config;
+    config.weight = 0.5f;
+    tuner::onset_detector weigh(config);
+    tuner::engine plain(SAMPLE_RATE);
+    tuner::engine weighted(SAMPLE_RATE);
+    weighted.set_onset_detector(&weigh);
+    tuner::note_context p = plain.process(frame);
+    tuner::note_context w = weighted.process(frame);
+    REQUIRE(w.name == p.name);
+    REQUIRE(w.confidence == p.confidence * 0.5f);
+}
@@ -0,0 +1,42 @@
+#include <new>
+
+#include <tuner/engine.hpp>
+#include <tuner/paired_fft.hpp>
+
+tuner::paired_fft::paired_fft(int n) : n(n), fft_state(nullptr) {
+    if (n <= 0 || n % 2 != 0) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    packed.resize(size_t(n));
+    spectrum.resize(size_t(n));
+    fft_state = kiss_fft_alloc(n, 0, nullptr, nullptr);
+    if (fft_state == nullptr) {
+        throw std::bad_alloc();
+    }
+}
+
+tuner::paired_fft::~paired_fft() {
+    kiss_fft_free(fft_state);
+}
+
+void tuner::paired_fft::transform(const float *a, const float *b, kiss_fft_cpx *spectrum_a,
+                                  kiss_fft_cpx *spectrum_b) noexcept {
+    for (int i = 0; i < n; i++) {
+        packed[i].r = a[i];
+        packed[i].i = b[i];
+    }
+
+    kiss_fft(fft_state, packed.data(), spectrum.data());
+
+    for (int k = 0; k <= n / 2; k++) {
+        // Z[n] wraps around to Z[0]
+        const kiss_fft_cpx &z = spectrum[k];
+        const kiss_fft_cpx &mirror = spectrum[(n - k) % n];
+
+        spectrum_a[k].r = 0.5f * (z.r + mirror.r);
+        spectrum_a[k].i = 0.5f * (z.i - mirror.i);
+        spectrum_b[k].r = 0.5f * (z.i + mirror.i);
+        spectrum_b[k].i = 0.5f * (mirror.r - z.r);
+    }
+}
@@ -0,0 +1,63 @@
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <kiss_fftr.h>
+#include <tuner/engine.hpp>
+#include <tuner/global.hpp>
+#include <tuner/paired_fft.hpp>
+
+TEST_CASE("[paired_fft] invalid size") {
+    REQUIRE_THROWS_AS(tuner::paired_fft(0), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::paired_fft(15), tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[paired_fft] spectra match kiss_fftr") {
+    std::vector<float> a(TUNER_SIZE);
+    std::vector<float> b(TUNER_SIZE);
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        a[i] = 0.7f * std::sin(2.0f * float(M_PI) * 110.0f * float(i) / 48000.0f) + 0.1f;
+        b[i] = 0.3f * std::sin(2.0f * float(M_PI) * 329.63f * float(i) / 48000.0f) +
+               0.2f * std::cos(2.0f * float(M_PI) * 987.0f * float(i) / 48000.0f);
+    }
+
+    tuner::paired_fft pair(TUNER_SIZE);
+    std::vector<kiss_fft_cpx> spectrum_a(TUNER_SIZE / 2 + 1);
+    std::vector<kiss_fft_cpx> spectrum_b(TUNER_SIZE / 2 + 1);
+    pair.transform(a.data(), b.data(), spectrum_a.data(), spectrum_b.data());
+
+    kiss_fftr_cfg cfg = kiss_fftr_alloc(TUNER_SIZE, 0, nullptr, nullptr);
+    std::vector<kiss_fft_cpx> expected_a(TUNER_SIZE / 2 + 1);
+    std::vector<kiss_fft_cpx> expected_b(TUNER_SIZE / 2 + 1);
+    kiss_fftr(cfg, a.data(), expected_a.data());
+    kiss_fftr(cfg, b.data(), expected_b.data());
+    kiss_fftr_free(cfg);
+
+    const float tolerance = 1e-3f;
+    for (int k = 0; k <= TUNER_SIZE / 2; k++) {
+        REQUIRE(std::abs(spectrum_a[k].r - expected_a[k].r) < tolerance);
+        REQUIRE(std::abs(spectrum_a[k].i - expected_a[k].i) < tolerance);
+        REQUIRE(std::abs(spectrum_b[k].r - expected_b[k].r) < tolerance);
+        REQUIRE(std::abs(spectrum_b[k].i - expected_b[k].i) < tolerance);
+    }
+}
+
+TEST_CASE("[paired_fft] one silent signal leaves the other intact") {
+    std::vector<float> a(TUNER_SIZE, 0.0f);
+    std::vector<float> b(TUNER_SIZE);
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        b[i] = std::sin(2.0f * float(M_PI) * 16.0f * float(i) / float(TUNER_SIZE));
+    }
+
+    tuner::paired_fft pair(TUNER_SIZE);
+    std::vector<kiss_fft_cpx> spectrum_a(TUNER_SIZE / 2 + 1);
+    std::vector<kiss_fft_cpx> spectrum_b(TUNER_SIZE / 2 + 1);
+    pair.transform(a.data(), b.data(), spectrum_a.data(), spectrum_b.data());
+
+    for (int k = 0; k <= TUNER_SIZE / 2; k++) {
+        REQUIRE(std::abs(spectrum_a[k].r) < 1e-3f);
+        REQUIRE(std::abs(spectrum_a[k].i) < 1e-3f);
+    }
+    // a sine of 16 cycles lands in bin 16 with magnitude n / 2
+    REQUIRE(std::abs(spectrum_b[16].i + float(TUNER_SIZE) / 2) < 1e-2f);
+}
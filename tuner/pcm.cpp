@@ -0,0 +1,125 @@
+#include <cstring>
+
+#include <tuner/pcm.hpp>
+
+namespace {
+    template<tuner::sample_format F>
+    inline float decode(const uint8_t *p) {
+        if constexpr (F == tuner::sample_format::pcm_s16) {
+            return float(int16_t(uint16_t(p[0] | (p[1] << 8)))) * (1.0f / 32768.0f);
+        } else if constexpr (F == tuner::sample_format::pcm_s24) {
+            // place the 24 bits at the top of an int32 so the shift sign-extends
+            auto v = int32_t(uint32_t(p[0]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 24) >> 8;
+            return float(v) * (1.0f / 8388608.0f);
+        } else if constexpr (F == tuner::sample_format::pcm_s32) {
+            auto v = int32_t(uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24);
+            return float(v) * (1.0f / 2147483648.0f);
+        } else {
+            float v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+
+    // windows the samples returned by 'sample_at' into 'out' and returns their mean power; the squares are summed in
+    // four independent partial sums, as the lanes of tuner::apply_window_and_sum_squares, so the additions do not wait
+    // for each other and the float arithmetic after the decoding can be vectorized
+    template<typename SampleAt>
+    inline float window_and_mean_power(SampleAt sample_at, const float *window, float *out, int n) {
+        float sums[4] = {0, 0, 0, 0};
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            float s[4] = {sample_at(i), sample_at(i + 1), sample_at(i + 2), sample_at(i + 3)};
+            for (int k = 0; k < 4; k++) {
+                sums[k] += s[k] * s[k];
+                out[i + k] = window[i + k] * s[k];
+            }
+        }
+        float power = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+        for (; i < n; i++) {
+            float sample = sample_at(i);
+            power += sample * sample;
+            out[i] = window[i] * sample;
+        }
+
+        return power / float(n);
+    }
+
+    template<tuner::sample_format F>
+    float convert_and_window_as(const uint8_t *frames, int block_align, int channels_to_mix, const float *window,
+                                float *out, int n) {
+        constexpr int bytes = F == tuner::sample_format::pcm_s16 ? 2 : F == tuner::sample_format::pcm_s24 ? 3 : 4;
+
+        if (channels_to_mix == 1) {
+            // the common case gets a loop without the mixing step
+            return window_and_mean_power([frames, block_align](int i) {
+                return decode<F>(frames + size_t(i) * block_align);
+            }, window, out, n);
+        }
+
+        float mix_scale = 1.0f / float(channels_to_mix);
+        return window_and_mean_power([frames, block_align, channels_to_mix, mix_scale](int i) {
+            const uint8_t *p = frames + size_t(i) * block_align;
+            float sample = decode<F>(p);
+            for (int c = 1; c < channels_to_mix; c++) {
+                sample += decode<F>(p + c * bytes);
+            }
+            return sample * mix_scale;
+        }, window, out, n);
+    }
+}
+
+int tuner::bytes_per_sample(tuner::sample_format format) noexcept {
+    switch (format) {
+        case tuner::sample_format::pcm_s16:
+            return 2;
+        case tuner::sample_format::pcm_s24:
+            return 3;
+        case tuner::sample_format::pcm_s32:
+        case tuner::sample_format::float32:
+            return 4;
+    }
+
+    return 0;
+}
+
+bool tuner::is_valid_layout(const tuner::pcm_layout &layout) noexcept {
+    return layout.channels > 0 && layout.channel >= -1 && layout.channel < layout.channels && layout.block_align >= 0 &&
+           (layout.block_align == 0 || layout.block_align >= layout.channels * tuner::bytes_per_sample(layout.format));
+}
+
+float tuner::decode_sample(const uint8_t *sample, tuner::sample_format format) noexcept {
+    switch (format) {
+        case tuner::sample_format::pcm_s16:
+            return decode<tuner::sample_format::pcm_s16>(sample);
+        case tuner::sample_format::pcm_s24:
+            return decode<tuner::sample_format::pcm_s24>(sample);
+        case tuner::sample_format::pcm_s32:
+            return decode<tuner::sample_format::pcm_s32>(sample);
+        case tuner::sample_format::float32:
+            return decode<tuner::sample_format::float32>(sample);
+    }
+
+    return 0;
+}
+
+float tuner::convert_and_window(const uint8_t *frames, const tuner::pcm_layout &layout, const float *window, float *out,
+                                int n) noexcept {
+    int bytes = tuner::bytes_per_sample(layout.format);
+    int block_align = layout.block_align == 0 ? layout.channels * bytes : layout.block_align;
+    int channels_to_mix = layout.channel == -1 ? layout.channels : 1;
+    const uint8_t *first = frames + (layout.channel == -1 ? 0 : size_t(layout.channel) * bytes);
+
+    switch (layout.format) {
+        case tuner::sample_format::pcm_s16:
+            return convert_and_window_as<tuner::sample_format::pcm_s16>(first, block_align, channels_to_mix, window, out, n);
+        case tuner::sample_format::pcm_s24:
+            return convert_and_window_as<tuner::sample_format::pcm_s24>(first, block_align, channels_to_mix, window, out, n);
+        case tuner::sample_format::pcm_s32:
+            return convert_and_window_as<tuner::sample_format::pcm_s32>(first, block_align, channels_to_mix, window, out, n);
+        case tuner::sample_format::float32:
+            return convert_and_window_as<tuner::sample_format::float32>(first, block_align, channels_to_mix, window, out, n);
+    }
+
+    return 0;
+}
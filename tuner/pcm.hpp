@@ -0,0 +1,71 @@
+#ifndef TUNER_PCM_H
+#define TUNER_PCM_H
+
+#include <cstdint>
+#include <exception>
+
+namespace tuner {
+
+    struct InvalidPcmLayoutException : public std::exception {
+        [[nodiscard]] const char* what() const noexcept override {
+            return "Invalid pcm layout exception";
+        }
+    };
+
+    enum class sample_format {
+        pcm_s16,
+        pcm_s24,
+        pcm_s32,
+        float32
+    };
+
+    /**
+     * @brief Describes interleaved little-endian samples, e.g. the buffers of a capture device or the data chunk of a WAV file.
+     */
+    struct pcm_layout {
+        tuner::sample_format format = tuner::sample_format::pcm_s16;
+        // interleaved channels per sample frame
+        int channels = 1;
+        // channel to analyze, -1 averages all channels
+        int channel = 0;
+        // bytes between the starts of two sample frames, 0 for tightly packed frames
+        int block_align = 0;
+    };
+
+    /**
+     * @return The number of bytes one sample of 'format' occupies, e.g. 3 for pcm_s24.
+     */
+    int bytes_per_sample(tuner::sample_format format) noexcept;
+
+    /**
+     * @return Whether 'layout' has at least one channel, selects an existing channel or -1 and its block_align is 0 or
+     *         large enough to hold all channels.
+     */
+    bool is_valid_layout(const tuner::pcm_layout &layout) noexcept;
+
+    /**
+     * @brief Converts one sample stored in the given format into a float in the range [-1, 1).
+     *
+     * @param sample A pointer to the first byte of the little-endian sample.
+     * @param format The format of the sample.
+     *
+     * @return The sample as a float.
+     */
+    float decode_sample(const uint8_t *sample, tuner::sample_format format) noexcept;
+
+    /**
+     * @brief Converts, scales, deinterleaves (or mixes) and windows 'n' sample frames in a single pass.
+     *
+     * @param frames The first byte of the first sample frame.
+     * @param layout The layout of 'frames'. Has to satisfy is_valid_layout.
+     * @param window 'n' window coefficients.
+     * @param out Receives the 'n' windowed samples, e.g. the FFT input of an engine.
+     * @param n The number of sample frames.
+     *
+     * @return The mean power of the converted samples before windowing.
+     */
+    float convert_and_window(const uint8_t *frames, const tuner::pcm_layout &layout, const float *window, float *out,
+                             int n) noexcept;
+}
+
+#endif //TUNER_PCM_H
@@ -0,0 +1,138 @@
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/pcm.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/test_signals.hpp>
+
+TEST_CASE("[decode_sample] 16 bit samples") {
+    uint8_t half[2] = {0x00, 0x40};
+    uint8_t min[2] = {0x00, 0x80};
+    REQUIRE(tuner::decode_sample(half, tuner::sample_format::pcm_s16) == 0.5f);
+    REQUIRE(tuner::decode_sample(min, tuner::sample_format::pcm_s16) == -1.0f);
+}
+
+TEST_CASE("[decode_sample] 24 bit samples") {
+    uint8_t half[3] = {0x00, 0x00, 0x40};
+    uint8_t negative_half[3] = {0x00, 0x00, 0xC0};
+    REQUIRE(tuner::decode_sample(half, tuner::sample_format::pcm_s24) == 0.5f);
+    REQUIRE(tuner::decode_sample(negative_half, tuner::sample_format::pcm_s24) == -0.5f);
+}
+
+TEST_CASE("[decode_sample] 32 bit samples") {
+    uint8_t quarter[4] = {0x00, 0x00, 0x00, 0x20};
+    REQUIRE(tuner::decode_sample(quarter, tuner::sample_format::pcm_s32) == 0.25f);
+}
+
+TEST_CASE("[decode_sample] float samples") {
+    float value = -0.125f;
+    uint8_t bytes[4];
+    std::memcpy(bytes, &value, sizeof(value));
+    REQUIRE(tuner::decode_sample(bytes, tuner::sample_format::float32) == -0.125f);
+}
+
+TEST_CASE("[is_valid_layout] channels, channel and block align") {
+    tuner::pcm_layout layout;
+    layout.channels = 2;
+    layout.channel = 1;
+    REQUIRE(tuner::is_valid_layout(layout));
+
+    layout.channel = -1;
+    REQUIRE(tuner::is_valid_layout(layout));
+
+    layout.channel = 2;
+    REQUIRE_FALSE(tuner::is_valid_layout(layout));
+
+    layout.channel = 0;
+    layout.channels = 0;
+    REQUIRE_FALSE(tuner::is_valid_layout(layout));
+
+    layout.channels = 2;
+    layout.format = tuner::sample_format::pcm_s24;
+    layout.block_align = 5;
+    REQUIRE_FALSE(tuner::is_valid_layout(layout));
+    layout.block_align = 8;
+    REQUIRE(tuner::is_valid_layout(layout));
+}
+
+TEST_CASE("[convert_and_window] selects one channel of interleaved 16 bit samples") {
+    std::vector<int16_t> interleaved = {100, -16384, 200, 8192, 300, 16384};
+    std::array<float, 3> window = {1.0f, 0.5f, 2.0f};
+    std::array<float, 3> out = {};
+
+    tuner::pcm_layout layout;
+    layout.channels = 2;
+    layout.channel = 1;
+    float power = tuner::convert_and_window(reinterpret_cast<const uint8_t *>(interleaved.data()), layout,
+                                            window.data(), out.data(), 3);
+    REQUIRE(out[0] == -0.5f);
+    REQUIRE(out[1] == 0.125f);
+    REQUIRE(out[2] == 1.0f);
+    REQUIRE(power == (0.25f + 0.0625f + 0.25f) / 3);
+}
+
+TEST_CASE("[convert_and_window] averages all channels of packed 24 bit samples") {
+    // two frames of 0.5 / -0.25 and 0.25 / 0.25
+    std::vector<uint8_t> interleaved = {0x00, 0x00, 0x40, 0x00, 0x00, 0xE0,
+                                        0x00, 0x00, 0x20, 0x00, 0x00, 0x20};
+    std::array<float, 2> window = {1.0f, 1.0f};
+    std::array<float, 2> out = {};
+
+    tuner::pcm_layout layout;
+    layout.format = tuner::sample_format::pcm_s24;
+    layout.channels = 2;
+    layout.channel = -1;
+    tuner::convert_and_window(interleaved.data(), layout, window.data(), out.data(), 2);
+    REQUIRE(out[0] == 0.125f);
+    REQUIRE(out[1] == 0.25f);
+}
+
+TEST_CASE("[engine] 16 and 32 bit interleaved input matches float input") {
+    constexpr int sample_rate = 48000;
+    std::array<float, TUNER_SIZE> mono = {};
+    std::vector<int16_t> s16(3 * TUNER_SIZE, 0);
+    std::vector<int32_t> s32(3 * TUNER_SIZE, 0);
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        auto v = int16_t(tuner::test::harmonic_sample(196.0f, sample_rate, i) * 32767.0f);
+        mono[i] = float(v) / 32768.0f;
+        s16[3 * i + 2] = v;
+        s32[3 * i + 2] = int32_t(v) * 65536;
+    }
+
+    tuner::engine e(sample_rate);
+    tuner::note_context expected = e.process(mono);
+    tuner::note_context from_s16 = e.process(s16.data(), 3, 2);
+    tuner::note_context from_s32 = e.process(s32.data(), 3, 2);
+    REQUIRE(from_s16.actual_frequency == expected.actual_frequency);
+    REQUIRE(from_s32.actual_frequency == expected.actual_frequency);
+    REQUIRE(from_s16.name == expected.name);
+
+    REQUIRE(e.process(s16.data(), 3, 0).name == "LOW");
+    REQUIRE_THROWS_AS(e.process(s16.data(), 3, 3), tuner::InvalidPcmLayoutException);
+}
+
+TEST_CASE("[realtime_engine] interleaved pcm input matches the engine") {
+    constexpr int sample_rate = 48000;
+    std::vector<int16_t> s16(2 * TUNER_SIZE, 0);
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        s16[2 * i] = int16_t(tuner::test::harmonic_sample(110.0f, sample_rate, i) * 32767.0f);
+    }
+
+    tuner::pcm_layout layout;
+    layout.channels = 2;
+    tuner::engine reference(sample_rate);
+    tuner::note_context expected = reference.process_pcm(reinterpret_cast<const uint8_t *>(s16.data()), layout);
+
+    tuner::realtime_engine e(sample_rate);
+    tuner::realtime_note n;
+    REQUIRE(e.process_pcm(reinterpret_cast<const uint8_t *>(s16.data()), layout, n) == tuner::realtime_status::ok);
+    REQUIRE(n.actual_frequency == expected.actual_frequency);
+
+    layout.channel = 5;
+    REQUIRE(e.process_pcm(reinterpret_cast<const uint8_t *>(s16.data()), layout, n) ==
+            tuner::realtime_status::invalid_input);
+}
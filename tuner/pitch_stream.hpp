@@ -0,0 +1,130 @@
+#ifndef TUNER_PITCH_STREAM_H
+#define TUNER_PITCH_STREAM_H
+
+#include <tuner/generator.hpp>
+
+#ifdef TUNER_HAS_COROUTINES
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include <tuner/engine.hpp>
+#include <tuner/global.hpp>
+#include <tuner/note_table.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/spsc_ring.hpp>
+
+namespace tuner {
+
+    /**
+     * @brief Fills 'buffer' with up to 'capacity' samples of the stream and returns how many it wrote. Returning 0 ends
+     *        the stream.
+     */
+    using chunk_source = std::function<size_t(float *buffer, size_t capacity)>;
+
+    struct pitch_stream_config {
+        // samples between two analyses of the latest TUNER_SIZE samples
+        int hop_size = TUNER_SIZE / 4;
+        // the most samples requested from the source at once
+        size_t chunk_size = TUNER_SIZE;
+        // a voiced event is yielded when the note changes or the cents move by at least this much
+        float cents_threshold = 5;
+    };
+
+    struct pitch_event {
+        // the name is "LOW" and the frequencies are -1 when the signal energy was too low
+        tuner::realtime_note note;
+        // the offset of the detected frequency from the closest note, positive when sharp
+        float cents = 0;
+        // the confidence of 'note', 0 for "LOW" events
+        float confidence = 0;
+        // the first sample of the analyzed window, counted from the start of the stream
+        uint64_t sample_offset = 0;
+        double timestamp_seconds = 0;
+    };
+
+    /**
+     * @brief Analyzes a stream pulled from 'source' and yields a pitch event whenever the detected pitch changes.
+     *
+     * The source is only read, and the latest TUNER_SIZE samples are only analyzed, while the consumer pulls the next
+     * event, so an idle consumer leaves the stream suspended. Samples travel through a tuner::spsc_ring into a sliding
+     * window that tuner::realtime_engine analyzes every 'hop_size' samples, like tuner::live_tuner does on its worker.
+     *
+     * @param sample_rate The sample rate of the stream.
+     * @param source Called for more samples whenever less than a hop is buffered.
+     * @param config The hop, chunk size and change threshold.
+     *
+     * @throws InvalidSampleRateException If 'sample_rate' is not positive, when the first event is pulled.
+     * @throws InvalidConfigurationException If 'config' is out of range, when the first event is pulled.
+     */
+    inline tuner::generator<tuner::pitch_event>
+    pitch_events(int sample_rate, tuner::chunk_source source, tuner::pitch_stream_config config = {}) {
+        if (sample_rate <= 0) {
+            throw tuner::InvalidSampleRateException();
+        }
+        if (config.hop_size <= 0 || config.hop_size > TUNER_SIZE || config.chunk_size == 0 ||
+            !(config.cents_threshold >= 0)) {
+            throw tuner::InvalidConfigurationException();
+        }
+
+        tuner::realtime_engine e(sample_rate);
+        // a hop that is not complete yet plus one chunk always fit
+        tuner::spsc_ring<float> ring(config.chunk_size + size_t(config.hop_size));
+        std::vector<float> chunk(config.chunk_size);
+        std::vector<float> hop(size_t(config.hop_size));
+        std::array<float, TUNER_SIZE> history{};
+        uint64_t consumed = 0;
+
+        tuner::pitch_event last;
+        bool yielded = false;
+
+        while (true) {
+            while (ring.size() < hop.size()) {
+                size_t count = source(chunk.data(), chunk.size());
+                if (count == 0) {
+                    co_return;
+                }
+                ring.push(chunk.data(), std::min(count, chunk.size()));
+            }
+
+            // slide the window by one hop
+            ring.pop(hop.data(), hop.size());
+            std::move(history.begin() + std::ptrdiff_t(hop.size()), history.end(), history.begin());
+            std::copy(hop.begin(), hop.end(), history.end() - std::ptrdiff_t(hop.size()));
+            consumed += hop.size();
+            if (consumed < TUNER_SIZE) {
+                continue;
+            }
+
+            tuner::pitch_event event;
+            tuner::realtime_status status = e.process(history.data(), event.note);
+            bool voiced = status == tuner::realtime_status::ok;
+            if (voiced) {
+                // a peak in bin 0 has no cents
+                if (event.note.actual_frequency > 0) {
+                    event.cents = tuner::note_table<>::cents(event.note.actual_frequency, event.note.closest_note_frequency);
+                }
+                event.confidence = event.note.confidence;
+            }
+            event.sample_offset = consumed - TUNER_SIZE;
+            event.timestamp_seconds = double(event.sample_offset) / double(sample_rate);
+
+            bool changed = !yielded || std::strcmp(event.note.name, last.note.name) != 0 ||
+                           (voiced && std::abs(event.cents - last.cents) >= config.cents_threshold);
+            if (changed) {
+                last = event;
+                yielded = true;
+                co_yield last;
+            }
+        }
+    }
+}
+
+#endif // TUNER_HAS_COROUTINES
+
+#endif //TUNER_PITCH_STREAM_H
@@ -0,0 +1,106 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/pitch_stream.hpp>
+#include <tuner/test_signals.hpp>
+
+#ifdef TUNER_HAS_COROUTINES
+
+struct tone_source {
+    std::vector<float> samples;
+    size_t position = 0;
+    size_t chunk = 128;
+    int calls = 0;
+
+    size_t operator()(float *buffer, size_t capacity) {
+        calls++;
+        size_t count = std::min({chunk, capacity, samples.size() - position});
+        std::copy(samples.begin() + std::ptrdiff_t(position), samples.begin() + std::ptrdiff_t(position + count), buffer);
+        position += count;
+        return count;
+    }
+};
+
+void append_tone(std::vector<float> &samples, float frequency, int sample_rate, int count) {
+    for (int i = 0; i < count; i++) {
+        samples.push_back(tuner::test::harmonic_sample(frequency, sample_rate, i));
+    }
+}
+
+TEST_CASE("[pitch_events] yields only when the pitch changes") {
+    constexpr int sample_rate = 48000;
+    tone_source source;
+    append_tone(source.samples, 440.0f, sample_rate, sample_rate);
+    append_tone(source.samples, 659.25f, sample_rate, sample_rate);
+
+    std::vector<tuner::pitch_event> events;
+    for (const tuner::pitch_event &event : tuner::pitch_events(sample_rate, std::ref(source))) {
+        events.push_back(event);
+    }
+
+    // the first and last windows hold a single tone
+    REQUIRE(std::string(events.front().note.name) == "A4");
+    REQUIRE(std::string(events.back().note.name) == "E5");
+    REQUIRE(events.front().sample_offset == 0);
+
+    tuner::pitch_stream_config config;
+    for (size_t i = 1; i < events.size(); i++) {
+        REQUIRE(events[i].timestamp_seconds > events[i - 1].timestamp_seconds);
+        bool changed = std::string(events[i].note.name) != events[i - 1].note.name ||
+                       std::abs(events[i].cents - events[i - 1].cents) >= config.cents_threshold;
+        REQUIRE(changed);
+    }
+
+    // every hop of the two seconds was analyzed, but only changes were yielded
+    size_t analyses = (source.samples.size() - TUNER_SIZE) / size_t(config.hop_size) + 1;
+    REQUIRE(events.size() < analyses / 4);
+}
+
+TEST_CASE("[pitch_events] the source is only read while the consumer pulls") {
+    constexpr int sample_rate = 48000;
+    tone_source source;
+    append_tone(source.samples, 110.0f, sample_rate, sample_rate);
+
+    tuner::generator<tuner::pitch_event> events = tuner::pitch_events(sample_rate, std::ref(source));
+    REQUIRE(source.calls == 0);
+
+    auto it = events.begin();
+    REQUIRE(it != events.end());
+    // exactly one window was read to produce the first event
+    REQUIRE(source.position == TUNER_SIZE);
+    int calls = source.calls;
+
+    REQUIRE(source.calls == calls);
+    REQUIRE(std::abs(it->cents) < 50);
+    REQUIRE(it->confidence > 0.5f);
+}
+
+TEST_CASE("[pitch_events] silence is one LOW event") {
+    tone_source source;
+    source.samples.assign(4 * TUNER_SIZE, 0.0f);
+
+    std::vector<tuner::pitch_event> events;
+    for (const tuner::pitch_event &event : tuner::pitch_events(48000, std::ref(source))) {
+        events.push_back(event);
+    }
+
+    REQUIRE(events.size() == 1);
+    REQUIRE(std::string(events[0].note.name) == "LOW");
+    REQUIRE(events[0].confidence == 0);
+}
+
+TEST_CASE("[pitch_events] invalid configuration") {
+    tone_source source;
+    tuner::pitch_stream_config config;
+    config.hop_size = 0;
+
+    tuner::generator<tuner::pitch_event> events = tuner::pitch_events(48000, std::ref(source), config);
+    REQUIRE_THROWS_AS(events.begin(), tuner::InvalidConfigurationException);
+
+    tuner::generator<tuner::pitch_event> no_rate = tuner::pitch_events(0, std::ref(source));
+    REQUIRE_THROWS_AS(no_rate.begin(), tuner::InvalidSampleRateException);
+}
+
+#endif // TUNER_HAS_COROUTINES
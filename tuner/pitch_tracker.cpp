@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <tuner/engine.hpp>
+#include <tuner/pitch_tracker.hpp>
+
+namespace {
+    // the cost of a candidate with a salience of 0, which would otherwise be infinite
+    constexpr float MIN_SALIENCE = 1e-12f;
+
+    float emission_cost(const tuner::pitch_candidate &c) {
+        return -std::log(std::max(c.salience, MIN_SALIENCE));
+    }
+}
+
+tuner::pitch_tracker::pitch_tracker(const tuner::tracker_config &config,
+                                    std::function<void(const tuner::tracked_pitch &)> sink)
+        : settings(config), sink(std::move(sink)), next_frame(0), capacity(0), head(0), size(0), anchor(-1) {
+    if (config.candidates <= 0 || config.lag <= 0 || config.block <= 0 || !(config.octave_jump_penalty >= 0)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    capacity = config.lag + config.block;
+    const size_t k = size_t(config.candidates);
+    counts.resize(size_t(capacity));
+    lattice.resize(size_t(capacity) * k);
+    back.resize(size_t(capacity) * k);
+    costs.resize(k);
+    next_costs.resize(k);
+    path.resize(size_t(capacity));
+}
+
+void tuner::pitch_tracker::push(const tuner::pitch_candidate *candidates, int count) {
+    if (candidates == nullptr || count <= 0) {
+        // nothing connects the frames before and after an unvoiced one
+        decide(size);
+        anchor = -1;
+        tuner::tracked_pitch unvoiced;
+        unvoiced.frame = next_frame++;
+        sink(unvoiced);
+        return;
+    }
+
+    const int slot = (head + size) % capacity;
+    const int n = std::min(count, settings.candidates);
+    counts[slot] = n;
+    std::copy(candidates, candidates + n, lattice.begin() + ptrdiff_t(slot) * settings.candidates);
+    size++;
+    next_frame++;
+    advance(size - 1);
+
+    if (size == capacity) {
+        decide(settings.block);
+    }
+}
+
+void tuner::pitch_tracker::finish() {
+    decide(size);
+    anchor = -1;
+}
+
+float tuner::pitch_tracker::jump_cost(float from, float to) const {
+    return settings.octave_jump_penalty * std::abs(std::log2(to / from));
+}
+
+void tuner::pitch_tracker::advance(int index) {
+    const int k = settings.candidates;
+    const int slot = (head + index) % capacity;
+    const tuner::pitch_candidate *current = lattice.data() + size_t(slot) * k;
+    int *pointers = back.data() + size_t(slot) * k;
+
+    if (index == 0) {
+        // the first undecided frame continues the path decided last, if there is one
+        for (int j = 0; j < counts[slot]; j++) {
+            costs[j] = emission_cost(current[j]) + (anchor > 0 ? jump_cost(anchor, current[j].frequency) : 0);
+            pointers[j] = -1;
+        }
+        return;
+    }
+
+    const int previous_slot = (head + index - 1) % capacity;
+    const tuner::pitch_candidate *previous = lattice.data() + size_t(previous_slot) * k;
+    for (int j = 0; j < counts[slot]; j++) {
+        int best = 0;
+        float best_cost = costs[0] + jump_cost(previous[0].frequency, current[j].frequency);
+        for (int i = 1; i < counts[previous_slot]; i++) {
+            float cost = costs[i] + jump_cost(previous[i].frequency, current[j].frequency);
+            if (cost < best_cost) {
+                best = i;
+                best_cost = cost;
+            }
+        }
+        next_costs[j] = best_cost + emission_cost(current[j]);
+        pointers[j] = best;
+    }
+    std::swap(costs, next_costs);
+}
+
+void tuner::pitch_tracker::decide(int count) {
+    count = std::min(count, size);
+    if (count <= 0) {
+        return;
+    }
+
+    const int k = settings.candidates;
+    const int newest = (head + size - 1) % capacity;
+    int best = 0;
+    for (int j = 1; j < counts[newest]; j++) {
+        if (costs[j] < costs[best]) {
+            best = j;
+        }
+    }
+    path[size - 1] = best;
+    for (int i = size - 1; i > 0; i--) {
+        path[i - 1] = back[size_t((head + i) % capacity) * k + path[i]];
+    }
+
+    const uint64_t first_frame = next_frame - uint64_t(size);
+    for (int i = 0; i < count; i++) {
+        const tuner::pitch_candidate &c = lattice[size_t((head + i) % capacity) * k + path[i]];
+        tuner::tracked_pitch decided;
+        decided.frame = first_frame + uint64_t(i);
+        decided.frequency = c.frequency;
+        decided.salience = c.salience;
+        decided.rank = path[i];
+        sink(decided);
+    }
+    anchor = lattice[size_t((head + count - 1) % capacity) * k + path[count - 1]].frequency;
+
+    head = (head + count) % capacity;
+    size -= count;
+    // the frames left behind now continue from the decided path instead of from any candidate
+    for (int i = 0; i < size; i++) {
+        advance(i);
+    }
+}
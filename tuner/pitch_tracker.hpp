@@ -0,0 +1,113 @@
+#ifndef TUNER_PITCH_TRACKER_H
+#define TUNER_PITCH_TRACKER_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <tuner/dsp.hpp>
+
+namespace tuner {
+
+    struct tracker_config {
+        // the candidates considered per frame, see tuner::engine::set_candidate_count
+        int candidates = 5;
+        // the cost of a pitch jump of one octave between two consecutive frames; a candidate costs the natural logarithm
+        // of its salience, so with the default an octave error has to be e^4 times as salient as the candidate on the
+        // path to get on it and back
+        float octave_jump_penalty = 2;
+        // frames that stay undecided behind the newest one, so a later frame can still change the path through them
+        int lag = 64;
+        // frames decided at once when 'lag' + 'block' frames are undecided
+        int block = 64;
+    };
+
+    struct tracked_pitch {
+        uint64_t frame = 0;
+        // -1 for frames without candidates
+        float frequency = -1;
+        float salience = 0;
+        // the index of the chosen candidate of the frame, 0 for the highest, -1 for frames without candidates
+        int rank = -1;
+    };
+
+    /**
+     * @brief Chooses the most likely pitch track through the HPS candidates of a whole recording with the Viterbi
+     *        algorithm, instead of taking the highest candidate of every frame.
+     *
+     * A path through the candidates costs -ln(salience) for every candidate on it, plus 'octave_jump_penalty' per octave
+     * between the candidates of two consecutive frames, so an isolated octave error of the HPS is not followed when a
+     * slightly less salient candidate continues the track. Frames without candidates, e.g. the "LOW" frames, end a path;
+     * the next voiced frame starts a new one.
+     *
+     * The candidates arrive one frame at a time and only the last 'lag' + 'block' frames are kept. Whenever they are
+     * full, the best path so far is traced back and its oldest 'block' frames are decided. The remaining frames are then
+     * recomputed from the decided one, so the track stays continuous across blocks. Memory is therefore bounded by the
+     * configuration, whatever the length of the recording. The time per frame is linear in the number of frames, with
+     * 'candidates'^2 * (1 + 'lag' / 'block') transitions per frame. A decision is that of the full Viterbi pass whenever
+     * all paths through the newest 'lag' frames have merged before them, which they practically always do for a lag of
+     * a second or so.
+     */
+    class pitch_tracker {
+    public:
+        /**
+         * @param config The number of candidates, the jump penalty and the block sizes.
+         * @param sink Receives one tracked_pitch per frame, in frame order, once the frame is decided.
+         *
+         * @throws InvalidConfigurationException If 'candidates', 'lag' or 'block' is not positive, or
+         *                                       'octave_jump_penalty' is negative.
+         */
+        pitch_tracker(const tuner::tracker_config &config, std::function<void(const tuner::tracked_pitch &)> sink);
+
+        /**
+         * @brief Adds the candidates of the next frame.
+         *
+         * @param candidates The candidates of the frame, highest first, see tuner::hps_candidates. Only the first
+         *                   'candidates' of them are considered.
+         * @param count The number of candidates, 0 for a frame without any.
+         */
+        void push(const tuner::pitch_candidate *candidates, int count);
+
+        /**
+         * @brief Decides every frame that is still undecided. Call once after the last frame.
+         */
+        void finish();
+
+        /**
+         * @brief The number of frames pushed so far.
+         */
+        [[nodiscard]] uint64_t frames() const { return next_frame; }
+
+        [[nodiscard]] const tuner::tracker_config &config() const { return settings; }
+
+    private:
+        // the cost of moving from a pitch to another in consecutive frames
+        [[nodiscard]] float jump_cost(float from, float to) const;
+
+        // computes the costs and back pointers of undecided frame 'index' from those of the frame before it
+        void advance(int index);
+
+        // traces the best path back and decides the oldest 'count' undecided frames
+        void decide(int count);
+
+        tuner::tracker_config settings;
+        std::function<void(const tuner::tracked_pitch &)> sink;
+        uint64_t next_frame;
+        // the undecided frames, a ring of 'lag' + 'block' frames of 'candidates' entries each
+        int capacity;
+        int head;
+        int size;
+        std::vector<int> counts;
+        std::vector<tuner::pitch_candidate> lattice;
+        std::vector<int> back;
+        // the path costs of the newest undecided frame, and scratch space for the next one
+        std::vector<float> costs;
+        std::vector<float> next_costs;
+        // the traced back path, one candidate index per undecided frame
+        std::vector<int> path;
+        // the pitch decided last, which the oldest undecided frame continues from; -1 if it starts a new path
+        float anchor;
+    };
+}
+
+#endif //TUNER_PITCH_TRACKER_H
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/pitch_tracker.hpp>
+
+namespace {
+    using frame_candidates = std::vector<tuner::pitch_candidate>;
+
+    // a frame where the HPS peak is an octave above 'frequency' and the true pitch is a little less salient
+    frame_candidates octave_error(float frequency) {
+        return {{2 * frequency, 1.0f}, {frequency, 0.8f}, {frequency / 2, 0.1f}};
+    }
+
+    frame_candidates clean(float frequency) {
+        return {{frequency, 1.0f}, {2 * frequency, 0.3f}, {frequency / 2, 0.1f}};
+    }
+
+    std::vector<tuner::tracked_pitch> track(const std::vector<frame_candidates> &frames,
+                                            const tuner::tracker_config &config = {}) {
+        std::vector<tuner::tracked_pitch> out;
+        tuner::pitch_tracker tracker(config, [&out](const tuner::tracked_pitch &p) { out.push_back(p); });
+        for (const frame_candidates &f: frames) {
+            tracker.push(f.data(), int(f.size()));
+        }
+        tracker.finish();
+        return out;
+    }
+}
+
+TEST_CASE("[pitch_tracker] invalid configuration") {
+    auto sink = [](const tuner::tracked_pitch &) {};
+    REQUIRE_THROWS_AS(tuner::pitch_tracker({0}, sink), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::pitch_tracker({5, -1}, sink), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::pitch_tracker({5, 2, 0}, sink), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::pitch_tracker({5, 2, 64, 0}, sink), tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[pitch_tracker] isolated octave errors are smoothed out") {
+    std::vector<frame_candidates> frames;
+    for (int i = 0; i < 40; i++) {
+        frames.push_back(i % 7 == 3 ? octave_error(110) : clean(110));
+    }
+
+    std::vector<tuner::tracked_pitch> out = track(frames);
+    REQUIRE(out.size() == frames.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        REQUIRE(out[i].frame == i);
+        REQUIRE(out[i].frequency == 110.0f);
+        REQUIRE(out[i].rank == (i % 7 == 3 ? 1 : 0));
+    }
+
+    // without a penalty the highest candidate wins every frame
+    tuner::tracker_config free;
+    free.octave_jump_penalty = 0;
+    out = track(frames, free);
+    for (size_t i = 0; i < out.size(); i++) {
+        REQUIRE(out[i].rank == 0);
+    }
+}
+
+TEST_CASE("[pitch_tracker] real note changes are kept") {
+    std::vector<frame_candidates> frames;
+    for (int i = 0; i < 20; i++) {
+        frames.push_back(clean(110));
+    }
+    for (int i = 0; i < 20; i++) {
+        frames.push_back(clean(220));
+    }
+    for (int i = 0; i < 20; i++) {
+        frames.push_back(clean(164.81f));
+    }
+
+    std::vector<tuner::tracked_pitch> out = track(frames);
+    REQUIRE(out.size() == frames.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        REQUIRE(out[i].frequency == frames[i][0].frequency);
+    }
+}
+
+TEST_CASE("[pitch_tracker] frames without candidates end a path") {
+    std::vector<frame_candidates> frames = {clean(110), clean(110), {}, octave_error(220), clean(440), clean(440)};
+    std::vector<tuner::tracked_pitch> out = track(frames);
+
+    REQUIRE(out.size() == frames.size());
+    REQUIRE(out[1].frequency == 110.0f);
+    REQUIRE(out[2].frame == 2);
+    REQUIRE(out[2].frequency == -1);
+    REQUIRE(out[2].rank == -1);
+    // the new path does not continue from 110 Hz, so its first frame is free to follow the frames after it
+    REQUIRE(out[3].frequency == 440.0f);
+    REQUIRE(out[3].rank == 0);
+}
+
+TEST_CASE("[pitch_tracker] the block sizes do not change the track") {
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> note(0, 4);
+    std::uniform_real_distribution<float> chance(0, 1);
+    const float pitches[] = {82.41f, 110.0f, 146.83f, 196.0f, 246.94f};
+
+    std::vector<frame_candidates> frames;
+    for (int n = 0; n < 30; n++) {
+        float frequency = pitches[note(rng)];
+        for (int i = 0; i < 25; i++) {
+            float c = chance(rng);
+            frames.push_back(c < 0.2f ? octave_error(frequency) : c < 0.25f ? frame_candidates() : clean(frequency));
+        }
+    }
+
+    // runs of octave errors are a few frames long and all paths merge behind them, so a lag a little longer than that
+    // decides like the whole recording at once
+    tuner::tracker_config whole;
+    whole.lag = int(frames.size());
+    std::vector<tuner::tracked_pitch> expected = track(frames, whole);
+    REQUIRE(expected.size() == frames.size());
+
+    for (int lag: {8, 64}) {
+        for (int block: {1, 5, 64}) {
+            tuner::tracker_config config;
+            config.lag = lag;
+            config.block = block;
+            std::vector<tuner::tracked_pitch> out = track(frames, config);
+            REQUIRE(out.size() == expected.size());
+            for (size_t i = 0; i < out.size(); i++) {
+                REQUIRE(out[i].frame == expected[i].frame);
+                REQUIRE(out[i].rank == expected[i].rank);
+            }
+        }
+    }
+}
+
+TEST_CASE("[pitch_tracker] frames are decided at most lag + block frames late") {
+    tuner::tracker_config config;
+    config.lag = 10;
+    config.block = 4;
+    uint64_t decided = 0;
+    uint64_t latest = 0;
+    tuner::pitch_tracker tracker(config, [&decided](const tuner::tracked_pitch &p) {
+        REQUIRE(p.frame == decided);
+        decided++;
+    });
+
+    frame_candidates f = clean(110);
+    for (int i = 0; i < 1000; i++) {
+        tracker.push(f.data(), int(f.size()));
+        latest = std::max(latest, tracker.frames() - decided);
+    }
+    REQUIRE(latest == uint64_t(config.lag + config.block - 1));
+    REQUIRE(tracker.frames() - decided >= uint64_t(config.lag));
+
+    tracker.finish();
+    REQUIRE(decided == 1000);
+}
@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include <tuner/engine.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/window_table.hpp>
+
+namespace {
+    // the plans live in memory of the global operator new instead of kiss_fft's malloc, so they are counted like every
+    // other allocation a host reports to tuner::count_allocation
+    kiss_fftr_cfg allocate_plan(int frame_size) {
+        size_t bytes = 0;
+        kiss_fftr_alloc(frame_size, 0, nullptr, &bytes);
+        void *memory = ::operator new(bytes, std::nothrow);
+        if (memory == nullptr) {
+            return nullptr;
+        }
+        kiss_fftr_cfg plan = kiss_fftr_alloc(frame_size, 0, memory, &bytes);
+        if (plan == nullptr) {
+            ::operator delete(memory);
+        }
+        return plan;
+    }
+}
+
+// the idle plans of one frame size
+struct tuner::fft_lease::pool {
+    explicit pool(int frame_size) : frame_size(frame_size), allocated(0) {}
+
+    ~pool() {
+        for (kiss_fftr_cfg plan: idle) {
+            ::operator delete(plan);
+        }
+    }
+
+    std::mutex mutex;
+    int frame_size;
+    size_t allocated;
+    // reserved for every plan allocated, so returning a plan never allocates
+    std::vector<kiss_fftr_cfg> idle;
+};
+
+tuner::fft_lease::fft_lease(std::shared_ptr<pool> owner, kiss_fftr_cfg plan, bool allocated) noexcept
+        : owner(std::move(owner)), plan(plan), allocated(allocated) {}
+
+tuner::fft_lease::~fft_lease() {
+    release();
+}
+
+tuner::fft_lease::fft_lease(fft_lease &&other) noexcept
+        : owner(std::move(other.owner)), plan(std::exchange(other.plan, nullptr)),
+          allocated(std::exchange(other.allocated, false)) {}
+
+tuner::fft_lease &tuner::fft_lease::operator=(fft_lease &&other) noexcept {
+    if (this != &other) {
+        release();
+        owner = std::move(other.owner);
+        plan = std::exchange(other.plan, nullptr);
+        allocated = std::exchange(other.allocated, false);
+    }
+    return *this;
+}
+
+void tuner::fft_lease::release() noexcept {
+    if (plan != nullptr) {
+        std::lock_guard<std::mutex> lock(owner->mutex);
+        owner->idle.push_back(plan);
+        plan = nullptr;
+    }
+    owner.reset();
+}
+
+namespace {
+    // the steps of tuner::interpolate_spectrum, with the same float and double arithmetic
+    void build_interpolation_grid(tuner::frame_plan &p) {
+        const int size = p.bins * tuner::NUM_HPS;
+        float step = float(1) / float(tuner::NUM_HPS);
+        float x = 0;
+        for (int k = 0; k < size; k++) {
+            if (k > 0) {
+                x = float(0) + step * float(k);
+            }
+            int low = int(x);
+            if (low >= p.bins - 1) {
+                break;
+            }
+            p.grid_low.push_back(low);
+            p.grid_weight.push_back(static_cast<double>(x - float(low)) / static_cast<double>(float(1)));
+        }
+    }
+}
+
+tuner::plan_cache &tuner::plan_cache::shared() {
+    static tuner::plan_cache cache;
+    return cache;
+}
+
+std::shared_ptr<const tuner::frame_plan> tuner::plan_cache::plan(int sample_rate, int frame_size, float hum_cutoff) {
+    if (sample_rate <= 0) {
+        throw tuner::InvalidSampleRateException();
+    }
+    if (tuner::hann_window(frame_size) == nullptr || !(hum_cutoff >= 0)) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto key = std::make_tuple(sample_rate, frame_size, hum_cutoff);
+    auto found = plans.find(key);
+    if (found != plans.end()) {
+        return found->second;
+    }
+
+    auto p = std::make_shared<tuner::frame_plan>();
+    p->sample_rate = sample_rate;
+    p->frame_size = frame_size;
+    p->hum_cutoff = hum_cutoff;
+    p->delta_frequency = float(sample_rate) / float(frame_size);
+    p->bins = frame_size / 2;
+    p->hum_bins = std::min(int(hum_cutoff / p->delta_frequency), p->bins);
+    p->bands = tuner::octave_band_ranges(p->bins, p->delta_frequency);
+    p->window = tuner::hann_window(frame_size);
+    build_interpolation_grid(*p);
+
+    plans.emplace(key, p);
+    return p;
+}
+
+tuner::fft_lease tuner::plan_cache::lease_fft(int frame_size) {
+    if (frame_size <= 0 || frame_size % 2 != 0) {
+        throw tuner::InvalidConfigurationException();
+    }
+
+    std::shared_ptr<tuner::fft_lease::pool> owner;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &slot = ffts[frame_size];
+        if (!slot) {
+            slot = std::make_shared<tuner::fft_lease::pool>(frame_size);
+        }
+        owner = slot;
+    }
+
+    std::lock_guard<std::mutex> lock(owner->mutex);
+    if (!owner->idle.empty()) {
+        kiss_fftr_cfg plan = owner->idle.back();
+        owner->idle.pop_back();
+        return {owner, plan, false};
+    }
+
+    owner->idle.reserve(owner->allocated + 1);
+    kiss_fftr_cfg plan = allocate_plan(frame_size);
+    if (plan == nullptr) {
+        return {};
+    }
+    owner->allocated++;
+    return {owner, plan, true};
+}
+
+size_t tuner::plan_cache::plan_count() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return plans.size();
+}
+
+size_t tuner::plan_cache::fft_plan_count() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = 0;
+    for (const auto &entry: ffts) {
+        std::lock_guard<std::mutex> pool_lock(entry.second->mutex);
+        count += entry.second->allocated;
+    }
+    return count;
+}
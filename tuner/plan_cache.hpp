@@ -0,0 +1,150 @@
+#ifndef TUNER_PLAN_CACHE_H
+#define TUNER_PLAN_CACHE_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include <kiss_fftr.h>
+
+#include <tuner/dsp.hpp>
+#include <tuner/global.hpp>
+
+namespace tuner {
+
+    /**
+     * @brief Everything about a frame that depends only on its sample rate, its size and the hum cutoff, computed once.
+     *
+     * A plan is immutable after it was built, so any number of engines on any number of threads can read the same one.
+     */
+    struct frame_plan {
+        int sample_rate = 0;
+        int frame_size = 0;
+        float hum_cutoff = 0;
+        // sample_rate / frame_size
+        float delta_frequency = 0;
+        // the number of magnitude bins, frame_size / 2
+        int bins = 0;
+        // the bins below the hum cutoff, which are zeroed
+        int hum_bins = 0;
+        // the non-empty octave bands of tuner::suppress_below_octave_bands
+        std::vector<tuner::bin_range> bands;
+        // the precomputed Hanning window of tuner::hann_window
+        const float *window = nullptr;
+        // the interpolation grid of tuner::interpolate_spectrum: point k lies between bin grid_low[k] and the next one,
+        // weighted grid_weight[k] towards the next one; the points from grid_low.size() on repeat the last bin
+        std::vector<int> grid_low;
+        std::vector<double> grid_weight;
+    };
+
+    /**
+     * @brief A kiss_fftr plan lent out by tuner::plan_cache. The plan is returned to the cache when the lease is
+     *        destroyed, so the next engine of the same frame size does not allocate a new one.
+     *
+     * kiss_fftr plans carry their own scratch buffer, so unlike a tuner::frame_plan a plan is only used by one lease at a
+     * time.
+     */
+    class fft_lease {
+    public:
+        fft_lease() noexcept = default;
+
+        ~fft_lease();
+
+        fft_lease(fft_lease &&other) noexcept;
+
+        fft_lease &operator=(fft_lease &&other) noexcept;
+
+        fft_lease(const fft_lease &) = delete;
+
+        fft_lease &operator=(const fft_lease &) = delete;
+
+        [[nodiscard]] kiss_fftr_cfg get() const noexcept { return plan; }
+
+        /**
+         * @brief Whether the plan was allocated for this lease rather than reused.
+         */
+        [[nodiscard]] bool fresh() const noexcept { return allocated; }
+
+    private:
+        friend class plan_cache;
+
+        struct pool;
+
+        fft_lease(std::shared_ptr<pool> owner, kiss_fftr_cfg plan, bool allocated) noexcept;
+
+        void release() noexcept;
+
+        std::shared_ptr<pool> owner;
+        kiss_fftr_cfg plan = nullptr;
+        bool allocated = false;
+    };
+
+    /**
+     * @brief A thread-safe cache of frame plans keyed by sample rate, frame size and hum cutoff, and of FFT plans keyed by
+     *        frame size.
+     *
+     * tuner::engine, tuner::realtime_engine and tuner::multires_engine take their tables and FFT plans from
+     * plan_cache::shared(), so tuner::tune, which builds an engine for every call, only computes them for the first
+     * frame. Streams at 44.1, 48, 96 and 192 kHz in one process share four frame plans and, as long as their engines do
+     * not run at the same time, a single FFT plan.
+     *
+     * Lookups take a mutex, so they belong in constructors and not on a real-time audio thread.
+     */
+    class plan_cache {
+    public:
+        plan_cache() = default;
+
+        plan_cache(const plan_cache &) = delete;
+
+        plan_cache &operator=(const plan_cache &) = delete;
+
+        /**
+         * @brief The cache of the process.
+         */
+        static plan_cache &shared();
+
+        /**
+         * @brief Looks up the plan of a frame, building it on the first call.
+         *
+         * @param sample_rate The sample rate of the stream.
+         * @param frame_size The number of samples of a frame.
+         * @param hum_cutoff The frequency below which bins are zeroed as mains hum.
+         *
+         * @return The same plan for every call with the same arguments.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         * @throws InvalidConfigurationException If 'frame_size' has no precomputed Hanning window (see tuner::hann_window)
+         *                                       or 'hum_cutoff' is negative.
+         */
+        std::shared_ptr<const tuner::frame_plan> plan(int sample_rate, int frame_size, float hum_cutoff = 62);
+
+        /**
+         * @brief Lends out an FFT plan of a frame size, allocating one only if all plans of that size are lent out.
+         *
+         * @return A lease whose get() is nullptr if kiss_fftr_alloc failed.
+         *
+         * @throws InvalidConfigurationException If 'frame_size' is not a positive even number.
+         */
+        tuner::fft_lease lease_fft(int frame_size);
+
+        /**
+         * @brief The number of frame plans built so far.
+         */
+        [[nodiscard]] size_t plan_count() const;
+
+        /**
+         * @brief The number of FFT plans allocated so far, lent out or not.
+         */
+        [[nodiscard]] size_t fft_plan_count() const;
+
+    private:
+        mutable std::mutex mutex;
+        std::map<std::tuple<int, int, float>, std::shared_ptr<const tuner::frame_plan>> plans;
+        std::map<int, std::shared_ptr<tuner::fft_lease::pool>> ffts;
+    };
+}
+
+#endif //TUNER_PLAN_CACHE_H
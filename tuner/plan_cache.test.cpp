@@ -0,0 +1,166 @@
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/dsp.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/tuner.hpp>
+#include <tuner/window_table.hpp>
+
+namespace {
+    std::vector<float> random_spectrum(int bins) {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> magnitude(0, 1);
+        std::vector<float> mag_s(static_cast<size_t>(bins));
+        for (float &m: mag_s) {
+            m = magnitude(rng);
+        }
+        return mag_s;
+    }
+}
+
+TEST_CASE("[plan_cache] invalid keys") {
+    tuner::plan_cache cache;
+    REQUIRE_THROWS_AS(cache.plan(0, TUNER_SIZE), tuner::InvalidSampleRateException);
+    REQUIRE_THROWS_AS(cache.plan(48000, 1000), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(cache.plan(48000, TUNER_SIZE, -1), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(cache.lease_fft(0), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(cache.lease_fft(1001), tuner::InvalidConfigurationException);
+    REQUIRE(cache.plan_count() == 0);
+}
+
+TEST_CASE("[plan_cache] one plan per sample rate, frame size and hum cutoff") {
+    tuner::plan_cache cache;
+    std::vector<std::shared_ptr<const tuner::frame_plan>> plans;
+    for (int sample_rate: {44100, 48000, 96000, 192000}) {
+        auto p = cache.plan(sample_rate, TUNER_SIZE);
+        REQUIRE(cache.plan(sample_rate, TUNER_SIZE) == p);
+        for (const auto &other: plans) {
+            REQUIRE(other != p);
+        }
+        plans.push_back(p);
+
+        float delta_frequency = tuner::calculate_delta_frequency(sample_rate, TUNER_SIZE);
+        REQUIRE(p->delta_frequency == delta_frequency);
+        REQUIRE(p->bins == TUNER_SIZE / 2);
+        REQUIRE(p->hum_bins == int(62 / delta_frequency));
+        REQUIRE(p->window == tuner::HANN_WINDOW<TUNER_SIZE>.data());
+        std::vector<tuner::bin_range> bands = tuner::octave_band_ranges(TUNER_SIZE / 2, delta_frequency);
+        REQUIRE(p->bands.size() == bands.size());
+        for (size_t i = 0; i < bands.size(); i++) {
+            REQUIRE(p->bands[i].start == bands[i].start);
+            REQUIRE(p->bands[i].end == bands[i].end);
+        }
+    }
+    REQUIRE(cache.plan_count() == 4);
+
+    REQUIRE(cache.plan(48000, 2 * TUNER_SIZE) != cache.plan(48000, TUNER_SIZE));
+    REQUIRE(cache.plan(48000, TUNER_SIZE, 20) != cache.plan(48000, TUNER_SIZE));
+    REQUIRE(cache.plan(48000, TUNER_SIZE, 20)->hum_bins < cache.plan(48000, TUNER_SIZE)->hum_bins);
+    REQUIRE(cache.plan_count() == 6);
+}
+
+TEST_CASE("[plan_cache] the tables of a plan give the same spectra as computing them per frame") {
+    tuner::plan_cache cache;
+    for (int frame_size: {TUNER_SIZE / 2, TUNER_SIZE, 4 * TUNER_SIZE}) {
+        auto p = cache.plan(44100, frame_size);
+        std::vector<float> mag_s = random_spectrum(p->bins);
+
+        std::vector<float> expected(mag_s.size() * size_t(tuner::NUM_HPS));
+        std::vector<float> actual(expected.size());
+        tuner::interpolate_spectrum(mag_s.data(), p->bins, expected.data(), 1);
+        tuner::interpolate_spectrum(mag_s.data(), *p, actual.data(), 1);
+        REQUIRE(actual == expected);
+
+        std::vector<float> suppressed = mag_s;
+        tuner::suppress_below_octave_bands(suppressed.data(), p->bins, p->delta_frequency);
+        tuner::suppress_below_octave_bands(mag_s.data(), p->bands.data(), int(p->bands.size()));
+        REQUIRE(mag_s == suppressed);
+    }
+}
+
+TEST_CASE("[plan_cache] FFT plans are lent out one at a time and reused") {
+    tuner::plan_cache cache;
+    kiss_fftr_cfg first;
+    {
+        tuner::fft_lease a = cache.lease_fft(TUNER_SIZE);
+        REQUIRE(a.get() != nullptr);
+        REQUIRE(a.fresh());
+        first = a.get();
+
+        tuner::fft_lease b = cache.lease_fft(TUNER_SIZE);
+        REQUIRE(b.get() != first);
+        REQUIRE(cache.fft_plan_count() == 2);
+    }
+
+    tuner::fft_lease c = cache.lease_fft(TUNER_SIZE);
+    REQUIRE_FALSE(c.fresh());
+    tuner::fft_lease moved = std::move(c);
+    REQUIRE(c.get() == nullptr);
+    REQUIRE(moved.get() != nullptr);
+    REQUIRE(cache.fft_plan_count() == 2);
+
+    tuner::fft_lease other_size = cache.lease_fft(2 * TUNER_SIZE);
+    REQUIRE(other_size.fresh());
+    REQUIRE(cache.fft_plan_count() == 3);
+}
+
+TEST_CASE("[plan_cache] threads asking for the same key share one plan") {
+    tuner::plan_cache cache;
+    constexpr int THREADS = 8;
+    std::array<std::shared_ptr<const tuner::frame_plan>, THREADS> plans;
+    // Catch2 assertions are not thread-safe, so the threads only record what they saw
+    std::array<bool, THREADS> leased = {};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&cache, &plans, &leased, t]() {
+            leased[t] = true;
+            for (int i = 0; i < 100; i++) {
+                plans[t] = cache.plan(96000, TUNER_SIZE);
+                tuner::fft_lease lease = cache.lease_fft(TUNER_SIZE);
+                leased[t] = leased[t] && lease.get() != nullptr;
+            }
+        });
+    }
+    for (std::thread &t: threads) {
+        t.join();
+    }
+
+    for (bool l: leased) {
+        REQUIRE(l);
+    }
+
+    for (const auto &p: plans) {
+        REQUIRE(p == plans[0]);
+    }
+    REQUIRE(cache.plan_count() == 1);
+    REQUIRE(cache.fft_plan_count() <= size_t(THREADS));
+}
+
+TEST_CASE("[plan_cache] tune builds its plans only once") {
+    std::array<float, TUNER_SIZE> m = {};
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        m[i] = 0.5f * std::sin(2.0f * float(M_PI) * 110.0f * float(i) / 48000.0f);
+    }
+
+    for (int sample_rate: {44100, 48000, 96000, 192000}) {
+        delete tuner::tune(m, sample_rate);
+    }
+    size_t plans = tuner::plan_cache::shared().plan_count();
+    size_t ffts = tuner::plan_cache::shared().fft_plan_count();
+
+    for (int round = 0; round < 3; round++) {
+        for (int sample_rate: {44100, 48000, 96000, 192000}) {
+            delete tuner::tune(m, sample_rate);
+        }
+    }
+    REQUIRE(tuner::plan_cache::shared().plan_count() == plans);
+    REQUIRE(tuner::plan_cache::shared().fft_plan_count() == ffts);
+}
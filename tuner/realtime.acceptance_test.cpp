@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include <tuner/corpus.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/metrics.hpp>
+#include <tuner/realtime.hpp>
+
+// defined in tuner.acceptance_test.cpp
+const tuner::corpus_reader &get_acceptance_corpus();
+
+namespace {
+    std::atomic<bool> ALLOCATIONS_ARMED{false};
+    std::atomic<uint64_t> ALLOCATIONS{0};
+
+    void count_allocation() {
+        if (ALLOCATIONS_ARMED.load(std::memory_order_relaxed)) {
+            ALLOCATIONS.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void *counted_new(size_t size) {
+        count_allocation();
+        // the library does not replace operator new, so the allocations of an instrumented build are counted here
+        tuner::count_allocation();
+        if (void *p = std::malloc(size == 0 ? 1 : size)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+// every allocation of this executable goes through these while ALLOCATIONS_ARMED is set
+void *operator new(size_t size) { return counted_new(size); }
+
+void *operator new[](size_t size) { return counted_new(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+
+#if defined(__GLIBC__)
+// catches C allocations as well, e.g. kiss_fft's, by wrapping glibc's allocator entry points
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size) {
+    count_allocation();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    count_allocation();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, size_t size) {
+    count_allocation();
+    return __libc_realloc(p, size);
+}
+}
+#endif
+
+TEST_CASE("[realtime] process does not allocate over the acceptance corpus") {
+    const tuner::corpus_reader &corpus = get_acceptance_corpus();
+    REQUIRE(corpus.size() > 0);
+
+    tuner::realtime_engine e(corpus.sample_rate());
+    tuner::engine reference(corpus.sample_rate());
+    REQUIRE(e.ready());
+
+    uint64_t frames = 0;
+    uint64_t allocating_frames = 0;
+    uint64_t mismatches = 0;
+    std::array<float, TUNER_SIZE> buffer = {};
+    for (tuner::corpus_frame frame: corpus) {
+        tuner::realtime_note n;
+
+        ALLOCATIONS.store(0, std::memory_order_relaxed);
+        ALLOCATIONS_ARMED.store(true, std::memory_order_relaxed);
+        tuner::realtime_status status = e.process(frame.samples, n);
+        ALLOCATIONS_ARMED.store(false, std::memory_order_relaxed);
+
+        frames++;
+        if (ALLOCATIONS.load(std::memory_order_relaxed) != 0) {
+            allocating_frames++;
+        }
+
+        std::copy(frame.samples, frame.samples + TUNER_SIZE, buffer.begin());
+        tuner::note_context expected = reference.process(buffer);
+        bool gated = status == tuner::realtime_status::low_energy;
+        if (gated != (expected.name == "LOW") || n.actual_frequency != expected.actual_frequency) {
+            mismatches++;
+        }
+    }
+
+    std::cout << "realtime: " << frames << " frames, " << allocating_frames << " allocating, " << mismatches
+              << " differing from tuner::engine" << std::endl;
+    REQUIRE(allocating_frames == 0);
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("[realtime] the allocation hook counts allocations") {
+    ALLOCATIONS.store(0, std::memory_order_relaxed);
+    ALLOCATIONS_ARMED.store(true, std::memory_order_relaxed);
+    auto *v = new std::array<float, 4>();
+    void *p = std::malloc(16);
+    ALLOCATIONS_ARMED.store(false, std::memory_order_relaxed);
+    delete v;
+    std::free(p);
+
+    REQUIRE(ALLOCATIONS.load(std::memory_order_relaxed) >= 2);
+}
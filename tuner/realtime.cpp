@@ -0,0 +1,278 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <tuner/kernels.hpp>
+#include <tuner/noise_floor.hpp>
+#include <tuner/note_table.hpp>
+#include <tuner/onset.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/window_table.hpp>
+
+namespace {
+    void set_name(tuner::realtime_note &out, const char *name) {
+        std::strncpy(out.name, name, sizeof(out.name) - 1);
+        out.name[sizeof(out.name) - 1] = '\0';
+    }
+
+    void set_low(tuner::realtime_note &out) {
+        out = tuner::realtime_note();
+        set_name(out, "LOW");
+    }
+
+    // divides the 'size' values at out[0], out[stride], ... by their euclidean norm, as tuner::interpolate_spec does;
+    // returns false and leaves them at 0 if they are all 0
+    bool normalize(float *out, int size, int stride) noexcept {
+        float sum = 0;
+        for (int k = 0; k < size; k++) {
+            sum += std::pow(std::abs(out[size_t(k) * stride]), float(2));
+        }
+        float norm_val = std::pow(sum, float(1) / float(2));
+        if (norm_val == 0) {
+            return false;
+        }
+        for (int k = 0; k < size; k++) {
+            out[size_t(k) * stride] = out[size_t(k) * stride] / norm_val;
+        }
+        return true;
+    }
+}
+
+tuner::realtime_engine::realtime_engine(int sample_rate, tuner::metrics *metrics) noexcept
+        : rate(sample_rate), metrics(metrics), noise(nullptr), onset(nullptr), plan(), fft(), in(), fft_res(), mag_s(),
+          interpolated(), hps() {
+    if (sample_rate <= 0) {
+        return;
+    }
+
+    try {
+        plan = tuner::plan_cache::shared().plan(sample_rate, TUNER_SIZE);
+        fft = tuner::plan_cache::shared().lease_fft(TUNER_SIZE);
+    } catch (const std::exception &) {
+        // not ready
+        fft = tuner::fft_lease();
+        return;
+    }
+}
+
+tuner::realtime_engine::~realtime_engine() = default;
+
+bool tuner::realtime_engine::set_noise_floor(tuner::noise_floor *noise) noexcept {
+    if (noise != nullptr && noise->bins() != TUNER_SIZE / 2) {
+        return false;
+    }
+    this->noise = noise;
+    return true;
+}
+
+tuner::realtime_status tuner::realtime_engine::process(const float *samples, tuner::realtime_note &out) noexcept {
+    if (!ready()) {
+        return tuner::realtime_status::not_ready;
+    }
+    if (samples == nullptr) {
+        return tuner::realtime_status::invalid_input;
+    }
+    TUNER_METRICS_FRAME(metrics);
+    TUNER_METRICS_ALLOCATIONS(metrics);
+
+    float power;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+        power = tuner::apply_window_and_sum_squares(samples, tuner::HANN_WINDOW<TUNER_SIZE>.data(), in.data(), TUNER_SIZE) / float(TUNER_SIZE);
+    }
+
+    return finish(power, out);
+}
+
+tuner::realtime_status tuner::realtime_engine::process_pcm(const uint8_t *frames, const tuner::pcm_layout &layout,
+                                                           tuner::realtime_note &out) noexcept {
+    if (!ready()) {
+        return tuner::realtime_status::not_ready;
+    }
+    if (frames == nullptr || !tuner::is_valid_layout(layout)) {
+        return tuner::realtime_status::invalid_input;
+    }
+    TUNER_METRICS_FRAME(metrics);
+    TUNER_METRICS_ALLOCATIONS(metrics);
+
+    float power;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::window);
+        power = tuner::convert_and_window(frames, layout, tuner::HANN_WINDOW<TUNER_SIZE>.data(), in.data(), TUNER_SIZE);
+    }
+
+    return finish(power, out);
+}
+
+tuner::realtime_status tuner::realtime_engine::finish(float signal_power, tuner::realtime_note &out) noexcept {
+    if (signal_power < tuner::SIGNAL_POWER_THRESHOLD) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        set_low(out);
+        return tuner::realtime_status::low_energy;
+    }
+
+    float weight = 1;
+    if (onset != nullptr) {
+        bool transient;
+        {
+            TUNER_METRICS_STAGE(metrics, tuner::stage::onset_detection);
+            transient = onset->detect(in.data());
+        }
+        if (transient) {
+            weight = onset->config().weight;
+            if (weight == 0) {
+                return tuner::realtime_status::transient;
+            }
+        }
+    }
+
+    float confidence;
+    float max_frequency = analyze(confidence);
+    if (max_frequency < 0) {
+        TUNER_METRICS_GATED_FRAME(metrics);
+        set_low(out);
+        return tuner::realtime_status::low_energy;
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::note_lookup);
+        tuner::find_note_for_frequency(max_frequency, out);
+    }
+    out.confidence = confidence * weight;
+
+    return tuner::realtime_status::ok;
+}
+
+float tuner::realtime_engine::analyze(float &confidence) noexcept {
+    constexpr int bins = TUNER_SIZE / 2;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::fft);
+        kiss_fftr(fft.get(), in.data(), fft_res.data());
+        tuner::real_magnitude(fft_res.data(), mag_s.data(), bins);
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::band_suppression);
+        tuner::suppress_noise(mag_s.data(), *plan, noise);
+    }
+
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::interpolation);
+        if (!tuner::interpolate_spectrum(mag_s.data(), *plan, interpolated.data(), 1)) {
+            return -1;
+        }
+    }
+
+    int hps_len;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::hps);
+        hps_len = tuner::harmonic_product_spectrum(interpolated.data(), INTERPOLATED_SIZE, hps.data());
+    }
+
+    float max_frequency;
+    {
+        TUNER_METRICS_STAGE(metrics, tuner::stage::peak_pick);
+        int max_index = 0;
+        float tmp_max = 0;
+        for (int i = 0; i < hps_len; i++) {
+            if (hps[i] > tmp_max) {
+                tmp_max = hps[i];
+                max_index = i;
+            }
+        }
+        max_frequency = float(max_index) * plan->delta_frequency / float(tuner::NUM_HPS);
+        // the FFT has consumed the frame, so 'in' receives the power spectrum
+        tuner::power_spectrum(fft_res.data(), in.data(), bins);
+        confidence = tuner::pitch_confidence(hps.data(), hps_len, 1, in.data(), rate, max_frequency);
+    }
+
+    return max_frequency;
+}
+
+void tuner::suppress_noise(float *mag_s, int sample_rate, tuner::noise_floor *noise) noexcept {
+    constexpr int bins = TUNER_SIZE / 2;
+
+    // suppress hums
+    float delta_frequency = float(sample_rate) / float(TUNER_SIZE);
+    for (int i = 0; i < int(62 / delta_frequency) && i < bins; i++) {
+        mag_s[i] = 0;
+    }
+
+    if (noise == nullptr || !noise->gate(mag_s)) {
+        tuner::suppress_below_octave_bands(mag_s, bins, delta_frequency);
+    }
+}
+
+void tuner::suppress_noise(float *mag_s, const tuner::frame_plan &plan, tuner::noise_floor *noise) noexcept {
+    std::fill(mag_s, mag_s + plan.hum_bins, 0.0f);
+
+    if (noise == nullptr || !noise->gate(mag_s)) {
+        tuner::suppress_below_octave_bands(mag_s, plan.bands.data(), int(plan.bands.size()));
+    }
+}
+
+bool tuner::interpolate_spectrum(const float *mag_s, float *out, int stride) noexcept {
+    return tuner::interpolate_spectrum(mag_s, TUNER_SIZE / 2, out, stride);
+}
+
+bool tuner::interpolate_spectrum(const float *mag_s, int bins, float *out, int stride) noexcept {
+    const int size = bins * tuner::NUM_HPS;
+
+    // the steps of tuner::interpolate_spec and tuner::interpolate, with the same float and double arithmetic
+    float step = float(1) / float(tuner::NUM_HPS);
+    float x = 0;
+    for (int k = 0; k < size; k++) {
+        if (k > 0) {
+            x = float(0) + step * float(k);
+        }
+        int low = int(x);
+        if (low >= bins - 1) {
+            out[size_t(k) * stride] = mag_s[bins - 1];
+        } else {
+            const double percent = static_cast<double>(x - float(low)) / static_cast<double>(float(1));
+            out[size_t(k) * stride] = float(mag_s[low] * (1. - percent) + mag_s[low + 1] * percent);
+        }
+    }
+
+    return normalize(out, size, stride);
+}
+
+bool tuner::interpolate_spectrum(const float *mag_s, const tuner::frame_plan &plan, float *out, int stride) noexcept {
+    const int size = plan.bins * tuner::NUM_HPS;
+    const int end = int(plan.grid_low.size());
+    for (int k = 0; k < end; k++) {
+        const int low = plan.grid_low[k];
+        const double percent = plan.grid_weight[k];
+        out[size_t(k) * stride] = float(mag_s[low] * (1. - percent) + mag_s[low + 1] * percent);
+    }
+    for (int k = end; k < size; k++) {
+        out[size_t(k) * stride] = mag_s[plan.bins - 1];
+    }
+
+    return normalize(out, size, stride);
+}
+
+int tuner::harmonic_product_spectrum(const float *interpolated, int size, float *out) noexcept {
+    // the steps of tuner::calculate_hps without the temporary vectors
+    int hps_len = size;
+    for (int j = 0; j < hps_len; j++) {
+        out[j] = interpolated[j] * interpolated[j];
+    }
+    for (int h = 2; h <= tuner::NUM_HPS; h++) {
+        hps_len = size / h;
+        for (int j = 0; j < hps_len; j++) {
+            out[j] = out[j] * interpolated[j * h];
+        }
+    }
+
+    return hps_len;
+}
+
+void tuner::find_note_for_frequency(float frequency, tuner::realtime_note &out) noexcept {
+    tuner::note_match match = tuner::note_table<>::match(frequency);
+
+    std::memcpy(out.name, match.name.data(), match.name.size());
+    out.name[match.name.size()] = '\0';
+    out.closest_note_frequency = match.closest_note_frequency;
+    out.actual_frequency = frequency;
+}
@@ -0,0 +1,187 @@
+#ifndef TUNER_REALTIME_H
+#define TUNER_REALTIME_H
+
+#include <array>
+
+#include <kiss_fftr.h>
+
+#include <tuner/dsp.hpp>
+#include <tuner/global.hpp>
+#include <tuner/metrics.hpp>
+#include <tuner/pcm.hpp>
+#include <tuner/plan_cache.hpp>
+
+namespace tuner {
+
+    class noise_floor;
+
+    class onset_detector;
+
+    // interpolated spectrum bins, see tuner::interpolate_spec
+    constexpr int INTERPOLATED_SIZE = TUNER_SIZE / 2 * 5;
+
+    enum class realtime_status {
+        ok = 0,
+        // the signal energy of the frame is below SIGNAL_POWER_THRESHOLD, or nothing of its spectrum is left after the
+        // noise suppression; the result is the "LOW" note
+        low_energy,
+        // 'samples' was null
+        invalid_input,
+        // the engine could not be set up, e.g. because the sample rate was not positive or the FFT plan could not be allocated
+        not_ready,
+        // the frame holds a pick attack and was not analyzed, see realtime_engine::set_onset_detector
+        transient
+    };
+
+    struct realtime_note {
+        float actual_frequency = -1;
+        float closest_note_frequency = -1;
+        // how much 'actual_frequency' can be trusted, from 0 (noise) to 1 (a clean harmonic tone), 0 when LOW
+        float confidence = 0;
+        // the note name, e.g. "A#2", or "LOW" when the signal energy was too low
+        char name[8] = {};
+    };
+
+    /**
+     * @brief Runs the tuning pipeline of tuner::engine without heap allocations and without exceptions.
+     *
+     * Every buffer, the FFT plan and the Hanning window are allocated by the constructor. After that process() is noexcept,
+     * reports problems through tuner::realtime_status and never touches the allocator, so it can run on a real-time
+     * audio thread. The results match tuner::engine::process.
+     */
+    class realtime_engine {
+    public:
+        /**
+         * @param sample_rate The sample rate of the frames that will be processed. If it is not positive, every
+         *                    call to process() returns realtime_status::not_ready.
+         * @param metrics Optional counters that receive stage timings when built with TUNER_INSTRUMENTATION.
+         */
+        explicit realtime_engine(int sample_rate, tuner::metrics *metrics = nullptr) noexcept;
+
+        ~realtime_engine();
+
+        realtime_engine(const realtime_engine &) = delete;
+
+        realtime_engine &operator=(const realtime_engine &) = delete;
+
+        /**
+         * @brief Performs tuning on TUNER_SIZE samples.
+         *
+         * @param samples The first of TUNER_SIZE samples.
+         * @param out Receives the detected note. Set to the "LOW" note for realtime_status::low_energy, untouched otherwise.
+         *
+         * @return realtime_status::ok if a note was detected.
+         */
+        tuner::realtime_status process(const float *samples, tuner::realtime_note &out) noexcept;
+
+        /**
+         * @brief Performs tuning on TUNER_SIZE interleaved PCM sample frames, converted and windowed in one pass.
+         *
+         * @param frames The first byte of TUNER_SIZE little-endian sample frames laid out as described by 'layout'.
+         * @param layout The sample format, channel count and selected channel.
+         * @param out Receives the detected note, see process().
+         *
+         * @return realtime_status::invalid_input if 'frames' is null or 'layout' does not satisfy tuner::is_valid_layout.
+         */
+        tuner::realtime_status
+        process_pcm(const uint8_t *frames, const tuner::pcm_layout &layout, tuner::realtime_note &out) noexcept;
+
+        [[nodiscard]] bool ready() const noexcept { return fft.get() != nullptr; }
+
+        [[nodiscard]] int sample_rate() const noexcept { return rate; }
+
+        /**
+         * @brief Gates the spectrum of every following frame against an adaptive noise floor, see
+         *        tuner::engine::set_noise_floor.
+         *
+         * @param noise The noise floor of this stream, or nullptr to go back to the octave bands. Not owned.
+         *
+         * @return false, leaving the current noise floor in place, if 'noise' does not have TUNER_SIZE / 2 bins.
+         */
+        bool set_noise_floor(tuner::noise_floor *noise) noexcept;
+
+        /**
+         * @brief Looks for a pick attack in every following frame before it is transformed, see
+         *        tuner::engine::set_onset_detector. Transient frames that are skipped return realtime_status::transient
+         *        and leave 'out' untouched, so it keeps the previous note.
+         *
+         * @param onset The detector of this stream, or nullptr to analyze every frame. Not owned.
+         */
+        void set_onset_detector(tuner::onset_detector *onset) noexcept { this->onset = onset; }
+
+    private:
+        tuner::realtime_status finish(float signal_power, tuner::realtime_note &out) noexcept;
+
+        // returns the detected pitch and stores its tuner::pitch_confidence in 'confidence', or -1 if the spectrum is 0
+        // after the noise suppression
+        float analyze(float &confidence) noexcept;
+
+        int rate;
+        tuner::metrics *metrics;
+        tuner::noise_floor *noise;
+        tuner::onset_detector *onset;
+        std::shared_ptr<const tuner::frame_plan> plan;
+        tuner::fft_lease fft;
+        std::array<float, TUNER_SIZE> in;
+        std::array<kiss_fft_cpx, TUNER_SIZE / 2 + 1> fft_res;
+        std::array<float, TUNER_SIZE / 2> mag_s;
+        std::array<float, INTERPOLATED_SIZE> interpolated;
+        std::array<float, INTERPOLATED_SIZE> hps;
+    };
+
+    /**
+     * @brief Zeroes the hum bins below 62 Hz and the bins below the octave band noise floor of a TUNER_SIZE / 2 bin
+     *        magnitude spectrum in place, as tuner::engine does.
+     *
+     * @param noise If not null, the bins are gated against this adaptive noise floor instead of the octave bands once
+     *              it is trained. Must have TUNER_SIZE / 2 bins.
+     */
+    void suppress_noise(float *mag_s, int sample_rate, tuner::noise_floor *noise = nullptr) noexcept;
+
+    /**
+     * @brief suppress_noise of a magnitude spectrum of plan.bins bins, with the hum bins and the octave bands of 'plan'.
+     */
+    void suppress_noise(float *mag_s, const tuner::frame_plan &plan, tuner::noise_floor *noise = nullptr) noexcept;
+
+    /**
+     * @brief The allocation free counterpart of tuner::interpolate_spec. Writes the INTERPOLATED_SIZE normalized values
+     *        to out[0], out[stride], out[2 * stride], ..., so several spectra can be interleaved bin by bin.
+     *
+     * @param mag_s A TUNER_SIZE / 2 bin magnitude spectrum.
+     *
+     * @return false if every value is 0, e.g. after the noise suppression removed the whole spectrum. The values are
+     *         then left at 0 instead of being divided by a norm of 0.
+     */
+    bool interpolate_spectrum(const float *mag_s, float *out, int stride) noexcept;
+
+    /**
+     * @brief interpolate_spectrum of a magnitude spectrum of any size, e.g. of a frame larger or smaller than TUNER_SIZE.
+     *        Writes NUM_HPS * 'bins' values.
+     */
+    bool interpolate_spectrum(const float *mag_s, int bins, float *out, int stride) noexcept;
+
+    /**
+     * @brief interpolate_spectrum of a magnitude spectrum of plan.bins bins on the interpolation grid of 'plan'.
+     */
+    bool interpolate_spectrum(const float *mag_s, const tuner::frame_plan &plan, float *out, int stride) noexcept;
+
+    /**
+     * @brief The allocation free counterpart of tuner::calculate_hps.
+     *
+     * @param interpolated The interpolated spectrum, 'size' values, see interpolate_spectrum.
+     * @param out Receives the harmonic product spectrum. Must hold 'size' values, the later ones are scratch space.
+     *
+     * @return The number of values of the harmonic product spectrum, 'size' / NUM_HPS.
+     */
+    int harmonic_product_spectrum(const float *interpolated, int size, float *out) noexcept;
+
+    /**
+     * @brief The allocation free counterpart of tuner::get_note_for_frequency.
+     *
+     * @param frequency The detected frequency.
+     * @param out Receives the name, the closest note frequency and 'frequency'.
+     */
+    void find_note_for_frequency(float frequency, tuner::realtime_note &out) noexcept;
+}
+
+#endif //TUNER_REALTIME_H
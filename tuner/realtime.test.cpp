@@ -0,0 +1,78 @@
+#include <array>
+#include <cmath>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/noise_floor.hpp>
+#include <tuner/note.hpp>
+#include <tuner/realtime.hpp>
+#include <tuner/test_signals.hpp>
+
+TEST_CASE("[realtime_engine] sample rate is zero") {
+    tuner::realtime_engine e(0);
+    std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(110.0f, 48000);
+    tuner::realtime_note n;
+    REQUIRE_FALSE(e.ready());
+    REQUIRE(e.process(m.data(), n) == tuner::realtime_status::not_ready);
+}
+
+TEST_CASE("[realtime_engine] samples are null") {
+    tuner::realtime_engine e(48000);
+    tuner::realtime_note n;
+    REQUIRE(e.process(nullptr, n) == tuner::realtime_status::invalid_input);
+}
+
+TEST_CASE("[realtime_engine] signal energy is too low") {
+    tuner::realtime_engine e(48000);
+    std::array<float, TUNER_SIZE> m = {};
+    tuner::realtime_note n;
+    REQUIRE(e.process(m.data(), n) == tuner::realtime_status::low_energy);
+    REQUIRE(std::string(n.name) == "LOW");
+    REQUIRE(n.actual_frequency == -1);
+    REQUIRE(n.closest_note_frequency == -1);
+}
+
+TEST_CASE("[realtime_engine] a frame gated away entirely is low energy") {
+    tuner::realtime_engine e(48000);
+    // a floor that is trained after one frame, so the same loud frame is all noise the second time
+    tuner::noise_floor floor(TUNER_SIZE / 2, {0, 8, 8, 4});
+    REQUIRE(e.set_noise_floor(&floor));
+    std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(110.0f, 48000);
+    tuner::realtime_note n;
+    REQUIRE(e.process(m.data(), n) == tuner::realtime_status::ok);
+
+    REQUIRE(e.process(m.data(), n) == tuner::realtime_status::low_energy);
+    REQUIRE(std::string(n.name) == "LOW");
+    REQUIRE(n.actual_frequency == -1);
+}
+
+TEST_CASE("[realtime_engine] process produces the same result as the engine") {
+    for (int sample_rate: {44100, 48000}) {
+        tuner::engine reference(sample_rate);
+        tuner::realtime_engine e(sample_rate);
+        for (float frequency: {82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f, 440.0f}) {
+            std::array<float, TUNER_SIZE> m = tuner::test::harmonic_frame(frequency, sample_rate);
+            tuner::note_context expected = reference.process(m);
+
+            tuner::realtime_note n;
+            REQUIRE(e.process(m.data(), n) == tuner::realtime_status::ok);
+            REQUIRE(n.actual_frequency == expected.actual_frequency);
+            REQUIRE(n.closest_note_frequency == expected.closest_note_frequency);
+            REQUIRE(std::string(n.name) == expected.name);
+            REQUIRE(std::abs(n.confidence - expected.confidence) < 1e-5f);
+        }
+    }
+}
+
+TEST_CASE("[find_note_for_frequency] matches get_note_for_frequency") {
+    for (float frequency = 1; frequency < 9000; frequency *= 1.01f) {
+        tuner::note_context *expected = tuner::get_note_for_frequency(frequency);
+        tuner::realtime_note n;
+        tuner::find_note_for_frequency(frequency, n);
+        REQUIRE(std::string(n.name) == expected->name);
+        REQUIRE(n.closest_note_frequency == expected->closest_note_frequency);
+        REQUIRE(n.actual_frequency == frequency);
+        delete expected;
+    }
+}
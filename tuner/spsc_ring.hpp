@@ -0,0 +1,94 @@
+#ifndef TUNER_SPSC_RING_H
+#define TUNER_SPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace tuner {
+
+    // keeps the producer and consumer indices on separate cache lines
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief A bounded, lock-free single-producer/single-consumer ring of trivially copyable values.
+     *
+     * The storage is allocated once by the constructor. push() and pop() are wait-free, never allocate and never block,
+     * so the producer can be a real-time audio callback. Exactly one thread may push and exactly one thread may pop.
+     */
+    template<typename T>
+    class spsc_ring {
+    public:
+        /**
+         * @param capacity The minimum number of values the ring holds, rounded up to a power of two.
+         */
+        explicit spsc_ring(size_t capacity) : storage(round_up_to_power_of_two(std::max<size_t>(capacity, 1))),
+                                              mask(storage.size() - 1) {}
+
+        spsc_ring(const spsc_ring &) = delete;
+
+        spsc_ring &operator=(const spsc_ring &) = delete;
+
+        /**
+         * @brief Appends up to 'count' values. Values that do not fit are dropped.
+         *
+         * @return The number of values appended.
+         */
+        size_t push(const T *values, size_t count) noexcept {
+            size_t write = write_index.load(std::memory_order_relaxed);
+            size_t read = read_index.load(std::memory_order_acquire);
+            size_t n = std::min(count, storage.size() - (write - read));
+
+            size_t first = std::min(n, storage.size() - (write & mask));
+            std::copy(values, values + first, storage.begin() + std::ptrdiff_t(write & mask));
+            std::copy(values + first, values + n, storage.begin());
+
+            write_index.store(write + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         * @brief Removes up to 'count' of the oldest values into 'out'.
+         *
+         * @return The number of values removed.
+         */
+        size_t pop(T *out, size_t count) noexcept {
+            size_t read = read_index.load(std::memory_order_relaxed);
+            size_t write = write_index.load(std::memory_order_acquire);
+            size_t n = std::min(count, write - read);
+
+            size_t first = std::min(n, storage.size() - (read & mask));
+            std::copy(storage.begin() + std::ptrdiff_t(read & mask), storage.begin() + std::ptrdiff_t((read & mask) + first), out);
+            std::copy(storage.begin(), storage.begin() + std::ptrdiff_t(n - first), out + first);
+
+            read_index.store(read + n, std::memory_order_release);
+            return n;
+        }
+
+        /**
+         * @brief The number of values that can be popped. Exact on the consumer thread, a lower bound elsewhere.
+         */
+        [[nodiscard]] size_t size() const noexcept {
+            return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] size_t capacity() const noexcept { return storage.size(); }
+
+    private:
+        static size_t round_up_to_power_of_two(size_t n) {
+            size_t p = 1;
+            while (p < n) {
+                p <<= 1;
+            }
+            return p;
+        }
+
+        std::vector<T> storage;
+        size_t mask;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_index{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_index{0};
+    };
+}
+
+#endif //TUNER_SPSC_RING_H
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/spsc_ring.hpp>
+
+TEST_CASE("[spsc_ring] capacity is rounded up to a power of two") {
+    tuner::spsc_ring<float> ring(100);
+    REQUIRE(ring.capacity() == 128);
+}
+
+TEST_CASE("[spsc_ring] values come out in order across the wrap around") {
+    tuner::spsc_ring<int> ring(8);
+    std::vector<int> out(8);
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 10; round++) {
+        std::vector<int> in = {next, next + 1, next + 2, next + 3, next + 4};
+        REQUIRE(ring.push(in.data(), in.size()) == 5);
+        next += 5;
+
+        REQUIRE(ring.pop(out.data(), 5) == 5);
+        for (int i = 0; i < 5; i++) {
+            REQUIRE(out[i] == expected++);
+        }
+    }
+    REQUIRE(ring.size() == 0);
+}
+
+TEST_CASE("[spsc_ring] push drops what does not fit and pop returns what is there") {
+    tuner::spsc_ring<int> ring(4);
+    std::vector<int> in = {1, 2, 3, 4, 5, 6};
+    REQUIRE(ring.push(in.data(), in.size()) == 4);
+    REQUIRE(ring.size() == 4);
+
+    std::vector<int> out(6);
+    REQUIRE(ring.pop(out.data(), 6) == 4);
+    REQUIRE(out[3] == 4);
+    REQUIRE(ring.pop(out.data(), 6) == 0);
+}
+
+TEST_CASE("[spsc_ring] a producer and a consumer thread see every value once") {
+    constexpr int total = 20000;
+    tuner::spsc_ring<int> ring(64);
+
+    std::thread producer([&ring]() {
+        int next = 0;
+        int block[7];
+        while (next < total) {
+            int n = std::min(7, total - next);
+            for (int i = 0; i < n; i++) {
+                block[i] = next + i;
+            }
+            size_t pushed = ring.push(block, size_t(n));
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+            next += int(pushed);
+        }
+    });
+
+    int expected = 0;
+    bool in_order = true;
+    int block[5];
+    while (expected < total) {
+        size_t n = ring.pop(block, 5);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; i++) {
+            in_order = in_order && block[i] == expected++;
+        }
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+}
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#include <tuner/dsp.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/kernels.hpp>
+#include <tuner/strum.hpp>
+#include <tuner/window_table.hpp>
+
+tuner::strum_analyzer::strum_analyzer(int sample_rate, const float *open_strings, int count,
+                                      const tuner::strum_config &config)
+        : rate(sample_rate), config(config), delta_frequency(0), fft(), hanning(nullptr), in(), fft_res(), mag_s() {
+    if (sample_rate <= 0) {
+        throw tuner::InvalidSampleRateException();
+    }
+    hanning = tuner::hann_window(config.frame_size);
+    if (open_strings == nullptr || count <= 0 || hanning == nullptr || config.search_cents < 0 || config.search_cents > 1200 || config.harmonics < 1) {
+        throw tuner::InvalidConfigurationException();
+    }
+    for (int s = 0; s < count; s++) {
+        if (!(open_strings[s] > 0)) {
+            throw tuner::InvalidConfigurationException();
+        }
+    }
+
+    const int n = config.frame_size;
+    delta_frequency = float(sample_rate) / float(n);
+    in.resize(size_t(n));
+    fft_res.resize(size_t(n / 2 + 1));
+    mag_s.resize(size_t(n / 2 + 1));
+
+    cent_ratios.resize(size_t(2 * config.search_cents + 1));
+    for (int c = -config.search_cents; c <= config.search_cents; c++) {
+        cent_ratios[c + config.search_cents] = std::exp2(float(c) / 1200.0f);
+    }
+
+    strings.resize(size_t(count));
+    for (int s = 0; s < count; s++) {
+        strings[s].expected_frequency = open_strings[s];
+    }
+
+    fft = tuner::plan_cache::shared().lease_fft(n);
+    if (fft.get() == nullptr) {
+        throw std::bad_alloc();
+    }
+}
+
+tuner::strum_analyzer::~strum_analyzer() = default;
+
+const std::vector<tuner::string_pitch> &tuner::strum_analyzer::process(const float *samples) noexcept {
+    const int n = config.frame_size;
+    float power = tuner::apply_window_and_sum_squares(samples, hanning, in.data(), n) / float(n);
+    if (power < tuner::SIGNAL_POWER_THRESHOLD) {
+        for (tuner::string_pitch &s : strings) {
+            s.actual_frequency = -1;
+            s.cents = 0;
+            s.score = 0;
+            s.note = tuner::realtime_note();
+            std::strncpy(s.note.name, "LOW", sizeof(s.note.name) - 1);
+        }
+        return strings;
+    }
+
+    // the one transform every string is scored against
+    kiss_fftr(fft.get(), in.data(), fft_res.data());
+    float strongest = 0;
+    for (int k = 0; k <= n / 2; k++) {
+        mag_s[k] = std::sqrt(fft_res[k].r * fft_res[k].r + fft_res[k].i * fft_res[k].i);
+        strongest = std::max(strongest, mag_s[k]);
+    }
+
+    float weight_sum = 0;
+    for (int h = 1; h <= config.harmonics; h++) {
+        weight_sum += 1.0f / float(h);
+    }
+
+    for (tuner::string_pitch &s : strings) {
+        float best_score = -1;
+        float best_frequency = s.expected_frequency;
+        for (float ratio : cent_ratios) {
+            float fundamental = s.expected_frequency * ratio;
+            float score = 0;
+            for (int h = 1; h <= config.harmonics; h++) {
+                score += magnitude_at(fundamental * float(h)) / float(h);
+            }
+            if (score > best_score) {
+                best_score = score;
+                best_frequency = fundamental;
+            }
+        }
+
+        // refinement can only move the pitch within the search range
+        float lowest = s.expected_frequency * cent_ratios.front();
+        float highest = s.expected_frequency * cent_ratios.back();
+        s.actual_frequency = std::clamp(refine(best_frequency), lowest, highest);
+        s.cents = 1200.0f * std::log2(s.actual_frequency / s.expected_frequency);
+        s.score = strongest > 0 ? best_score / weight_sum / strongest : 0;
+        tuner::find_note_for_frequency(s.actual_frequency, s.note);
+        s.note.confidence = s.score;
+    }
+
+    return strings;
+}
+
+float tuner::strum_analyzer::magnitude_at(float frequency) const noexcept {
+    float position = frequency / delta_frequency;
+    int low = int(position);
+    if (low >= config.frame_size / 2) {
+        return 0;
+    }
+
+    float fraction = position - float(low);
+    return mag_s[low] * (1 - fraction) + mag_s[low + 1] * fraction;
+}
+
+float tuner::strum_analyzer::refine(float fundamental) const noexcept {
+    // the comb only resolves whole cents on the bin grid, so each harmonic peak is located by a parabola through the
+    // log magnitudes around it; higher harmonics pin the fundamental down h times more precisely
+    float weighted = 0;
+    float weights = 0;
+    for (int h = 1; h <= config.harmonics; h++) {
+        int k = int(std::lround(fundamental * float(h) / delta_frequency));
+        if (k < 1 || k >= config.frame_size / 2) {
+            break;
+        }
+        if (mag_s[k - 1] > mag_s[k]) {
+            k--;
+        } else if (mag_s[k + 1] > mag_s[k]) {
+            k++;
+        }
+        if (k < 1 || k >= config.frame_size / 2) {
+            continue;
+        }
+
+        float a = std::log(mag_s[k - 1] + 1e-12f);
+        float b = std::log(mag_s[k] + 1e-12f);
+        float c = std::log(mag_s[k + 1] + 1e-12f);
+        float denominator = a - 2 * b + c;
+        float offset = denominator < 0 ? 0.5f * (a - c) / denominator : 0;
+        float peak = (float(k) + offset) * delta_frequency / float(h);
+
+        // a peak more than a bin away belongs to another string
+        if (std::abs(peak - fundamental) * float(h) > delta_frequency) {
+            continue;
+        }
+
+        float weight = mag_s[k] * float(h);
+        weighted += peak * weight;
+        weights += weight;
+    }
+
+    return weights > 0 ? weighted / weights : fundamental;
+}
@@ -0,0 +1,111 @@
+#ifndef TUNER_STRUM_H
+#define TUNER_STRUM_H
+
+#include <array>
+#include <vector>
+
+#include <kiss_fftr.h>
+
+#include <tuner/global.hpp>
+#include <tuner/plan_cache.hpp>
+#include <tuner/realtime.hpp>
+
+namespace tuner {
+
+    // open string frequencies, lowest string first
+    inline constexpr std::array<float, 6> standard_tuning = {82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f};
+    inline constexpr std::array<float, 6> drop_d_tuning = {73.42f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f};
+    inline constexpr std::array<float, 6> half_step_down_tuning = {77.78f, 103.83f, 138.59f, 185.0f, 233.08f, 311.13f};
+    inline constexpr std::array<float, 6> open_g_tuning = {73.42f, 98.0f, 146.83f, 196.0f, 246.94f, 293.66f};
+    inline constexpr std::array<float, 6> dadgad_tuning = {73.42f, 110.0f, 146.83f, 196.0f, 220.0f, 293.66f};
+
+    struct strum_config {
+        // samples per frame, a power of two with a precomputed Hanning window (see tuner::hann_window); the partials of
+        // neighbouring strings are only a few bins apart at TUNER_SIZE
+        int frame_size = 4 * TUNER_SIZE;
+        // how far from its open string frequency each string is searched, in cents
+        int search_cents = 100;
+        // harmonics in each string's comb, the fundamental included
+        int harmonics = 8;
+    };
+
+    struct string_pitch {
+        float expected_frequency = -1;
+        // -1 when the frame was too quiet
+        float actual_frequency = -1;
+        // the offset of 'actual_frequency' from 'expected_frequency', positive when sharp
+        float cents = 0;
+        // the comb score of the detected pitch relative to the strongest bin, 0 when the frame was too quiet; also the
+        // confidence of 'note'
+        float score = 0;
+        tuner::realtime_note note;
+    };
+
+    /**
+     * @brief Detects the pitch of every string of a strummed chord from one frame.
+     *
+     * One FFT gives the magnitude spectrum of the frame. Each string then scores a harmonic comb (the fundamental and
+     * its overtones weighted by 1 / h) at one cent steps around its open string frequency, and the best comb is refined
+     * by parabolic interpolation of its harmonic peaks. Scoring a string costs a few thousand spectrum lookups, so a
+     * strum is checked for a fraction of the cost of one tuner::engine analysis per string.
+     *
+     * Everything is allocated by the constructor; process() is noexcept and allocation free.
+     */
+    class strum_analyzer {
+    public:
+        /**
+         * @param sample_rate The sample rate of the frames that will be processed.
+         * @param open_strings The open string frequencies of the tuning, e.g. tuner::standard_tuning.data(). Copied.
+         * @param count The number of open strings.
+         * @param config The search range and comb size.
+         *
+         * @throws InvalidSampleRateException If 'sample_rate' is not positive.
+         * @throws InvalidConfigurationException If there are no open strings or one is not positive, or 'config' is out
+         *                                       of range, e.g. a frame size without a precomputed Hanning window.
+         * @throws std::bad_alloc If the FFT plan cannot be allocated.
+         */
+        strum_analyzer(int sample_rate, const float *open_strings, int count,
+                       const tuner::strum_config &config = tuner::strum_config());
+
+        ~strum_analyzer();
+
+        strum_analyzer(const strum_analyzer &) = delete;
+
+        strum_analyzer &operator=(const strum_analyzer &) = delete;
+
+        /**
+         * @brief Detects the pitch of every string in one frame.
+         *
+         * @param samples The first of frame_size() samples.
+         *
+         * @return One pitch per open string, in the order of the tuning. Every string is named "LOW" when the signal
+         *         energy of the frame is too low.
+         */
+        const std::vector<tuner::string_pitch> &process(const float *samples) noexcept;
+
+        [[nodiscard]] int sample_rate() const noexcept { return rate; }
+
+        [[nodiscard]] int frame_size() const noexcept { return config.frame_size; }
+
+    private:
+        float magnitude_at(float frequency) const noexcept;
+
+        float refine(float fundamental) const noexcept;
+
+        int rate;
+        tuner::strum_config config;
+        float delta_frequency;
+        // lent by tuner::plan_cache
+        tuner::fft_lease fft;
+        // the tuner::hann_window table of the frame size
+        const float *hanning;
+        std::vector<float> in;
+        std::vector<kiss_fft_cpx> fft_res;
+        std::vector<float> mag_s;
+        // 2^(c / 1200) for c in [-search_cents, search_cents]
+        std::vector<float> cent_ratios;
+        std::vector<tuner::string_pitch> strings;
+    };
+}
+
+#endif //TUNER_STRUM_H
@@ -0,0 +1,100 @@
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/strum.hpp>
+
+std::vector<float> strum_frame(const std::array<float, 6> &frequencies, int sample_rate, int frame_size) {
+    std::vector<float> samples(size_t(frame_size), 0.0f);
+    for (size_t s = 0; s < frequencies.size(); s++) {
+        for (int h = 1; h <= 6; h++) {
+            // a different phase per string so the partials do not line up
+            float phase = float(s) * 0.9f + float(h) * 0.4f;
+            for (int i = 0; i < frame_size; i++) {
+                samples[i] += 0.1f / float(h) *
+                              std::sin(2.0f * float(M_PI) * frequencies[s] * float(h) * float(i) / float(sample_rate) + phase);
+            }
+        }
+    }
+
+    return samples;
+}
+
+TEST_CASE("[strum_analyzer] invalid configuration") {
+    const float *standard = tuner::standard_tuning.data();
+    REQUIRE_THROWS_AS(tuner::strum_analyzer(0, standard, 6), tuner::InvalidSampleRateException);
+    REQUIRE_THROWS_AS(tuner::strum_analyzer(48000, standard, 0), tuner::InvalidConfigurationException);
+    REQUIRE_THROWS_AS(tuner::strum_analyzer(48000, nullptr, 6), tuner::InvalidConfigurationException);
+    const float negative[] = {82.41f, -1.0f};
+    REQUIRE_THROWS_AS(tuner::strum_analyzer(48000, negative, 2), tuner::InvalidConfigurationException);
+
+    tuner::strum_config config;
+    config.harmonics = 0;
+    REQUIRE_THROWS_AS(tuner::strum_analyzer(48000, standard, 6, config), tuner::InvalidConfigurationException);
+
+    config = tuner::strum_config();
+    config.frame_size = 3000;
+    REQUIRE_THROWS_AS(tuner::strum_analyzer(48000, standard, 6, config), tuner::InvalidConfigurationException);
+    // a power of two without a precomputed window
+    config.frame_size = 16 * TUNER_SIZE;
+    REQUIRE_THROWS_AS(tuner::strum_analyzer(48000, standard, 6, config), tuner::InvalidConfigurationException);
+}
+
+TEST_CASE("[strum_analyzer] an in tune strum") {
+    constexpr int sample_rate = 48000;
+    std::vector<float> samples = strum_frame(tuner::standard_tuning, sample_rate, tuner::strum_config().frame_size);
+
+    tuner::strum_analyzer analyzer(sample_rate, tuner::standard_tuning.data(), int(tuner::standard_tuning.size()));
+    const std::vector<tuner::string_pitch> &strings = analyzer.process(samples.data());
+
+    REQUIRE(strings.size() == 6);
+    const std::vector<std::string> names = {"E2", "A2", "D3", "G3", "B3", "E4"};
+    for (size_t s = 0; s < strings.size(); s++) {
+        REQUIRE(strings[s].expected_frequency == tuner::standard_tuning[s]);
+        REQUIRE(std::abs(strings[s].cents) < 8);
+        REQUIRE(strings[s].score > 0);
+        REQUIRE(std::abs(strings[s].note.closest_note_frequency - tuner::standard_tuning[s]) < 1);
+    }
+}
+
+TEST_CASE("[strum_analyzer] finds the out of tune strings") {
+    constexpr int sample_rate = 44100;
+    std::vector<float> cents = {0, -35, 0, 20, 0, 45};
+    std::array<float, 6> played = {};
+    for (size_t s = 0; s < played.size(); s++) {
+        played[s] = tuner::standard_tuning[s] * std::exp2(cents[s] / 1200.0f);
+    }
+    std::vector<float> samples = strum_frame(played, sample_rate, tuner::strum_config().frame_size);
+
+    tuner::strum_analyzer analyzer(sample_rate, tuner::standard_tuning.data(), int(tuner::standard_tuning.size()));
+    const std::vector<tuner::string_pitch> &strings = analyzer.process(samples.data());
+
+    for (size_t s = 0; s < strings.size(); s++) {
+        REQUIRE(std::abs(strings[s].cents - cents[s]) < 8);
+    }
+}
+
+TEST_CASE("[strum_analyzer] alternate tunings") {
+    constexpr int sample_rate = 48000;
+    std::vector<float> samples = strum_frame(tuner::drop_d_tuning, sample_rate, tuner::strum_config().frame_size);
+
+    tuner::strum_analyzer analyzer(sample_rate, tuner::drop_d_tuning.data(), int(tuner::drop_d_tuning.size()));
+    const std::vector<tuner::string_pitch> &strings = analyzer.process(samples.data());
+
+    REQUIRE(std::abs(strings[0].actual_frequency - 73.42f) < 0.5f);
+    REQUIRE(std::abs(strings[0].cents) < 8);
+}
+
+TEST_CASE("[strum_analyzer] silence is LOW") {
+    tuner::strum_analyzer analyzer(48000, tuner::standard_tuning.data(), int(tuner::standard_tuning.size()));
+    std::vector<float> samples(size_t(analyzer.frame_size()), 0.0f);
+    const std::vector<tuner::string_pitch> &strings = analyzer.process(samples.data());
+
+    for (const tuner::string_pitch &s : strings) {
+        REQUIRE(std::string(s.note.name) == "LOW");
+        REQUIRE(s.actual_frequency == -1);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef TUNER_TEST_SIGNALS_H
+#define TUNER_TEST_SIGNALS_H
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <tuner/global.hpp>
+
+// synthetic signals shared by the tests
+namespace tuner::test {
+
+    /**
+     * @brief Sample 'i' of a tone with five harmonics, harmonic h at an amplitude of 0.2 / h.
+     */
+    inline float harmonic_sample(float frequency, int sample_rate, int i) {
+        float v = 0;
+        for (int h = 1; h <= 5; h++) {
+            v += 0.2f / float(h) * std::sin(2.0f * float(M_PI) * frequency * float(h) * float(i) / float(sample_rate));
+        }
+
+        return v;
+    }
+
+    /**
+     * @brief The first TUNER_SIZE samples of tuner::test::harmonic_sample.
+     */
+    inline std::array<float, TUNER_SIZE> harmonic_frame(float frequency, int sample_rate) {
+        std::array<float, TUNER_SIZE> m = {};
+        for (int i = 0; i < TUNER_SIZE; i++) {
+            m[i] = harmonic_sample(frequency, sample_rate, i);
+        }
+
+        return m;
+    }
+
+    /**
+     * @brief The first 'length' samples of tuner::test::harmonic_sample.
+     */
+    inline std::vector<float> harmonic_tone(float frequency, int sample_rate, int length) {
+        std::vector<float> m(size_t(length), 0.0f);
+        for (int i = 0; i < length; i++) {
+            m[i] = harmonic_sample(frequency, sample_rate, i);
+        }
+
+        return m;
+    }
+}
+
+#endif //TUNER_TEST_SIGNALS_H
@@ -0,0 +1,58 @@
+#ifndef TUNER_TRIPLE_BUFFER_H
+#define TUNER_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace tuner {
+
+    /**
+     * @brief Hands the latest value from one writer thread to one reader thread without locks.
+     *
+     * The writer fills a back slot and swaps it with the shared middle slot; the reader swaps the middle slot with its
+     * front slot when a newer value is waiting. Both sides finish in a bounded number of steps, never see a partially
+     * written value and never wait for each other. Intermediate values are skipped if the reader falls behind.
+     */
+    template<typename T>
+    class triple_buffer {
+    public:
+        triple_buffer() = default;
+
+        triple_buffer(const triple_buffer &) = delete;
+
+        triple_buffer &operator=(const triple_buffer &) = delete;
+
+        /**
+         * @brief Publishes 'value'. Only one thread may write.
+         */
+        void write(const T &value) noexcept {
+            slots[back] = value;
+            uint8_t previous = middle.exchange(uint8_t(back | FRESH), std::memory_order_acq_rel);
+            back = previous & INDEX_MASK;
+        }
+
+        /**
+         * @brief The most recently published value, or a value-initialized T before the first write. Only one thread
+         *        may read. The reference stays valid until the next call to read().
+         */
+        const T &read() noexcept {
+            if (middle.load(std::memory_order_relaxed) & FRESH) {
+                uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+                front = previous & INDEX_MASK;
+            }
+            return slots[front];
+        }
+
+    private:
+        static constexpr uint8_t INDEX_MASK = 0x3;
+        static constexpr uint8_t FRESH = 0x4;
+
+        std::array<T, 3> slots{};
+        uint8_t back = 0;
+        std::atomic<uint8_t> middle{1};
+        uint8_t front = 2;
+    };
+}
+
+#endif //TUNER_TRIPLE_BUFFER_H
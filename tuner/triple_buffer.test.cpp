@@ -0,0 +1,46 @@
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/triple_buffer.hpp>
+
+struct triple_buffer_test_value {
+    int a;
+    int b;
+};
+
+TEST_CASE("[triple_buffer] reads a value-initialized value before the first write") {
+    tuner::triple_buffer<int> buffer;
+    REQUIRE(buffer.read() == 0);
+}
+
+TEST_CASE("[triple_buffer] reads the latest write") {
+    tuner::triple_buffer<int> buffer;
+    buffer.write(1);
+    buffer.write(2);
+    REQUIRE(buffer.read() == 2);
+    REQUIRE(buffer.read() == 2);
+    buffer.write(3);
+    REQUIRE(buffer.read() == 3);
+}
+
+TEST_CASE("[triple_buffer] a concurrent reader never sees a torn or older value") {
+    constexpr int total = 20000;
+    tuner::triple_buffer<triple_buffer_test_value> buffer;
+
+    std::thread writer([&buffer]() {
+        for (int i = 1; i <= total; i++) {
+            buffer.write({i, -i});
+        }
+    });
+
+    bool consistent = true;
+    int last = 0;
+    while (last < total) {
+        triple_buffer_test_value v = buffer.read();
+        consistent = consistent && v.a == -v.b && v.a >= last;
+        last = v.a;
+    }
+    writer.join();
+
+    REQUIRE(consistent);
+}
@@ -1,601 +1,466 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
-#include <string>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
+#include <tuner/cepstrum.hpp>
+#include <tuner/corpus.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/harmonic_comb.hpp>
+#include <tuner/multires.hpp>
 #include <tuner/wa_tuner.hpp>
 #include <tuner/tuner.hpp>
 #include <tuner/global.hpp>
 
 constexpr int SAMPLE_RATE  = 48000;
+constexpr char ASSETS_PATH[] = "./acceptance-test-assets";
+constexpr char CORPUS_PATH[] = "./acceptance-test-assets/acceptance.corpus";
+constexpr char MANIFEST_PATH[] = "./acceptance-test-assets/manifest.csv";
+constexpr char BASELINE_PATH[] = "./acceptance-test-assets/baseline.csv";
+constexpr char RECORD_BASELINE_ENV[] = "TUNER_RECORD_BASELINE";
+constexpr char THROUGHPUT_TOLERANCE_ENV[] = "TUNER_THROUGHPUT_TOLERANCE";
+
+// regressions smaller than these are treated as noise, e.g. from a different FFT build
+constexpr float ACCURACY_TOLERANCE = 0.01;
+constexpr float VOICED_FRAMES_TOLERANCE = 0.01;
+constexpr float MEDIAN_CENTS_TOLERANCE = 5;
+// the fraction of the baseline frames per second a label may lose; timings are noisier than the other metrics and
+// depend on the machine, so this is generous and can be overridden with TUNER_THROUGHPUT_TOLERANCE, e.g. 1 to ignore
+// throughput on a shared CI runner
+constexpr double THROUGHPUT_TOLERANCE = 0.5;
+
+// octave errors and zero frequencies are clamped to two octaves so they still count as errors
+constexpr float MAX_CENTS_ERROR = 2400;
+
 constexpr char ANSI_RESET[] = "\033[0m";
 constexpr char ANSI_RED[] = "\033[31m";
 constexpr char ANSI_GREEN[] = "\033[32m";
 constexpr char ANSI_BLUE[] = "\033[34m";
 
 /**
- * Retrieves audio data from a file and returns it as a vector of floating-point values.
- *
- * This function reads audio data from the specified file path and converts it into
- * a sequence of floating-point values, representing the audio samples. The file should
- * be in a format supported by this function (e.g., WAV, MP3, etc.), and the audio data
- * should be in a format that can be represented using single-precision floating-point values.
- *
- * @param file_path The path to the audio file to be read.
- * @return A std::vector<float> containing the audio samples from the file.
- *         If the file cannot be read or the audio format is unsupported, an empty vector is returned.
- * @throws Any exceptions related to file I/O operations or audio decoding may be thrown.
- *         It's recommended to handle these exceptions in the calling code.
+ * An analysis entry point under test. 'make' creates one analyzer, which returns the detected frequency of a
+ * TUNER_SIZE frame, or -1 when the frame was gated for low energy. Analyzers of thread safe configurations
+ * may run concurrently, one per thread.
  */
-std::vector<float> get_audio_buffer_from_file(std::string file_path) {
-    bool capture_number = false;
-    std::vector<float> out_buffer = {};
-
-    std::ifstream audio_file;
-    audio_file.open(file_path);
-
-    if (audio_file.is_open()) { // always check whether the file is open
-        char current_char;
-        std::string temp_buffer;
-        while (audio_file) {
-            current_char = audio_file.get();
-
-            if (capture_number) {
-                if (current_char == ',') {
-                    out_buffer.push_back(std::stof(temp_buffer));
-                    temp_buffer = "";
-                    capture_number = false;
-                    continue;
-                }
-
-                temp_buffer += current_char;
-            }
-            if (current_char == '(') {
-                capture_number = true;
-            }
+struct engine_configuration {
+    std::string name;
+    bool thread_safe;
+    std::function<std::function<float(const float *)>()> make;
+};
+
+struct baseline_entry {
+    float accuracy;
+    uint64_t voiced_frames;
+    float median_abs_cents;
+    double frames_per_second;
+};
+
+struct label_result {
+    std::string configuration;
+    std::string label;
+    uint64_t frames = 0;
+    uint64_t voiced_frames = 0;
+    uint64_t success_count = 0;
+    std::vector<float> abs_cents;
+    double seconds = 0;
+
+    [[nodiscard]] float accuracy() const {
+        return voiced_frames == 0 ? 0 : float(success_count) / float(voiced_frames);
+    }
+
+    [[nodiscard]] float abs_cents_percentile(float p) const {
+        if (abs_cents.empty()) {
+            return 0;
         }
+        return abs_cents[std::min(abs_cents.size() - 1, size_t(p * float(abs_cents.size())))];
     }
 
-    audio_file.clear();
-    audio_file.close();
+    [[nodiscard]] float mean_abs_cents() const {
+        double sum = 0;
+        for (float c: abs_cents) {
+            sum += c;
+        }
+        return abs_cents.empty() ? 0 : float(sum / double(abs_cents.size()));
+    }
 
-    return out_buffer;
-}
+    [[nodiscard]] double frames_per_second() const {
+        return seconds > 0 ? double(frames) / seconds : 0;
+    }
+};
 
 /**
- * Logs test metrics for a series of iterations.
- *
- * This function is used to log the success metrics of a test over a number of iterations.
- * It provides information about the success count and total iteration count, allowing
- * monitoring of test performance and progress.
- *
- * @param success_count The number of successful outcomes or events observed during the test.
- * @param iteration_count The total number of iterations or trials conducted for the test.
- * @note It is assumed that both success_count and iteration_count are non-negative integers.
- * @note The function does not perform any validation on the input parameters.
- * @note This function does not return any values; it only logs the metrics.
+ * The frequency a tuner::realtime_status engine reports for a frame: -1 for gated frames, and 0 for frames it did not
+ * analyze at all, which count as errors.
  */
-void log_test_metrics(int success_count, int iteration_count) {
-    std::cout << ANSI_BLUE << std::left << std::setw(20) <<"Iteration Count"
-              << std::setw(20) << "Success Count"
-              << std::setw(20) << "Success Percentage"
-              << std::endl;
-
-    std::cout << std::setw(20) << iteration_count
-              << std::setw(20) << success_count
-              << std::setw(20) << std::to_string((float)success_count / (float)iteration_count * 100) + "%"
-              << ANSI_RESET
-              << std::endl;
+float frequency_of(tuner::realtime_status status, const tuner::realtime_note &note) {
+    switch (status) {
+        case tuner::realtime_status::ok:
+            return note.actual_frequency;
+        case tuner::realtime_status::low_energy:
+            return -1;
+        default:
+            return 0;
+    }
 }
 
-TEST_CASE("[wa_tuner] frequency should be 82.41") {
-    float success_count = 0;
-    float iteration_count = 0;
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/e2-audio-stream/audio-stream-e2-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            push_value(buf[i]);
-
-            if (i == TUNER_SIZE - 1) {
-                float frequency = get_frequency(48000);
-                if (frequency > 70 && frequency < 90) {
-                    success_count += 1;
-                }
-
-                if (frequency != -1) {
-                    iteration_count += 1;
-                }
-
+/**
+ * Lists every analysis entry point the harness measures. Add new engine configurations here; they are picked
+ * up by the regression test and need a baseline recorded with TUNER_RECORD_BASELINE=1.
+ */
+std::vector<engine_configuration> get_engine_configurations() {
+    return {
+            {"tune", true, [] {
+                return [buffer = std::array<float, TUNER_SIZE>()](const float *frame) mutable {
+                    std::copy(frame, frame + TUNER_SIZE, buffer.begin());
+                    tuner::note_context *nc = tuner::tune(buffer, SAMPLE_RATE);
+                    float frequency = nc->actual_frequency;
+                    delete nc;
+                    return frequency;
+                };
+            }},
+            {"wa_tuner", false, [] {
+                return [](const float *frame) {
+                    for (int i = 0; i < TUNER_SIZE; i++) {
+                        push_value(frame[i]);
+                    }
+                    float frequency = get_frequency(SAMPLE_RATE);
+                    clear_buffer_offset();
+                    return frequency;
+                };
+            }},
+            {"engine", true, [] {
+                auto e = std::make_shared<tuner::engine>(SAMPLE_RATE);
+                return [e, buffer = std::array<float, TUNER_SIZE>()](const float *frame) mutable {
+                    std::copy(frame, frame + TUNER_SIZE, buffer.begin());
+                    return e->process(buffer).actual_frequency;
+                };
+            }},
+            {"cepstrum", true, [] {
+                auto e = std::make_shared<tuner::cepstrum_engine>(SAMPLE_RATE);
+                return [e](const float *frame) {
+                    tuner::realtime_note note;
+                    return frequency_of(e->process(frame, note), note);
+                };
+            }},
+            {"multires", true, [] {
+                auto e = std::make_shared<tuner::multires_engine>(SAMPLE_RATE);
+                // the latest two frames of the label, so an escalated frame sees 2 * TUNER_SIZE samples of history
+                return [e, history = std::vector<float>(size_t(e->large_size()), 0.0f)](const float *frame) mutable {
+                    std::copy(history.begin() + TUNER_SIZE, history.end(), history.begin());
+                    std::copy(frame, frame + TUNER_SIZE, history.end() - TUNER_SIZE);
+                    tuner::realtime_note note;
+                    return frequency_of(e->process(history.data(), note), note);
+                };
+            }},
+            {"comb", true, [] {
+                auto e = std::make_shared<tuner::comb_engine>(SAMPLE_RATE);
+                return [e](const float *frame) {
+                    tuner::realtime_note note;
+                    return frequency_of(e->process(frame, note), note);
+                };
+            }},
+    };
+}
 
-                clear_buffer_offset();
-            }
+/**
+ * Reads the manifest that maps every asset directory to the note it contains and the accepted frequency range.
+ *
+ * @return One tuner::corpus_source per manifest row, with 'directory' resolved against ./acceptance-test-assets.
+ */
+std::vector<tuner::corpus_source> read_manifest() {
+    std::vector<tuner::corpus_source> sources;
+    std::ifstream manifest(MANIFEST_PATH);
+    std::string line;
+    std::getline(manifest, line); // header
+    while (std::getline(manifest, line)) {
+        std::stringstream row(line);
+        std::string directory, label, expected, min, max;
+        if (std::getline(row, directory, ',') && std::getline(row, label, ',') && std::getline(row, expected, ',') &&
+            std::getline(row, min, ',') && std::getline(row, max, ',')) {
+            sources.push_back({label, std::stof(expected), std::stof(min), std::stof(max),
+                               (std::filesystem::path(ASSETS_PATH) / directory).string()});
         }
-
-        buf.clear();
     }
 
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.50f);
+    return sources;
 }
 
-TEST_CASE("[tuner] frequency should be 82.41") {
-    float success_count = 0;
-    float iteration_count = 0;
-    std::array<float, TUNER_SIZE> audio_buffer = {};
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/e2-audio-stream/audio-stream-e2-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            audio_buffer[i] = buf[i];
-
-            if (i == TUNER_SIZE - 1) {
-                auto nc = tuner::tune(audio_buffer, SAMPLE_RATE);
-                if (nc->actual_frequency > 70 && nc->actual_frequency < 90) {
-                    success_count += 1;
-                }
-
-                if (nc->actual_frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
-            }
+/**
+ * Lists every directory of text encoded frames below ./acceptance-test-assets.
+ */
+std::vector<std::string> discover_asset_directories() {
+    std::vector<std::string> directories;
+    for (const auto &entry: std::filesystem::directory_iterator(ASSETS_PATH)) {
+        if (entry.is_directory()) {
+            directories.push_back(entry.path().string());
         }
-
-        buf.clear();
     }
+    std::sort(directories.begin(), directories.end());
 
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.50f);
+    return directories;
 }
 
-TEST_CASE("[wa_tuner] frequency should be 329.63") {
-    float success_count = 0;
-    float iteration_count = 0;
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/e4-audio-stream/audio-stream-e4-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            push_value(buf[i]);
-
-            if (i == TUNER_SIZE - 1) {
-                float frequency = get_frequency(48000);
-                if (frequency > 310 && frequency < 340) {
-                    success_count += 1;
-                }
-
-                if (frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
+/**
+ * Retrieves the acceptance corpus, a memory-mapped binary copy of the text encoded assets in ./acceptance-test-assets.
+ *
+ * The corpus is converted from the text assets, in parallel, whenever it is missing or older than the manifest or
+ * one of the asset directories, and reused by later runs otherwise.
+ *
+ * @return A tuner::corpus_reader with one label per manifest row.
+ * @throws tuner::FileOpenException or tuner::CorpusFormatException if the corpus cannot be created or read.
+ */
+const tuner::corpus_reader &get_acceptance_corpus() {
+    static const tuner::corpus_reader corpus = [] {
+        std::vector<tuner::corpus_source> sources = read_manifest();
+
+        bool stale = !std::filesystem::exists(CORPUS_PATH);
+        if (!stale) {
+            auto corpus_time = std::filesystem::last_write_time(CORPUS_PATH);
+            stale = std::filesystem::last_write_time(MANIFEST_PATH) > corpus_time;
+            for (const tuner::corpus_source &source: sources) {
+                stale = stale || std::filesystem::last_write_time(source.directory) > corpus_time;
             }
         }
 
-        buf.clear();
-    }
-
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
+        if (stale) {
+            int threads = int(std::max(1u, std::thread::hardware_concurrency()));
+            tuner::convert_text_corpus(sources, CORPUS_PATH, TUNER_SIZE, SAMPLE_RATE, threads);
+        }
+        return tuner::corpus_reader(CORPUS_PATH);
+    }();
 
-    REQUIRE((success_count / iteration_count) > 0.65f);
+    return corpus;
 }
 
-TEST_CASE("[tuner] frequency should be 329.63") {
-    float success_count = 0;
-    float iteration_count = 0;
-    std::array<float, TUNER_SIZE> audio_buffer = {};
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/e4-audio-stream/audio-stream-e4-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            audio_buffer[i] = buf[i];
-
-            if (i == TUNER_SIZE - 1) {
-                auto nc = tuner::tune(audio_buffer, SAMPLE_RATE);
-                if (nc->actual_frequency > 310 && nc->actual_frequency < 340) {
-                    success_count += 1;
-                }
-
-                if (nc->closest_note_frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
-            }
+std::map<std::string, baseline_entry> read_baseline() {
+    std::map<std::string, baseline_entry> baseline;
+    std::ifstream file(BASELINE_PATH);
+    std::string line;
+    std::getline(file, line); // header
+    while (std::getline(file, line)) {
+        std::stringstream row(line);
+        std::string configuration, label, accuracy, voiced_frames, median_abs_cents, frames_per_second;
+        if (std::getline(row, configuration, ',') && std::getline(row, label, ',') &&
+            std::getline(row, accuracy, ',') && std::getline(row, voiced_frames, ',') &&
+            std::getline(row, median_abs_cents, ',') && std::getline(row, frames_per_second, ',')) {
+            baseline[configuration + "/" + label] = {std::stof(accuracy), std::stoull(voiced_frames),
+                                                     std::stof(median_abs_cents), std::stod(frames_per_second)};
         }
-
-        buf.clear();
     }
 
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.65f);
+    return baseline;
 }
 
-TEST_CASE("[wa_tuner] frequency should be 246.94") {
-    float success_count = 0;
-    float iteration_count = 0;
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/b-audio-stream/audio-stream-b-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            push_value(buf[i]);
-
-            if (i == TUNER_SIZE - 1) {
-                float frequency = get_frequency(48000);
-                if (frequency > 230 && frequency < 255) {
-                    success_count += 1;
-                }
-
-                if (frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
-            }
-        }
-
-        buf.clear();
+void write_baseline(const std::vector<label_result> &results) {
+    std::ofstream file(BASELINE_PATH, std::ios::trunc);
+    file << "configuration,label,accuracy,voiced_frames,median_abs_cents,frames_per_second\n" << std::fixed;
+    for (const label_result &r: results) {
+        file << r.configuration << ',' << r.label << ',' << std::setprecision(4) << r.accuracy() << ','
+             << r.voiced_frames << ',' << std::setprecision(2) << r.abs_cents_percentile(0.5) << ','
+             << std::setprecision(0) << r.frames_per_second() << '\n';
     }
-
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // there aren't any low volume sections in these audio streams
-    REQUIRE(iteration_count == 703);
-
-    REQUIRE((success_count / iteration_count) > 0.70f);
 }
 
-TEST_CASE("[tuner] frequency should be 246.94") {
-    float success_count = 0;
-    float iteration_count = 0;
-    std::array<float, TUNER_SIZE> audio_buffer = {};
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/b-audio-stream/audio-stream-b-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            audio_buffer[i] = buf[i];
-
-            if (i == TUNER_SIZE - 1) {
-                auto nc = tuner::tune(audio_buffer, SAMPLE_RATE);
-                if (nc->actual_frequency > 230 && nc->actual_frequency < 255) {
-                    success_count += 1;
-                }
-
-                if (nc->actual_frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
-            }
-        }
-
-        buf.clear();
+/**
+ * The fraction of the baseline throughput a label may lose, THROUGHPUT_TOLERANCE unless TUNER_THROUGHPUT_TOLERANCE
+ * holds a number.
+ */
+double get_throughput_tolerance() {
+    const char *value = std::getenv(THROUGHPUT_TOLERANCE_ENV);
+    if (value == nullptr) {
+        return THROUGHPUT_TOLERANCE;
     }
 
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // there aren't any low volume sections in these audio streams
-    REQUIRE(iteration_count == 703);
-
-    REQUIRE((success_count / iteration_count) > 0.70f);
+    char *end = nullptr;
+    double tolerance = std::strtod(value, &end);
+    return end != value ? std::clamp(tolerance, 0.0, 1.0) : THROUGHPUT_TOLERANCE;
 }
 
-TEST_CASE("[wa_tuner] frequency should be 196.00") {
-    float success_count = 0;
-    float iteration_count = 0;
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/g-audio-stream/audio-stream-g-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            push_value(buf[i]);
-
-            if (i == TUNER_SIZE - 1) {
-                float frequency = get_frequency(48000);
-                if (frequency > 180 && frequency < 205) {
-                    success_count += 1;
-                }
-
-                if (frequency != -1) {
-                    iteration_count += 1;
-                }
+/**
+ * Runs one analyzer over every frame of a label and collects accuracy, cents error and timing.
+ */
+label_result evaluate(const engine_configuration &configuration, const tuner::corpus_reader &corpus, uint32_t label_index) {
+    const tuner::corpus_label &label = corpus.label(label_index);
+    label_result result;
+    result.configuration = configuration.name;
+    result.label = label.name;
+
+    std::function<float(const float *)> analyze = configuration.make();
+    auto start = std::chrono::steady_clock::now();
+    for (tuner::corpus_frame frame: corpus) {
+        if (frame.label_index != label_index) {
+            continue;
+        }
 
+        float frequency = analyze(frame.samples);
+        result.frames++;
+        if (frequency == -1) {
+            continue;
+        }
 
-                clear_buffer_offset();
-            }
+        result.voiced_frames++;
+        if (frequency > label.min_frequency && frequency < label.max_frequency) {
+            result.success_count++;
         }
 
-        buf.clear();
+        float cents = frequency > 0 ? std::abs(1200.0f * std::log2(frequency / label.expected_frequency)) : MAX_CENTS_ERROR;
+        result.abs_cents.push_back(std::min(cents, MAX_CENTS_ERROR));
     }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(result.abs_cents.begin(), result.abs_cents.end());
 
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.60f);
+    return result;
 }
 
-TEST_CASE("[tuner] frequency should be 196.00") {
-    float success_count = 0;
-    float iteration_count = 0;
-    std::array<float, TUNER_SIZE> audio_buffer = {};
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/g-audio-stream/audio-stream-g-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            audio_buffer[i] =buf[i];
-
-            if (i == TUNER_SIZE - 1) {
-                auto nc = tuner::tune(audio_buffer, SAMPLE_RATE);
-                if (nc->actual_frequency > 180 && nc->actual_frequency < 205) {
-                    success_count += 1;
-                }
-
-                if (nc->actual_frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
-            }
+/**
+ * Evaluates every configuration on every label. Jobs of thread safe configurations run in parallel, one analyzer per job.
+ */
+std::vector<label_result> evaluate_all(const std::vector<engine_configuration> &configurations,
+                                       const tuner::corpus_reader &corpus) {
+    struct job {
+        size_t configuration;
+        uint32_t label_index;
+    };
+
+    std::vector<job> parallel_jobs;
+    std::vector<job> serial_jobs;
+    for (size_t c = 0; c < configurations.size(); c++) {
+        for (uint32_t l = 0; l < corpus.label_count(); l++) {
+            (configurations[c].thread_safe ? parallel_jobs : serial_jobs).push_back({c, l});
         }
-
-        buf.clear();
     }
 
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.60f);
-}
-
-TEST_CASE("[wa_tuner] frequency should be 146.83") {
-    float success_count = 0;
-    float iteration_count = 0;
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/d-audio-stream/audio-stream-d-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            push_value(buf[i]);
-
-            if (i == TUNER_SIZE - 1) {
-                float frequency = get_frequency(48000);
-                if (frequency > 130 && frequency < 155) {
-                    success_count += 1;
-                }
-
-                if (frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
+    std::vector<label_result> results(configurations.size() * corpus.label_count());
+    auto run = [&](const job &j) {
+        results[j.configuration * corpus.label_count() + j.label_index] =
+                evaluate(configurations[j.configuration], corpus, j.label_index);
+    };
+
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> pool;
+    unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int t = 0; t < threads; t++) {
+        pool.emplace_back([&]() {
+            for (size_t i = next.fetch_add(1); i < parallel_jobs.size(); i = next.fetch_add(1)) {
+                run(parallel_jobs[i]);
             }
-        }
-
-        buf.clear();
+        });
+    }
+    for (const job &j: serial_jobs) {
+        run(j);
+    }
+    for (std::thread &t: pool) {
+        t.join();
     }
 
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.55f);
+    return results;
 }
 
-TEST_CASE("[tuner] frequency should be 146.83") {
-    float success_count = 0;
-    float iteration_count = 0;
-    std::array<float, TUNER_SIZE> audio_buffer = {};
-
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/d-audio-stream/audio-stream-d-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            audio_buffer[i] = buf[i];
-
-            if (i == TUNER_SIZE - 1) {
-                auto nc = tuner::tune(audio_buffer, SAMPLE_RATE);
-                if (nc->actual_frequency > 130 && nc->actual_frequency < 155) {
-                    success_count += 1;
-                }
-
-                if (nc->actual_frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
-            }
-        }
-
-        buf.clear();
+/**
+ * Logs accuracy, the distribution of the absolute cents error and the throughput of every configuration and label.
+ */
+void log_test_metrics(const std::vector<label_result> &results) {
+    std::cout << ANSI_BLUE << std::left
+              << std::setw(12) << "Config"
+              << std::setw(8) << "Label"
+              << std::setw(8) << "Frames"
+              << std::setw(8) << "Voiced"
+              << std::setw(11) << "Accuracy"
+              << std::setw(12) << "Mean|c|"
+              << std::setw(10) << "P50|c|"
+              << std::setw(10) << "P90|c|"
+              << std::setw(10) << "P99|c|"
+              << std::setw(12) << "Frames/s"
+              << ANSI_RESET << std::endl;
+
+    for (const label_result &r: results) {
+        std::cout << std::left << std::fixed << std::setprecision(1)
+                  << std::setw(12) << r.configuration
+                  << std::setw(8) << r.label
+                  << std::setw(8) << r.frames
+                  << std::setw(8) << r.voiced_frames
+                  << std::setw(11) << std::to_string(int(std::round(r.accuracy() * 1000)) / 10.0).substr(0, 4) + "%"
+                  << std::setw(12) << r.mean_abs_cents()
+                  << std::setw(10) << r.abs_cents_percentile(0.5)
+                  << std::setw(10) << r.abs_cents_percentile(0.9)
+                  << std::setw(10) << r.abs_cents_percentile(0.99)
+                  << std::setw(12) << std::setprecision(0) << r.frames_per_second()
+                  << std::endl;
     }
-
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.55f);
+    std::cout << std::defaultfloat;
 }
 
-TEST_CASE("[wa_tuner] frequency should be 110.00") {
-    float success_count = 0;
-    float iteration_count = 0;
+TEST_CASE("[acceptance] every asset directory is listed in the manifest") {
+    std::vector<tuner::corpus_source> sources = read_manifest();
+    REQUIRE(!sources.empty());
 
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/a-audio-stream/audio-stream-a-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
-
-        for (int i = 0; i < buf.size(); i++) {
-            push_value(buf[i]);
-
-            if (i == TUNER_SIZE - 1) {
-                float frequency = get_frequency(48000);
-                if (frequency > 100 && frequency < 120) {
-                    success_count += 1;
-                }
-
-                if (frequency != -1) {
-                    iteration_count += 1;
-                }
-
-
-                clear_buffer_offset();
-            }
+    for (const std::string &directory: discover_asset_directories()) {
+        bool listed = std::any_of(sources.begin(), sources.end(), [&](const tuner::corpus_source &s) {
+            return std::filesystem::equivalent(s.directory, directory);
+        });
+        if (!listed) {
+            std::cout << ANSI_RED << directory << " is not listed in " << MANIFEST_PATH << ANSI_RESET << std::endl;
         }
-
-        buf.clear();
+        CHECK(listed);
     }
-
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.50f);
 }
 
-TEST_CASE("[tuner] frequency should be 110.00") {
-    float success_count = 0;
-    float iteration_count = 0;
-    std::array<float, TUNER_SIZE> audio_buffer = {};
+TEST_CASE("[acceptance] accuracy and throughput do not regress against the baseline") {
+    const tuner::corpus_reader &corpus = get_acceptance_corpus();
+    REQUIRE(corpus.label_count() > 0);
 
-    for (int x = 1; x < 704; x++) {
-        std::string file_path = "./acceptance-test-assets/a-audio-stream/audio-stream-a-" + std::to_string(x) + ".txt";
-        std::vector<float> buf = get_audio_buffer_from_file(file_path);
-        assert(buf.size() == TUNER_SIZE);
+    std::vector<label_result> results = evaluate_all(get_engine_configurations(), corpus);
+    log_test_metrics(results);
 
-        for (int i = 0; i < buf.size(); i++) {
-            audio_buffer[i] = buf[i];
-
-            if (i == TUNER_SIZE - 1) {
-                auto nc = tuner::tune(audio_buffer, SAMPLE_RATE);
-                if (nc->actual_frequency > 100 && nc->actual_frequency < 120) {
-                    success_count += 1;
-                }
-
-                if (nc->actual_frequency != -1) {
-                    iteration_count += 1;
-                }
+    if (std::getenv(RECORD_BASELINE_ENV) != nullptr) {
+        write_baseline(results);
+        std::cout << ANSI_GREEN << "recorded " << BASELINE_PATH << ANSI_RESET << std::endl;
+        return;
+    }
 
+    std::map<std::string, baseline_entry> baseline = read_baseline();
+    const double throughput_tolerance = get_throughput_tolerance();
+    for (const label_result &r: results) {
+        auto found = baseline.find(r.configuration + "/" + r.label);
+        if (found == baseline.end()) {
+            std::cout << ANSI_RED << "no baseline for " << r.configuration << "/" << r.label << ", run with "
+                      << RECORD_BASELINE_ENV << "=1 to record one" << ANSI_RESET << std::endl;
+            CHECK(false);
+            continue;
+        }
 
-                clear_buffer_offset();
-            }
+        const baseline_entry &expected = found->second;
+        bool accuracy_held = r.accuracy() >= expected.accuracy - ACCURACY_TOLERANCE;
+        bool voiced_frames_held = std::abs(double(r.voiced_frames) - double(expected.voiced_frames)) <=
+                                  VOICED_FRAMES_TOLERANCE * double(r.frames);
+        bool cents_held = r.abs_cents_percentile(0.5) <= expected.median_abs_cents + MEDIAN_CENTS_TOLERANCE;
+        bool throughput_held = r.frames_per_second() >= (1 - throughput_tolerance) * expected.frames_per_second;
+        if (!accuracy_held || !voiced_frames_held || !cents_held || !throughput_held) {
+            std::cout << ANSI_RED << r.configuration << "/" << r.label << " regressed: accuracy " << r.accuracy()
+                      << " (baseline " << expected.accuracy << "), voiced frames " << r.voiced_frames
+                      << " (baseline " << expected.voiced_frames << "), median |cents| " << r.abs_cents_percentile(0.5)
+                      << " (baseline " << expected.median_abs_cents << "), frames/s " << r.frames_per_second()
+                      << " (baseline " << expected.frames_per_second << ")" << ANSI_RESET << std::endl;
         }
 
-        buf.clear();
+        CHECK(accuracy_held);
+        CHECK(voiced_frames_held);
+        CHECK(cents_held);
+        CHECK(throughput_held);
     }
-
-    log_test_metrics(success_count, iteration_count);
-
-    // Ensure that the correct number of samples were processed
-    REQUIRE(success_count > 300);
-    REQUIRE(iteration_count > 600);
-
-    // ensure that at least some low volume sections were captured
-    REQUIRE(iteration_count < 703);
-
-    REQUIRE((success_count / iteration_count) > 0.50f);
-}
\ No newline at end of file
+}
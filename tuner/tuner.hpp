@@ -5,6 +5,7 @@
 #include <string>
 
 #include <tuner/global.hpp>
+#include <tuner/metrics.hpp>
 #include <tuner/note.hpp>
 
 
@@ -17,9 +18,12 @@ namespace tuner {
      *
      * @param audio_stream_buffer The input std::array<float, TUNER_SIZE> representing the audio stream buffer to be tuned.
      * @param sample_rate The sample rate of the audio stream buffer.
+     * @param metrics Optional per-instance counters that receive stage timings, frame, gated frame and allocation counts.
+     *                Nothing is recorded unless the library is built with TUNER_INSTRUMENTATION.
      *
      * @return A const char* representing the tuned result of the audio stream buffer.
      */
-    struct tuner::note_context *tune(std::array<float, TUNER_SIZE> audio_stream_buffer, int sample_rate);
+    struct tuner::note_context *
+    tune(std::array<float, TUNER_SIZE> audio_stream_buffer, int sample_rate, tuner::metrics *metrics = nullptr);
 }
 #endif //TUNER_TUNER_H
@@ -0,0 +1,428 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tuner/csv.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/wav.hpp>
+
+namespace {
+
+    enum class output_format {
+        csv,
+        json,
+        columnar
+    };
+
+    struct cli_options {
+        std::vector<std::string> inputs;
+        std::string output_directory = ".";
+        output_format format = output_format::csv;
+        int threads = int(std::max(1u, std::thread::hardware_concurrency()));
+        tuner::wav_analysis_config analysis;
+        // choose the pitch track with tuner::track_wav instead of the highest candidate of every frame
+        bool smooth = false;
+        tuner::tracker_config tracking;
+    };
+
+    struct analysis_job {
+        std::string input_path;
+        std::string output_path;
+    };
+
+    struct file_summary {
+        std::string input_path;
+        std::string output_path;
+        std::string error;
+        int sample_rate = 0;
+        double duration_seconds = 0;
+        double wall_seconds = 0;
+        uint64_t frames = 0;
+        uint64_t voiced_frames = 0;
+        float mean_frequency = 0;
+        float min_frequency = 0;
+        float max_frequency = 0;
+        std::string dominant_note;
+    };
+
+    // "TNRTRK2" followed by a null byte; version 1 had no confidence column
+    constexpr char COLUMNAR_MAGIC[8] = {'T', 'N', 'R', 'T', 'R', 'K', '2', '\0'};
+
+    void print_usage(const char *program) {
+        std::cerr << "usage: " << program << " [options] <file or directory>...\n"
+                  << "\n"
+                  << "Analyzes WAV files into pitch tracks, one output file per input file.\n"
+                  << "\n"
+                  << "options:\n"
+                  << "  -o, --output <dir>       directory for pitch tracks and the summary (default: .)\n"
+                  << "  -f, --format <format>    csv, json or columnar (default: csv)\n"
+                  << "  -j, --threads <n>        number of worker threads (default: hardware concurrency)\n"
+                  << "      --hop <samples>      samples between two analyzed frames (default: " << TUNER_SIZE / 2 << ")\n"
+                  << "      --channel <n>        channel to analyze, -1 mixes all channels (default: 0)\n"
+                  << "      --smooth             choose the most likely pitch track among the top candidates of every\n"
+                  << "                           frame instead of the highest one, which removes octave jumps\n"
+                  << "      --jump-penalty <x>   cost of a one octave jump for --smooth (default: "
+                  << tuner::tracker_config().octave_jump_penalty << ")\n"
+                  << "\n"
+                  << "The columnar format stores a header {char magic[8] = \"TNRTRK2\", uint64 frame_count,\n"
+                  << "uint32 sample_rate, uint32 hop_size} followed by the columns float64 time_seconds[],\n"
+                  << "float32 frequency[], float32 closest_note_frequency[], float32 confidence[] and\n"
+                  << "char note[][4], little-endian.\n";
+    }
+
+    bool parse_options(int argc, char **argv, cli_options &options) {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool has_value = i + 1 < argc;
+            if ((arg == "-o" || arg == "--output") && has_value) {
+                options.output_directory = argv[++i];
+            } else if ((arg == "-f" || arg == "--format") && has_value) {
+                std::string format = argv[++i];
+                if (format == "csv") {
+                    options.format = output_format::csv;
+                } else if (format == "json") {
+                    options.format = output_format::json;
+                } else if (format == "columnar") {
+                    options.format = output_format::columnar;
+                } else {
+                    std::cerr << "unknown format: " << format << std::endl;
+                    return false;
+                }
+            } else if ((arg == "-j" || arg == "--threads") && has_value) {
+                options.threads = std::max(1, std::atoi(argv[++i]));
+            } else if (arg == "--hop" && has_value) {
+                options.analysis.hop_size = std::atoi(argv[++i]);
+            } else if (arg == "--channel" && has_value) {
+                options.analysis.channel = std::atoi(argv[++i]);
+            } else if (arg == "--smooth") {
+                options.smooth = true;
+            } else if (arg == "--jump-penalty" && has_value) {
+                options.tracking.octave_jump_penalty = float(std::atof(argv[++i]));
+            } else if (arg == "-h" || arg == "--help" || (!arg.empty() && arg[0] == '-')) {
+                return false;
+            } else {
+                options.inputs.push_back(arg);
+            }
+        }
+
+        return !options.inputs.empty() && options.analysis.hop_size > 0 && options.tracking.octave_jump_penalty >= 0;
+    }
+
+    bool is_wav_file(const std::filesystem::path &p) {
+        std::string extension = p.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        return extension == ".wav";
+    }
+
+    const char *extension_for(output_format format) {
+        switch (format) {
+            case output_format::csv:
+                return ".pitch.csv";
+            case output_format::json:
+                return ".pitch.json";
+            case output_format::columnar:
+                return ".pitch.bin";
+        }
+
+        return "";
+    }
+
+    /**
+     * Expands directories into the WAV files below them and assigns every input a unique output path.
+     */
+    std::vector<analysis_job> plan_jobs(const cli_options &options) {
+        std::vector<std::string> files;
+        for (const std::string &input: options.inputs) {
+            if (std::filesystem::is_directory(input)) {
+                std::vector<std::string> found;
+                for (const auto &entry: std::filesystem::recursive_directory_iterator(input)) {
+                    if (entry.is_regular_file() && is_wav_file(entry.path())) {
+                        found.push_back(entry.path().string());
+                    }
+                }
+                std::sort(found.begin(), found.end());
+                files.insert(files.end(), found.begin(), found.end());
+            } else {
+                files.push_back(input);
+            }
+        }
+
+        std::vector<analysis_job> jobs;
+        std::set<std::string> used_names;
+        for (const std::string &file: files) {
+            std::string stem = std::filesystem::path(file).stem().string();
+            std::string name = stem;
+            for (int n = 2; used_names.count(name) != 0; n++) {
+                name = stem + "-" + std::to_string(n);
+            }
+            used_names.insert(name);
+
+            std::filesystem::path output = std::filesystem::path(options.output_directory) / (name + extension_for(options.format));
+            jobs.push_back({file, output.string()});
+        }
+
+        return jobs;
+    }
+
+    std::string json_escape(const std::string &s) {
+        std::string out;
+        for (char c: s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                out += buffer;
+            } else {
+                out += c;
+            }
+        }
+
+        return out;
+    }
+
+    /**
+     * Writes the pitch track of one file. CSV and JSON rows are streamed as they are produced, the columnar format
+     * keeps the columns in memory until the file has been analyzed.
+     */
+    class track_writer {
+    public:
+        track_writer(const std::string &path, output_format format, int sample_rate, int hop_size)
+                : format(format), sample_rate(sample_rate), hop_size(hop_size) {
+            out.open(path, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                throw tuner::FileOpenException();
+            }
+
+            out << std::setprecision(9);
+            if (format == output_format::csv) {
+                out << "time_seconds,sample_offset,note,frequency,closest_note_frequency,confidence\n";
+            } else if (format == output_format::json) {
+                out << "[";
+            }
+        }
+
+        void write(const tuner::pitch_point &point) {
+            if (format == output_format::csv) {
+                out << point.time_seconds << ',' << point.sample_offset << ',' << point.note.name << ','
+                    << point.note.actual_frequency << ',' << point.note.closest_note_frequency << ','
+                    << point.note.confidence << '\n';
+            } else if (format == output_format::json) {
+                out << (rows == 0 ? "\n" : ",\n")
+                    << "  {\"time_seconds\": " << point.time_seconds
+                    << ", \"sample_offset\": " << point.sample_offset
+                    << ", \"note\": \"" << json_escape(point.note.name)
+                    << "\", \"frequency\": " << point.note.actual_frequency
+                    << ", \"closest_note_frequency\": " << point.note.closest_note_frequency
+                    << ", \"confidence\": " << point.note.confidence << "}";
+            } else {
+                times.push_back(point.time_seconds);
+                frequencies.push_back(point.note.actual_frequency);
+                closest.push_back(point.note.closest_note_frequency);
+                confidences.push_back(point.note.confidence);
+                std::array<char, 4> note = {};
+                std::memcpy(note.data(), point.note.name.c_str(), std::min<size_t>(note.size(), point.note.name.size()));
+                notes.push_back(note);
+            }
+            rows++;
+        }
+
+        void finish() {
+            if (format == output_format::json) {
+                out << (rows == 0 ? "]\n" : "\n]\n");
+            } else if (format == output_format::columnar) {
+                auto frame_count = uint64_t(rows);
+                auto rate = uint32_t(sample_rate);
+                auto hop = uint32_t(hop_size);
+                out.write(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+                out.write(reinterpret_cast<const char *>(&frame_count), sizeof(frame_count));
+                out.write(reinterpret_cast<const char *>(&rate), sizeof(rate));
+                out.write(reinterpret_cast<const char *>(&hop), sizeof(hop));
+                out.write(reinterpret_cast<const char *>(times.data()), std::streamsize(times.size() * sizeof(double)));
+                out.write(reinterpret_cast<const char *>(frequencies.data()), std::streamsize(frequencies.size() * sizeof(float)));
+                out.write(reinterpret_cast<const char *>(closest.data()), std::streamsize(closest.size() * sizeof(float)));
+                out.write(reinterpret_cast<const char *>(confidences.data()), std::streamsize(confidences.size() * sizeof(float)));
+                out.write(reinterpret_cast<const char *>(notes.data()), std::streamsize(notes.size() * 4));
+            }
+            out.close();
+        }
+
+    private:
+        std::ofstream out;
+        output_format format;
+        int sample_rate;
+        int hop_size;
+        uint64_t rows = 0;
+        std::vector<double> times;
+        std::vector<float> frequencies;
+        std::vector<float> closest;
+        std::vector<float> confidences;
+        std::vector<std::array<char, 4>> notes;
+    };
+
+    /**
+     * Analyzes one file with the worker's engine, replacing the engine when the file's sample rate differs.
+     */
+    file_summary analyze_job(const analysis_job &job, const cli_options &options, std::unique_ptr<tuner::engine> &e) {
+        file_summary summary;
+        summary.input_path = job.input_path;
+        summary.output_path = job.output_path;
+        auto start = std::chrono::steady_clock::now();
+
+        try {
+            tuner::wav_file wav(job.input_path);
+            summary.sample_rate = wav.info().sample_rate;
+            summary.duration_seconds = wav.duration_seconds();
+            if (!e || e->sample_rate() != wav.info().sample_rate) {
+                e = std::make_unique<tuner::engine>(wav.info().sample_rate);
+            }
+
+            track_writer writer(job.output_path, options.format, wav.info().sample_rate, options.analysis.hop_size);
+            double frequency_sum = 0;
+            std::map<std::string, uint64_t> note_counts;
+            auto record = [&](const tuner::pitch_point &point) {
+                writer.write(point);
+                if (point.note.actual_frequency < 0) {
+                    return;
+                }
+
+                if (summary.voiced_frames == 0 || point.note.actual_frequency < summary.min_frequency) {
+                    summary.min_frequency = point.note.actual_frequency;
+                }
+                if (summary.voiced_frames == 0 || point.note.actual_frequency > summary.max_frequency) {
+                    summary.max_frequency = point.note.actual_frequency;
+                }
+                frequency_sum += point.note.actual_frequency;
+                note_counts[point.note.name]++;
+                summary.voiced_frames++;
+            };
+            summary.frames = options.smooth ? tuner::track_wav(wav, *e, options.analysis, options.tracking, record)
+                                            : tuner::analyze_wav(wav, *e, options.analysis, record);
+            writer.finish();
+
+            if (summary.voiced_frames > 0) {
+                summary.mean_frequency = float(frequency_sum / double(summary.voiced_frames));
+                summary.dominant_note = std::max_element(note_counts.begin(), note_counts.end(), [](const auto &a, const auto &b) {
+                    return a.second < b.second;
+                })->first;
+            }
+        } catch (const std::exception &ex) {
+            summary.error = ex.what();
+        }
+
+        summary.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return summary;
+    }
+
+    void write_summary(const std::vector<file_summary> &summaries, const cli_options &options) {
+        bool as_json = options.format == output_format::json;
+        std::filesystem::path path = std::filesystem::path(options.output_directory) / (as_json ? "summary.json" : "summary.csv");
+        std::ofstream out(path, std::ios::trunc);
+        out << std::setprecision(9);
+
+        if (!as_json) {
+            out << "input,output,sample_rate,duration_seconds,wall_seconds,frames,voiced_frames,mean_frequency,"
+                   "min_frequency,max_frequency,dominant_note,error\n";
+            for (const file_summary &s: summaries) {
+                out << tuner::csv_field(s.input_path) << ',' << tuner::csv_field(s.output_path) << ',' << s.sample_rate << ','
+                    << s.duration_seconds << ',' << s.wall_seconds << ',' << s.frames << ',' << s.voiced_frames << ','
+                    << s.mean_frequency << ',' << s.min_frequency << ',' << s.max_frequency << ','
+                    << s.dominant_note << ',' << tuner::csv_field(s.error) << '\n';
+            }
+            return;
+        }
+
+        out << "[";
+        for (size_t i = 0; i < summaries.size(); i++) {
+            const file_summary &s = summaries[i];
+            out << (i == 0 ? "\n" : ",\n")
+                << "  {\"input\": \"" << json_escape(s.input_path)
+                << "\", \"output\": \"" << json_escape(s.output_path)
+                << "\", \"sample_rate\": " << s.sample_rate
+                << ", \"duration_seconds\": " << s.duration_seconds
+                << ", \"wall_seconds\": " << s.wall_seconds
+                << ", \"frames\": " << s.frames
+                << ", \"voiced_frames\": " << s.voiced_frames
+                << ", \"mean_frequency\": " << s.mean_frequency
+                << ", \"min_frequency\": " << s.min_frequency
+                << ", \"max_frequency\": " << s.max_frequency
+                << ", \"dominant_note\": \"" << json_escape(s.dominant_note)
+                << "\", \"error\": \"" << json_escape(s.error) << "\"}";
+        }
+        out << (summaries.empty() ? "]\n" : "\n]\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    cli_options options;
+    if (!parse_options(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::filesystem::create_directories(options.output_directory);
+    std::vector<analysis_job> jobs = plan_jobs(options);
+    std::vector<file_summary> summaries(jobs.size());
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> next_job{0};
+    std::mutex log_mutex;
+    auto worker = [&]() {
+        // one engine per worker, so FFT plans and buffers are reused across that worker's files
+        std::unique_ptr<tuner::engine> e;
+        for (size_t i = next_job.fetch_add(1); i < jobs.size(); i = next_job.fetch_add(1)) {
+            summaries[i] = analyze_job(jobs[i], options, e);
+            if (!summaries[i].error.empty()) {
+                std::lock_guard<std::mutex> lock(log_mutex);
+                std::cerr << jobs[i].input_path << ": " << summaries[i].error << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    int thread_count = std::min<int>(options.threads, std::max<int>(1, int(jobs.size())));
+    for (int i = 0; i < thread_count; i++) {
+        pool.emplace_back(worker);
+    }
+    for (std::thread &t: pool) {
+        t.join();
+    }
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    write_summary(summaries, options);
+
+    double audio_seconds = 0;
+    uint64_t frames = 0;
+    size_t failed = 0;
+    for (const file_summary &s: summaries) {
+        audio_seconds += s.duration_seconds;
+        frames += s.frames;
+        failed += s.error.empty() ? 0 : 1;
+    }
+
+    std::cout << "files: " << jobs.size() << " (" << failed << " failed)\n"
+              << "frames: " << frames << "\n"
+              << "audio: " << audio_seconds << " s\n"
+              << "wall time: " << wall_seconds << " s\n"
+              << "throughput: " << (wall_seconds > 0 ? audio_seconds / wall_seconds : 0)
+              << " s of audio per s of wall time (" << thread_count << " threads)" << std::endl;
+
+    return failed == 0 ? 0 : 2;
+}
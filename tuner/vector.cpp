@@ -1,83 +1,124 @@
 #include <iostream>
 #include <numeric>
 #include <algorithm>
+#include <cmath>
 
 #include <tuner/vector.hpp>
 
-std::vector<float> tuner::new_vector_with_values_between(int start, int end, float step) {
-    std::vector<float> v;
+namespace {
+    // the std::allocator and std::pmr overloads share these, so both produce the same values
 
-    if (step < 0) {
-        throw NegativeStepException();
-    }
+    template<typename Floats>
+    Floats values_between(int start, int end, float step, const typename Floats::allocator_type &allocator) {
+        Floats v(allocator);
 
-    auto current_value = float(start);
-    float counter = 1;
+        if (step < 0) {
+            throw tuner::NegativeStepException();
+        }
 
-    while (current_value < float(end)) {
-        v.push_back(current_value);
-        current_value = float(start) + step * counter++;
-    }
+        if (step > 0 && end > start) {
+            // one growth step instead of log2(n), which matters for monotonic resources
+            v.reserve(size_t(std::ceil(float(end - start) / step)) + 1);
+        }
 
-    return v;
-}
+        auto current_value = float(start);
+        float counter = 1;
 
-std::vector<uint32_t> tuner::sort(std::vector<float> m) {
-    std::vector <uint32_t> idx(m.size());
-    std::iota(idx.begin(), idx.end(), 0);
+        while (current_value < float(end)) {
+            v.push_back(current_value);
+            current_value = float(start) + step * counter++;
+        }
 
-    const auto function = [&](int i1, int i2)
-    noexcept->
-    bool{
-        return m[i1] < m[i2];
-    };
+        return v;
+    }
 
-    std::stable_sort(idx.begin(), idx.end(), function);
-    return idx;
-}
+    template<typename Indices, typename Floats>
+    Indices sort_indices(const Floats &m, const typename Indices::allocator_type &allocator) {
+        Indices idx(m.size(), allocator);
+        std::iota(idx.begin(), idx.end(), 0);
 
-std::vector<float> tuner::interpolate(std::vector<float> in_x, std::vector<float> in_xp, std::array<float, TUNER_SIZE / 2> in_fp) {
+        const auto function = [&](int i1, int i2)
+        noexcept->
+        bool{
+            return m[i1] < m[i2];
+        };
 
-    if (in_xp.size() != in_fp.size()) {
-        throw tuner::UnequalLengthException();
+        std::stable_sort(idx.begin(), idx.end(), function);
+        return idx;
     }
 
-    std::vector <uint32_t> sorted_xp_idxs = tuner::sort(in_xp);
-    auto sorted_xp = std::vector<float>(in_fp.size());
-    auto sorted_fp = std::vector<float>(in_fp.size());
-    uint32_t counter = 0;
+    template<typename Floats, typename Indices>
+    Floats interpolate_values(const Floats &in_x, const Floats &in_xp, const std::array<float, TUNER_SIZE / 2> &in_fp,
+                              const typename Floats::allocator_type &allocator) {
 
-    for (auto sorted_xp_idx: sorted_xp_idxs) {
-        sorted_xp[counter] = in_xp[sorted_xp_idx];
-        sorted_fp[counter++] = in_fp[sorted_xp_idx];
-    }
+        if (in_xp.size() != in_fp.size()) {
+            throw tuner::UnequalLengthException();
+        }
+
+        Indices sorted_xp_idxs = sort_indices<Indices>(in_xp, allocator);
+        Floats sorted_xp(in_fp.size(), allocator);
+        Floats sorted_fp(in_fp.size(), allocator);
+        uint32_t counter = 0;
+
+        for (auto sorted_xp_idx: sorted_xp_idxs) {
+            sorted_xp[counter] = in_xp[sorted_xp_idx];
+            sorted_fp[counter++] = in_fp[sorted_xp_idx];
+        }
 
-    std::vector <uint32_t> sorted_x_idxs = tuner::sort(in_x);
-    auto out = std::vector<float>(in_x.size());
-
-    uint32_t curr_x_index = 0;
-    uint32_t curr_xp_index = 0;
-    while (curr_x_index < in_x.size()) {
-        const auto sorted_x_idx = sorted_x_idxs[curr_x_index];
-        const auto x = in_x[sorted_x_idx];
-        const auto xp_low = sorted_xp[curr_xp_index];
-        const auto xp_high = sorted_xp[curr_xp_index + 1];
-        const auto fp_low = sorted_fp[curr_xp_index];
-        const auto fp_high = sorted_fp[curr_xp_index + 1];
-
-        if (curr_xp_index >= (sorted_xp.size() - 1)) {
-            out[sorted_x_idx] = fp_low;
-            ++curr_x_index;
-        } else {
-            if (xp_low <= x && x <= xp_high) {
-                const double percent = static_cast<double>(x - xp_low) / static_cast<double>(xp_high - xp_low);
-                out[sorted_x_idx] = fp_low * (1. - percent) + fp_high * percent;
+        Indices sorted_x_idxs = sort_indices<Indices>(in_x, allocator);
+        Floats out(in_x.size(), allocator);
+
+        uint32_t curr_x_index = 0;
+        uint32_t curr_xp_index = 0;
+        while (curr_x_index < in_x.size()) {
+            const auto sorted_x_idx = sorted_x_idxs[curr_x_index];
+            const auto x = in_x[sorted_x_idx];
+            const auto xp_low = sorted_xp[curr_xp_index];
+            const auto xp_high = sorted_xp[curr_xp_index + 1];
+            const auto fp_low = sorted_fp[curr_xp_index];
+            const auto fp_high = sorted_fp[curr_xp_index + 1];
+
+            if (curr_xp_index >= (sorted_xp.size() - 1)) {
+                out[sorted_x_idx] = fp_low;
                 ++curr_x_index;
             } else {
-                ++curr_xp_index;
+                if (xp_low <= x && x <= xp_high) {
+                    const double percent = static_cast<double>(x - xp_low) / static_cast<double>(xp_high - xp_low);
+                    out[sorted_x_idx] = fp_low * (1. - percent) + fp_high * percent;
+                    ++curr_x_index;
+                } else {
+                    ++curr_xp_index;
+                }
             }
         }
+
+        return out;
     }
+}
+
+std::vector<float> tuner::new_vector_with_values_between(int start, int end, float step) {
+    return values_between<std::vector<float>>(start, end, step, {});
+}
+
+std::pmr::vector<float>
+tuner::new_vector_with_values_between(int start, int end, float step, std::pmr::memory_resource *resource) {
+    return values_between<std::pmr::vector<float>>(start, end, step, resource);
+}
+
+std::vector<uint32_t> tuner::sort(std::vector<float> m) {
+    return sort_indices<std::vector<uint32_t>>(m, {});
+}
+
+std::pmr::vector<uint32_t> tuner::sort(const std::pmr::vector<float> &m, std::pmr::memory_resource *resource) {
+    return sort_indices<std::pmr::vector<uint32_t>>(m, resource);
+}
+
+std::vector<float> tuner::interpolate(std::vector<float> in_x, std::vector<float> in_xp, std::array<float, TUNER_SIZE / 2> in_fp) {
+    return interpolate_values<std::vector<float>, std::vector<uint32_t>>(in_x, in_xp, in_fp, {});
+}
 
-    return out;
+std::pmr::vector<float>
+tuner::interpolate(const std::pmr::vector<float> &in_x, const std::pmr::vector<float> &in_xp,
+                   const std::array<float, TUNER_SIZE / 2> &in_fp, std::pmr::memory_resource *resource) {
+    return interpolate_values<std::pmr::vector<float>, std::pmr::vector<uint32_t>>(in_x, in_xp, in_fp, resource);
 }
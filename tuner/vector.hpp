@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <array>
+#include <memory_resource>
 
 #include <tuner/global.hpp>
 
@@ -32,6 +33,12 @@ namespace tuner {
      */
     std::vector<float> new_vector_with_values_between(int start, int end, float step = 1);
 
+    /**
+     * @brief new_vector_with_values_between, allocating the result from 'resource', e.g. a per-frame arena.
+     */
+    std::pmr::vector<float>
+    new_vector_with_values_between(int start, int end, float step, std::pmr::memory_resource *resource);
+
     /**
      * @brief Sorts the elements of the input std::vector<float> in ascending order and returns a new std::vector<uint32_t>
      *        containing the indices of the sorted elements.
@@ -42,6 +49,11 @@ namespace tuner {
      */
     std::vector<uint32_t> sort(std::vector<float> m);
 
+    /**
+     * @brief sort, allocating the indices from 'resource' and without copying 'm'.
+     */
+    std::pmr::vector<uint32_t> sort(const std::pmr::vector<float> &m, std::pmr::memory_resource *resource);
+
     /**
      * @brief Interpolates the values in 'in_fp' based on the given 'in_x' and 'in_xp' vectors using linear interpolation,
      *        and returns a new std::vector<float> containing the interpolated values.
@@ -55,6 +67,13 @@ namespace tuner {
      */
     std::vector<float>
     interpolate(std::vector<float> in_x, std::vector<float> in_xp, std::array<float, TUNER_SIZE / 2> in_fp);
+
+    /**
+     * @brief interpolate, allocating the result and every temporary from 'resource' and without copying the inputs.
+     */
+    std::pmr::vector<float>
+    interpolate(const std::pmr::vector<float> &in_x, const std::pmr::vector<float> &in_xp,
+                const std::array<float, TUNER_SIZE / 2> &in_fp, std::pmr::memory_resource *resource);
 }
 
 #endif //TUNER_VECTOR_H
@@ -185,3 +185,30 @@ TEST_CASE("[interpolate] x contains index of unknown fp value (between N-1 and N
     REQUIRE(result.size() == 1);
     REQUIRE(result[0] == 5.0f);
 }
+
+TEST_CASE("[interpolate | pmr] matches interpolate and allocates from the resource") {
+    std::array<float, TUNER_SIZE / 2> fp{};
+    for (int i = 0; i < int(fp.size()); i++) {
+        fp[i] = float((i * 37) % 101) / 100.0f;
+    }
+    std::vector<float> expected = tuner::interpolate(tuner::new_vector_with_values_between(0, fp.size(), 0.2f),
+                                                     tuner::new_vector_with_values_between(0, fp.size()), fp);
+
+    std::array<std::byte, 128 * 1024> buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::pmr::vector<float> result = tuner::interpolate(tuner::new_vector_with_values_between(0, fp.size(), 0.2f, &arena),
+                                                        tuner::new_vector_with_values_between(0, fp.size(), 1, &arena),
+                                                        fp, &arena);
+
+    REQUIRE(result.get_allocator().resource() == &arena);
+    REQUIRE(std::vector<float>(result.begin(), result.end()) == expected);
+}
+
+TEST_CASE("[sort | pmr] matches sort") {
+    std::vector<float> m = {3.0f, 1.0f, 2.0f, 1.0f};
+    std::pmr::vector<float> pmr_m(m.begin(), m.end());
+
+    std::pmr::vector<uint32_t> result = tuner::sort(pmr_m, std::pmr::get_default_resource());
+    std::vector<uint32_t> expected = tuner::sort(m);
+    REQUIRE(std::vector<uint32_t>(result.begin(), result.end()) == expected);
+}
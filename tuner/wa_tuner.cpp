@@ -1,8 +1,30 @@
+#include <algorithm>
+#include <memory>
+
+#include <tuner/engine.hpp>
+#include <tuner/kernels.hpp>
 #include <tuner/tuner.hpp>
 #include <tuner/wa_tuner.hpp>
 
+namespace {
+    alignas(16) float BLOCK_BUFFER[WA_BLOCK_CAPACITY] = {0};
+
+    // the latest TUNER_SIZE samples, oldest first starting at HISTORY_INDEX
+    std::array<float, TUNER_SIZE> HISTORY = {0};
+    int HISTORY_INDEX = 0;
+    int HISTORY_FILL = 0;
+    int SAMPLES_SINCE_ANALYSIS = 0;
+    float LAST_FREQUENCY = -1;
+    float LAST_CONFIDENCE = 0;
+
+    std::unique_ptr<tuner::engine> BLOCK_ENGINE;
+}
+
 EXTERN float get_frequency(int sample_rate) {
-    return tuner::tune(AUDIO_SAMPLES, sample_rate)->actual_frequency;
+    tuner::note_context *nc = tuner::tune(AUDIO_SAMPLES, sample_rate);
+    float frequency = nc->actual_frequency;
+    delete nc;
+    return frequency;
 }
 
 EXTERN void push_value(float audio_sample) {
@@ -12,4 +34,64 @@ EXTERN void push_value(float audio_sample) {
 
 EXTERN void clear_buffer_offset() {
     AUDIO_SAMPLE_INDEX = 0;
-}
\ No newline at end of file
+}
+
+EXTERN float *get_block_buffer() {
+    return BLOCK_BUFFER;
+}
+
+EXTERN int get_block_capacity() {
+    return WA_BLOCK_CAPACITY;
+}
+
+EXTERN float analyze_block(int length, int sample_rate) {
+    if (length < 0 || length > WA_BLOCK_CAPACITY || sample_rate <= 0) {
+        LAST_CONFIDENCE = 0;
+        return -1;
+    }
+
+    for (int i = 0; i < length; i++) {
+        HISTORY[HISTORY_INDEX] = BLOCK_BUFFER[i];
+        HISTORY_INDEX = (HISTORY_INDEX + 1) % TUNER_SIZE;
+    }
+    HISTORY_FILL = std::min(TUNER_SIZE, HISTORY_FILL + length);
+    SAMPLES_SINCE_ANALYSIS += length;
+
+    if (HISTORY_FILL < TUNER_SIZE || SAMPLES_SINCE_ANALYSIS < WA_ANALYSIS_HOP) {
+        return HISTORY_FILL < TUNER_SIZE ? -1 : LAST_FREQUENCY;
+    }
+    SAMPLES_SINCE_ANALYSIS = 0;
+
+    if (!BLOCK_ENGINE || BLOCK_ENGINE->sample_rate() != sample_rate) {
+        BLOCK_ENGINE = std::make_unique<tuner::engine>(sample_rate);
+    }
+
+    // unroll the ring and window it straight into the FFT input, oldest segment first
+    const float *window = BLOCK_ENGINE->window().data();
+    float *in = BLOCK_ENGINE->input();
+    int oldest = TUNER_SIZE - HISTORY_INDEX;
+    float power = tuner::apply_window_and_sum_squares(HISTORY.data() + HISTORY_INDEX, window, in, oldest);
+    power += tuner::apply_window_and_sum_squares(HISTORY.data(), window + oldest, in + oldest, HISTORY_INDEX);
+
+    tuner::note_context n = BLOCK_ENGINE->process_windowed(power / float(TUNER_SIZE));
+    LAST_FREQUENCY = n.actual_frequency;
+    LAST_CONFIDENCE = n.confidence;
+    return LAST_FREQUENCY;
+}
+
+EXTERN float get_block_confidence() {
+    return LAST_CONFIDENCE;
+}
+
+EXTERN int uses_simd() {
+    return tuner::kernels_use_simd() ? 1 : 0;
+}
+
+EXTERN void clear_block_history() {
+    HISTORY.fill(0);
+    HISTORY_INDEX = 0;
+    HISTORY_FILL = 0;
+    SAMPLES_SINCE_ANALYSIS = 0;
+    LAST_FREQUENCY = -1;
+    LAST_CONFIDENCE = 0;
+}
@@ -6,9 +6,22 @@
 
 #define EXTERN extern "C"
 
+// the most samples a single analyze_block call accepts, enough for any AudioWorklet render quantum
+#define WA_BLOCK_CAPACITY TUNER_SIZE
+
+// samples the analysis window has to advance before analyze_block runs the pipeline again
+#define WA_ANALYSIS_HOP (TUNER_SIZE / 4)
+
 static std::array<float, TUNER_SIZE> AUDIO_SAMPLES = {0};
 static int AUDIO_SAMPLE_INDEX = 0;
 
+/**
+ * @brief Performs tuning on the samples pushed with push_value.
+ *
+ * @param sample_rate The sample rate of the pushed samples.
+ *
+ * @return The detected frequency, or -1 when the signal energy is too low.
+ */
 EXTERN float get_frequency(int sample_rate);
 
 /**
@@ -28,4 +41,50 @@ EXTERN void push_value(float audio_sample);
  * @return None.
  */
 EXTERN void clear_buffer_offset();
+
+/**
+ * @brief The preallocated, 16-byte aligned input region of WA_BLOCK_CAPACITY floats in linear memory.
+ *
+ * JavaScript writes a block of samples here, e.g. through a Float32Array view on HEAPF32, and then calls analyze_block.
+ * The address never changes, so the view can be created once.
+ *
+ * @return A pointer to the first float of the input region.
+ */
+EXTERN float *get_block_buffer();
+
+/**
+ * @return The number of floats the input region holds, WA_BLOCK_CAPACITY.
+ */
+EXTERN int get_block_capacity();
+
+/**
+ * @brief Appends the first 'length' samples of the input region to the analysis window and tunes the latest
+ *        TUNER_SIZE samples.
+ *
+ * The pipeline only runs once the window has advanced by WA_ANALYSIS_HOP samples since the last analysis; calls in
+ * between return the previous result. The FFT plan is kept between calls and rebuilt when 'sample_rate' changes.
+ *
+ * @param length The number of samples written into the input region, at most WA_BLOCK_CAPACITY.
+ * @param sample_rate The sample rate of the samples.
+ *
+ * @return The detected frequency, or -1 while fewer than TUNER_SIZE samples were seen, when the signal energy is too
+ *         low or when 'length' or 'sample_rate' are invalid.
+ */
+EXTERN float analyze_block(int length, int sample_rate);
+
+/**
+ * @return The confidence of the frequency last returned by analyze_block, from 0 (noise) to 1 (a clean harmonic tone),
+ *         see tuner::pitch_confidence. 0 while analyze_block returns -1.
+ */
+EXTERN float get_block_confidence();
+
+/**
+ * @brief Drops the samples collected by analyze_block, e.g. after the input device changed.
+ */
+EXTERN void clear_block_history();
+
+/**
+ * @return 1 if this module was built with the SIMD128 kernels, 0 for the scalar build.
+ */
+EXTERN int uses_simd();
 #endif //TUNER_WA_TUNER_H
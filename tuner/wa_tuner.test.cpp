@@ -0,0 +1,66 @@
+#include <array>
+#include <cmath>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/engine.hpp>
+#include <tuner/test_signals.hpp>
+#include <tuner/wa_tuner.hpp>
+
+TEST_CASE("[wa_tuner] block buffer is aligned and sized") {
+    REQUIRE(reinterpret_cast<uintptr_t>(get_block_buffer()) % 16 == 0);
+    REQUIRE(get_block_capacity() == WA_BLOCK_CAPACITY);
+}
+
+TEST_CASE("[wa_tuner] analyze_block rejects invalid arguments") {
+    clear_block_history();
+    REQUIRE(analyze_block(-1, 48000) == -1);
+    REQUIRE(analyze_block(WA_BLOCK_CAPACITY + 1, 48000) == -1);
+    REQUIRE(analyze_block(128, 0) == -1);
+}
+
+TEST_CASE("[wa_tuner] analyze_block matches the engine on the latest samples") {
+    constexpr int sample_rate = 48000;
+    constexpr int quantum = 128;
+    clear_block_history();
+
+    int position = 0;
+    float frequency = -1;
+    for (int block = 0; block < (TUNER_SIZE + WA_ANALYSIS_HOP) / quantum; block++) {
+        float *buffer = get_block_buffer();
+        for (int i = 0; i < quantum; i++) {
+            buffer[i] = tuner::test::harmonic_sample(110.0f, sample_rate, position + i);
+        }
+        position += quantum;
+        frequency = analyze_block(quantum, sample_rate);
+        if (position < TUNER_SIZE) {
+            REQUIRE(frequency == -1);
+        }
+    }
+
+    std::array<float, TUNER_SIZE> latest = {};
+    for (int i = 0; i < TUNER_SIZE; i++) {
+        latest[i] = tuner::test::harmonic_sample(110.0f, sample_rate, position - TUNER_SIZE + i);
+    }
+    tuner::engine e(sample_rate);
+    REQUIRE(std::abs(frequency - e.process(latest).actual_frequency) < 1e-3f);
+    REQUIRE(frequency > 100);
+    REQUIRE(frequency < 120);
+}
+
+TEST_CASE("[wa_tuner] analyze_block reuses the last result between hops") {
+    clear_block_history();
+    float *buffer = get_block_buffer();
+    for (int i = 0; i < WA_BLOCK_CAPACITY; i++) {
+        buffer[i] = tuner::test::harmonic_sample(196.0f, 48000, i);
+    }
+    float first = analyze_block(WA_BLOCK_CAPACITY, 48000);
+
+    // a block shorter than the hop must not trigger another analysis, even if it is silent
+    for (int i = 0; i < 128; i++) {
+        buffer[i] = 0;
+    }
+    REQUIRE(analyze_block(128, 48000) == first);
+
+    clear_block_history();
+    REQUIRE(analyze_block(128, 48000) == -1);
+}
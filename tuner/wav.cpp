@@ -0,0 +1,184 @@
+#include <cstring>
+#include <deque>
+#include <utility>
+
+#include <tuner/wav.hpp>
+
+namespace {
+    constexpr uint16_t WAVE_FORMAT_PCM = 1;
+    constexpr uint16_t WAVE_FORMAT_IEEE_FLOAT = 3;
+    constexpr uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+    uint16_t read_u16(const uint8_t *p) {
+        return uint16_t(p[0] | (p[1] << 8));
+    }
+
+    uint32_t read_u32(const uint8_t *p) {
+        return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    uint64_t read_u64(const uint8_t *p) {
+        return uint64_t(read_u32(p)) | (uint64_t(read_u32(p + 4)) << 32);
+    }
+
+    bool has_id(const uint8_t *p, const char *id) {
+        return std::memcmp(p, id, 4) == 0;
+    }
+}
+
+tuner::wav_file::wav_file(const std::string &file_path) : file(file_path), wav(), data_offset(0) {
+    const uint8_t *p = file.data();
+    size_t size = file.size();
+    if (size < 12 || !(has_id(p, "RIFF") || has_id(p, "RF64")) || !has_id(p + 8, "WAVE")) {
+        throw tuner::WavFormatException();
+    }
+
+    bool is_rf64 = has_id(p, "RF64");
+    uint64_t rf64_data_size = 0;
+    bool has_format = false;
+    uint16_t format_tag = 0;
+    int bits_per_sample = 0;
+    uint64_t data_size = 0;
+
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t *chunk = p + offset;
+        uint64_t chunk_size = read_u32(chunk + 4);
+        size_t body = offset + 8;
+
+        if (has_id(chunk, "ds64") && chunk_size >= 16 && body + 16 <= size) {
+            rf64_data_size = read_u64(p + body + 8);
+        } else if (has_id(chunk, "fmt ") && chunk_size >= 16 && body + 16 <= size) {
+            format_tag = read_u16(p + body);
+            wav.channels = read_u16(p + body + 2);
+            wav.sample_rate = int(read_u32(p + body + 4));
+            wav.block_align = read_u16(p + body + 12);
+            bits_per_sample = read_u16(p + body + 14);
+            if (format_tag == WAVE_FORMAT_EXTENSIBLE && chunk_size >= 26 && body + 26 <= size) {
+                // the first two bytes of the sub format GUID hold the actual format tag
+                format_tag = read_u16(p + body + 24);
+            }
+            has_format = true;
+        } else if (has_id(chunk, "data")) {
+            data_offset = body;
+            data_size = (is_rf64 && chunk_size == 0xFFFFFFFF) ? rf64_data_size : chunk_size;
+            break;
+        }
+
+        // chunks are padded to an even size
+        offset = body + size_t(chunk_size) + size_t(chunk_size & 1);
+    }
+
+    if (!has_format || data_offset == 0 || wav.channels <= 0 || wav.sample_rate <= 0) {
+        throw tuner::WavFormatException();
+    }
+
+    if (format_tag == WAVE_FORMAT_PCM && bits_per_sample == 16) {
+        wav.format = tuner::sample_format::pcm_s16;
+    } else if (format_tag == WAVE_FORMAT_PCM && bits_per_sample == 24) {
+        wav.format = tuner::sample_format::pcm_s24;
+    } else if (format_tag == WAVE_FORMAT_PCM && bits_per_sample == 32) {
+        wav.format = tuner::sample_format::pcm_s32;
+    } else if (format_tag == WAVE_FORMAT_IEEE_FLOAT && bits_per_sample == 32) {
+        wav.format = tuner::sample_format::float32;
+    } else {
+        throw tuner::WavFormatException();
+    }
+
+    wav.bytes_per_sample = bits_per_sample / 8;
+    if (wav.block_align < wav.bytes_per_sample * wav.channels) {
+        throw tuner::WavFormatException();
+    }
+
+    // recorders that were interrupted leave a data size that runs past the end of the file
+    if (data_size > size - data_offset) {
+        data_size = size - data_offset;
+    }
+    wav.frame_count = data_size / uint64_t(wav.block_align);
+}
+
+void tuner::wav_file::release(uint64_t from_frame, uint64_t to_frame) const {
+    if (to_frame > from_frame) {
+        file.release(data_offset + from_frame * wav.block_align, (to_frame - from_frame) * wav.block_align);
+    }
+}
+
+uint64_t tuner::analyze_wav(const tuner::wav_file &wav, tuner::engine &e, const tuner::wav_analysis_config &config,
+                            const std::function<void(const tuner::pitch_point &)> &sink) {
+    const tuner::wav_info &info = wav.info();
+    if (e.sample_rate() != info.sample_rate) {
+        throw tuner::InvalidSampleRateException();
+    }
+    if (config.hop_size <= 0 || config.channel < -1 || config.channel >= info.channels) {
+        throw tuner::WavFormatException();
+    }
+
+    tuner::pcm_layout layout;
+    layout.format = info.format;
+    layout.channels = info.channels;
+    layout.channel = config.channel;
+    layout.block_align = info.block_align;
+
+    uint64_t frames = 0;
+    uint64_t released_to = 0;
+    for (uint64_t start = 0; start + TUNER_SIZE <= info.frame_count; start += uint64_t(config.hop_size)) {
+        const uint8_t *frame = wav.samples() + start * info.block_align;
+        float signal_power = tuner::convert_and_window(frame, layout, e.window().data(), e.input(), TUNER_SIZE);
+
+        tuner::pitch_point point;
+        point.sample_offset = start;
+        point.time_seconds = double(start) / double(info.sample_rate);
+        point.note = e.process_windowed(signal_power);
+        sink(point);
+        frames++;
+
+        // everything before the next frame has been consumed
+        uint64_t next = start + uint64_t(config.hop_size);
+        if (next - released_to >= config.chunk_frames) {
+            wav.release(released_to, next);
+            released_to = next;
+        }
+    }
+
+    return frames;
+}
+
+uint64_t tuner::track_wav(const tuner::wav_file &wav, tuner::engine &e, const tuner::wav_analysis_config &config,
+                          const tuner::tracker_config &tracking,
+                          const std::function<void(const tuner::pitch_point &)> &sink) {
+    // the points the tracker has not decided yet, never more than lag + block of them
+    std::deque<tuner::pitch_point> pending;
+    tuner::pitch_tracker tracker(tracking, [&pending, &sink](const tuner::tracked_pitch &decided) {
+        tuner::pitch_point point = std::move(pending.front());
+        pending.pop_front();
+        if (decided.rank > 0) {
+            tuner::note_match match = tuner::note_table<>::match(decided.frequency);
+            point.note.name = match.name;
+            point.note.closest_note_frequency = match.closest_note_frequency;
+            point.note.actual_frequency = decided.frequency;
+        }
+        sink(point);
+    });
+    e.set_candidate_count(tracking.candidates);
+
+    uint64_t frames = tuner::analyze_wav(wav, e, config, [&pending, &tracker, &e](const tuner::pitch_point &point) {
+        pending.push_back(point);
+        tracker.push(e.candidates().data(), int(e.candidates().size()));
+    });
+    tracker.finish();
+
+    return frames;
+}
+
+std::vector<tuner::pitch_point>
+tuner::analyze_wav_file(const std::string &file_path, const tuner::wav_analysis_config &config) {
+    tuner::wav_file wav(file_path);
+    tuner::engine e(wav.info().sample_rate);
+
+    std::vector<tuner::pitch_point> track;
+    tuner::analyze_wav(wav, e, config, [&track](const tuner::pitch_point &point) {
+        track.push_back(point);
+    });
+
+    return track;
+}
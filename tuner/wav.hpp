@@ -0,0 +1,134 @@
+#ifndef TUNER_WAV_H
+#define TUNER_WAV_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <tuner/engine.hpp>
+#include <tuner/global.hpp>
+#include <tuner/mapped_file.hpp>
+#include <tuner/note.hpp>
+#include <tuner/pcm.hpp>
+#include <tuner/pitch_tracker.hpp>
+
+namespace tuner {
+
+    struct WavFormatException : public std::exception {
+        [[nodiscard]] const char* what() const noexcept override {
+            return "Wav format exception";
+        }
+    };
+
+    struct wav_info {
+        tuner::sample_format format;
+        int channels;
+        int sample_rate;
+        int bytes_per_sample;
+        int block_align;
+        uint64_t frame_count;
+    };
+
+    /**
+     * @brief A memory-mapped RIFF/WAVE or RF64 file holding 16, 24 or 32 bit integer PCM or 32 bit float samples.
+     */
+    class wav_file {
+    public:
+        /**
+         * @param file_path The path to the WAV file.
+         *
+         * @throws FileOpenException If the file cannot be opened.
+         * @throws WavFormatException If the file is not a WAV file or uses an unsupported sample format.
+         */
+        explicit wav_file(const std::string &file_path);
+
+        [[nodiscard]] const tuner::wav_info &info() const { return wav; }
+
+        [[nodiscard]] double duration_seconds() const { return double(wav.frame_count) / double(wav.sample_rate); }
+
+        /**
+         * @brief The first byte of the interleaved sample data.
+         */
+        [[nodiscard]] const uint8_t *samples() const { return file.data() + data_offset; }
+
+        /**
+         * @brief Drops the pages of the sample frames [from_frame, to_frame) from memory.
+         */
+        void release(uint64_t from_frame, uint64_t to_frame) const;
+
+    private:
+        tuner::mapped_file file;
+        tuner::wav_info wav;
+        size_t data_offset;
+    };
+
+    struct wav_analysis_config {
+        // samples between the starts of two consecutive frames
+        int hop_size = TUNER_SIZE / 2;
+        // channel to analyze, -1 averages all channels
+        int channel = 0;
+        // sample frames read between two releases of already analyzed pages
+        uint64_t chunk_frames = uint64_t(1) << 20;
+    };
+
+    struct pitch_point {
+        uint64_t sample_offset;
+        double time_seconds;
+        tuner::note_context note;
+    };
+
+    /**
+     * @brief Analyzes a WAV file frame by frame, handing each result to 'sink' as soon as it is available.
+     *
+     * Samples are converted, mixed and windowed in a single pass by tuner::convert_and_window straight into the engine's
+     * FFT input. Pages behind the
+     * current frame are released every 'chunk_frames' sample frames, so memory use stays bounded regardless of the file size.
+     *
+     * @param wav The file to analyze.
+     * @param e The engine to analyze with. Its sample rate has to match the file's.
+     * @param config The hop size, channel and chunk size.
+     * @param sink Receives one pitch_point per analyzed frame, in file order.
+     *
+     * @return The number of analyzed frames.
+     * @throws InvalidSampleRateException If the engine's sample rate differs from the file's.
+     * @throws WavFormatException If 'config' selects a channel the file does not have or a non-positive hop size.
+     */
+    uint64_t analyze_wav(const tuner::wav_file &wav, tuner::engine &e, const tuner::wav_analysis_config &config,
+                         const std::function<void(const tuner::pitch_point &)> &sink);
+
+    /**
+     * @brief Analyzes a WAV file like analyze_wav, but chooses the pitch of every frame among the HPS candidates with a
+     *        tuner::pitch_tracker instead of taking the highest one, so isolated octave errors are smoothed out.
+     *
+     * Each frame reaches 'sink' once the tracker has decided it, at most 'lag' + 'block' frames after it was analyzed;
+     * only those frames are held in memory. A frame whose pitch the tracker moved to another candidate gets the note of
+     * that candidate and keeps its confidence. Frames without candidates, e.g. "LOW" frames and skipped transients, are
+     * passed on unchanged.
+     *
+     * @param wav The file to analyze.
+     * @param e The engine to analyze with. Its sample rate has to match the file's. Its candidate count is set to
+     *          tracking.candidates.
+     * @param config The hop size, channel and chunk size.
+     * @param tracking The candidates, the jump penalty and the block sizes of the tracker.
+     * @param sink Receives one pitch_point per analyzed frame, in file order.
+     *
+     * @return The number of analyzed frames.
+     * @throws InvalidSampleRateException If the engine's sample rate differs from the file's.
+     * @throws InvalidConfigurationException If 'tracking' is invalid, see tuner::pitch_tracker.
+     * @throws WavFormatException If 'config' selects a channel the file does not have or a non-positive hop size.
+     */
+    uint64_t track_wav(const tuner::wav_file &wav, tuner::engine &e, const tuner::wav_analysis_config &config,
+                       const tuner::tracker_config &tracking,
+                       const std::function<void(const tuner::pitch_point &)> &sink);
+
+    /**
+     * @brief Analyzes the WAV file at 'file_path' and collects the whole pitch track.
+     *
+     * @return A std::vector<pitch_point> with one entry per analyzed frame.
+     */
+    std::vector<tuner::pitch_point>
+    analyze_wav_file(const std::string &file_path, const tuner::wav_analysis_config &config = {});
+}
+
+#endif //TUNER_WAV_H
@@ -0,0 +1,226 @@
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/wav.hpp>
+#include <tuner/test_signals.hpp>
+
+std::string wav_test_path(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / ("tuner-wav-test-" + name)).string();
+}
+
+void append_u16(std::vector<uint8_t> &out, uint16_t v) {
+    out.push_back(uint8_t(v));
+    out.push_back(uint8_t(v >> 8));
+}
+
+void append_u32(std::vector<uint8_t> &out, uint32_t v) {
+    append_u16(out, uint16_t(v));
+    append_u16(out, uint16_t(v >> 16));
+}
+
+void write_wav(const std::string &path, uint16_t format_tag, int channels, int sample_rate, int bits_per_sample,
+               const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> out;
+    out.insert(out.end(), {'R', 'I', 'F', 'F'});
+    append_u32(out, uint32_t(4 + 8 + 16 + 8 + 4 + 8 + data.size()));
+    out.insert(out.end(), {'W', 'A', 'V', 'E'});
+    out.insert(out.end(), {'f', 'm', 't', ' '});
+    append_u32(out, 16);
+    append_u16(out, format_tag);
+    append_u16(out, uint16_t(channels));
+    append_u32(out, uint32_t(sample_rate));
+    append_u32(out, uint32_t(sample_rate * channels * bits_per_sample / 8));
+    append_u16(out, uint16_t(channels * bits_per_sample / 8));
+    append_u16(out, uint16_t(bits_per_sample));
+    // an unknown chunk that has to be skipped
+    out.insert(out.end(), {'L', 'I', 'S', 'T'});
+    append_u32(out, 4);
+    out.insert(out.end(), {'I', 'N', 'F', 'O'});
+    out.insert(out.end(), {'d', 'a', 't', 'a'});
+    append_u32(out, uint32_t(data.size()));
+    out.insert(out.end(), data.begin(), data.end());
+
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(out.data()), std::streamsize(out.size()));
+}
+
+// 16 bit stereo: silence on the left channel, a harmonic tone on the right channel
+std::vector<uint8_t> stereo_tone(float frequency, int sample_rate, int frames) {
+    std::vector<uint8_t> data;
+    for (int i = 0; i < frames; i++) {
+        float v = tuner::test::harmonic_sample(frequency, sample_rate, i);
+        append_u16(data, 0);
+        append_u16(data, uint16_t(int16_t(v * 32767.0f)));
+    }
+
+    return data;
+}
+
+TEST_CASE("[wav_file] format of a 16 bit stereo file") {
+    std::string path = wav_test_path("format.wav");
+    write_wav(path, 1, 2, 44100, 16, stereo_tone(110, 44100, 100));
+
+    tuner::wav_file wav(path);
+    REQUIRE(wav.info().format == tuner::sample_format::pcm_s16);
+    REQUIRE(wav.info().channels == 2);
+    REQUIRE(wav.info().sample_rate == 44100);
+    REQUIRE(wav.info().block_align == 4);
+    REQUIRE(wav.info().frame_count == 100);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[wav_file] file is not a wav file") {
+    std::string path = wav_test_path("not-a-wav.wav");
+    std::ofstream(path) << "this is not a wav file";
+
+    try {
+        tuner::wav_file wav(path);
+        REQUIRE(false);
+    } catch (tuner::WavFormatException &we) {
+        REQUIRE(std::string(we.what()) == "Wav format exception");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[wav_file] unsupported 8 bit samples") {
+    std::string path = wav_test_path("8-bit.wav");
+    write_wav(path, 1, 1, 8000, 8, std::vector<uint8_t>(16, 128));
+
+    try {
+        tuner::wav_file wav(path);
+        REQUIRE(false);
+    } catch (tuner::WavFormatException &we) {
+        REQUIRE(std::string(we.what()) == "Wav format exception");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[analyze_wav_file] pitch track of a tone on the second channel") {
+    std::string path = wav_test_path("tone.wav");
+    int frames = TUNER_SIZE * 4;
+    write_wav(path, 1, 2, 48000, 16, stereo_tone(110, 48000, frames));
+
+    tuner::wav_analysis_config config;
+    config.hop_size = TUNER_SIZE / 2;
+    config.channel = 1;
+    std::vector<tuner::pitch_point> track = tuner::analyze_wav_file(path, config);
+
+    REQUIRE(track.size() == size_t((frames - TUNER_SIZE) / config.hop_size + 1));
+    REQUIRE(track[1].sample_offset == TUNER_SIZE / 2);
+    REQUIRE(std::abs(track[1].time_seconds - double(TUNER_SIZE / 2) / 48000.0) < 1e-9);
+    for (const tuner::pitch_point &point: track) {
+        REQUIRE(std::abs(point.note.actual_frequency - 110.0f) < 10.0f);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[analyze_wav_file] silent channel is gated") {
+    std::string path = wav_test_path("silence.wav");
+    write_wav(path, 1, 2, 48000, 16, stereo_tone(110, 48000, TUNER_SIZE));
+
+    std::vector<tuner::pitch_point> track = tuner::analyze_wav_file(path);
+    REQUIRE(track.size() == 1);
+    REQUIRE(track[0].note.name == "LOW");
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[analyze_wav_file] file is shorter than one frame") {
+    std::string path = wav_test_path("short.wav");
+    write_wav(path, 1, 2, 48000, 16, stereo_tone(110, 48000, TUNER_SIZE - 1));
+
+    REQUIRE(tuner::analyze_wav_file(path).empty());
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[analyze_wav] channel does not exist") {
+    std::string path = wav_test_path("channel.wav");
+    write_wav(path, 1, 2, 48000, 16, stereo_tone(110, 48000, TUNER_SIZE));
+
+    tuner::wav_file wav(path);
+    tuner::engine e(48000);
+    tuner::wav_analysis_config config;
+    config.channel = 2;
+    try {
+        tuner::analyze_wav(wav, e, config, [](const tuner::pitch_point &) {});
+        REQUIRE(false);
+    } catch (tuner::WavFormatException &we) {
+        REQUIRE(std::string(we.what()) == "Wav format exception");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[analyze_wav] engine sample rate differs from the file") {
+    std::string path = wav_test_path("rate.wav");
+    write_wav(path, 1, 2, 48000, 16, stereo_tone(110, 48000, TUNER_SIZE));
+
+    tuner::wav_file wav(path);
+    tuner::engine e(44100);
+    try {
+        tuner::analyze_wav(wav, e, {}, [](const tuner::pitch_point &) {});
+        REQUIRE(false);
+    } catch (tuner::InvalidSampleRateException &ie) {
+        REQUIRE(std::string(ie.what()) == "Invalid sample rate exception");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("[track_wav] keeps the frames of analyze_wav and fixes the one the next tone starts in") {
+    std::string path = wav_test_path("track.wav");
+    // A2, two frames of silence and E4, an octave and a fifth higher; a sample frame is 4 bytes
+    std::vector<uint8_t> data = stereo_tone(110, 48000, TUNER_SIZE * 6);
+    std::vector<uint8_t> gap(size_t(TUNER_SIZE) * 2 * 4, 0);
+    std::vector<uint8_t> higher = stereo_tone(330, 48000, TUNER_SIZE * 6);
+    data.insert(data.end(), gap.begin(), gap.end());
+    data.insert(data.end(), higher.begin(), higher.end());
+    write_wav(path, 1, 2, 48000, 16, data);
+
+    tuner::wav_file wav(path);
+    tuner::wav_analysis_config config;
+    config.channel = 1;
+    tuner::engine e(48000);
+    std::vector<tuner::pitch_point> expected;
+    tuner::analyze_wav(wav, e, config, [&expected](const tuner::pitch_point &point) { expected.push_back(point); });
+
+    tuner::tracker_config tracking;
+    tracking.lag = 3;
+    tracking.block = 2;
+    std::vector<tuner::pitch_point> track;
+    uint64_t frames = tuner::track_wav(wav, e, config, tracking, [&track](const tuner::pitch_point &point) {
+        track.push_back(point);
+    });
+
+    REQUIRE(frames == expected.size());
+    REQUIRE(track.size() == expected.size());
+    int fixed = 0;
+    for (size_t i = 0; i < track.size(); i++) {
+        REQUIRE(track[i].sample_offset == expected[i].sample_offset);
+        REQUIRE((track[i].note.name == "A2" || track[i].note.name == "E4" || track[i].note.name == "LOW"));
+        if (expected[i].note.name == "A2" || expected[i].note.name == "E4" || expected[i].note.name == "LOW") {
+            REQUIRE(track[i].note.actual_frequency == expected[i].note.actual_frequency);
+        } else {
+            // the first frame of E4 is mostly silence, and its HPS picks a noise peak below the tone
+            REQUIRE(track[i].note.name == "E4");
+            REQUIRE(track[i].note.confidence == expected[i].note.confidence);
+            fixed++;
+        }
+    }
+    REQUIRE(fixed == 1);
+
+    tracking.candidates = 0;
+    REQUIRE_THROWS_AS(tuner::track_wav(wav, e, config, tracking, [](const tuner::pitch_point &) {}),
+                      tuner::InvalidConfigurationException);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,97 @@
+#ifndef TUNER_WINDOW_TABLE_HPP
+#define TUNER_WINDOW_TABLE_HPP
+
+#include <array>
+
+#include <tuner/global.hpp>
+
+namespace tuner {
+
+    namespace detail {
+        constexpr double PI = 3.14159265358979323846;
+
+        // Taylor series of cos and sin, accurate to double precision for |x| <= pi / 4
+        constexpr double cos_series(double x) {
+            double x2 = x * x;
+            return 1 - x2 / 2 * (1 - x2 / 12 * (1 - x2 / 30 * (1 - x2 / 56 * (1 - x2 / 90 * (1 - x2 / 132 * (1 - x2 / 182))))));
+        }
+
+        constexpr double sin_series(double x) {
+            double x2 = x * x;
+            return x * (1 - x2 / 6 * (1 - x2 / 20 * (1 - x2 / 42 * (1 - x2 / 72 * (1 - x2 / 110 * (1 - x2 / 156))))));
+        }
+
+        /**
+         * @return cos(2 pi k / n), std::cos is not constexpr. The angle is reduced to the first octant with integer
+         *         arithmetic, so no precision is lost for large k.
+         */
+        constexpr double cos_of_turn(long long k, long long n) {
+            k %= n;
+            if (k < 0) {
+                k += n;
+            }
+            // cos is even and has period n
+            if (2 * k > n) {
+                k = n - k;
+            }
+            // cos(pi - x) = -cos(x)
+            double sign = 1;
+            if (4 * k > n) {
+                k = n - 2 * k;
+                n *= 2;
+                sign = -1;
+            }
+            // cos(x) = sin(pi / 2 - x)
+            if (8 * k > n) {
+                return sign * sin_series(2 * PI * double(n - 4 * k) / double(4 * n));
+            }
+            return sign * cos_series(2 * PI * double(k) / double(n));
+        }
+
+        // a0 - a1 cos(2 pi i / SIZE) + a2 cos(4 pi i / SIZE), periodic like the FFT expects
+        template<int SIZE>
+        constexpr std::array<float, SIZE> make_cosine_window(double a0, double a1, double a2) {
+            std::array<float, SIZE> window{};
+            for (int i = 0; i < SIZE; i++) {
+                window[i] = float(a0 - a1 * cos_of_turn(i, SIZE) + a2 * cos_of_turn(2 * i, SIZE));
+            }
+            return window;
+        }
+    }
+
+    /**
+     * @brief The Hanning window of SIZE samples, 0.5 * (1 - cos(2 pi i / SIZE)), computed at compile time into read-only
+     *        data. Every engine with the same frame size shares the one table.
+     */
+    template<int SIZE>
+    inline constexpr std::array<float, SIZE> HANN_WINDOW = detail::make_cosine_window<SIZE>(0.5, 0.5, 0);
+
+    // the frame sizes with a precomputed window, TUNER_SIZE / 2 to 4 * TUNER_SIZE
+    constexpr int MIN_WINDOW_TABLE_SIZE = TUNER_SIZE / 2;
+    constexpr int MAX_WINDOW_TABLE_SIZE = 4 * TUNER_SIZE;
+
+    /**
+     * @brief Looks up the precomputed Hanning window for a frame size chosen at runtime.
+     *
+     * @param size The frame size.
+     *
+     * @return The HANN_WINDOW<size> table, or nullptr if 'size' is not a power of two between MIN_WINDOW_TABLE_SIZE
+     *         and MAX_WINDOW_TABLE_SIZE.
+     */
+    constexpr const float *hann_window(int size) noexcept {
+        switch (size) {
+            case TUNER_SIZE / 2:
+                return HANN_WINDOW<TUNER_SIZE / 2>.data();
+            case TUNER_SIZE:
+                return HANN_WINDOW<TUNER_SIZE>.data();
+            case 2 * TUNER_SIZE:
+                return HANN_WINDOW<2 * TUNER_SIZE>.data();
+            case 4 * TUNER_SIZE:
+                return HANN_WINDOW<4 * TUNER_SIZE>.data();
+            default:
+                return nullptr;
+        }
+    }
+}
+
+#endif //TUNER_WINDOW_TABLE_HPP
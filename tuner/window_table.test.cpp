@@ -0,0 +1,43 @@
+#include <cmath>
+
+#include <catch2/catch_test_macros.hpp>
+#include <tuner/window_table.hpp>
+
+// the tables are built at compile time
+static_assert(tuner::HANN_WINDOW<TUNER_SIZE>[0] == 0.0f);
+static_assert(tuner::HANN_WINDOW<TUNER_SIZE>[TUNER_SIZE / 2] == 1.0f);
+static_assert(tuner::HANN_WINDOW<TUNER_SIZE>[TUNER_SIZE / 4] == 0.5f);
+static_assert(tuner::hann_window(TUNER_SIZE) == tuner::HANN_WINDOW<TUNER_SIZE>.data());
+
+TEST_CASE("[cos_of_turn] matches std::cos") {
+    for (int n : {1, 2, 3, 7, 16, 100, TUNER_SIZE, 4 * TUNER_SIZE}) {
+        for (int k = -2 * n; k <= 2 * n; k++) {
+            REQUIRE(std::abs(tuner::detail::cos_of_turn(k, n) - std::cos(2 * M_PI * k / n)) < 1e-12);
+        }
+    }
+}
+
+TEST_CASE("[HANN_WINDOW] matches the Hann function") {
+    for (int i = 0; i < 4 * TUNER_SIZE; i++) {
+        float expected = float(0.5 * (1 - std::cos(2 * M_PI * i / (4 * TUNER_SIZE))));
+        REQUIRE(std::abs(tuner::HANN_WINDOW<4 * TUNER_SIZE>[i] - expected) < 1e-7f);
+    }
+}
+
+TEST_CASE("[HANN_WINDOW] is periodic and symmetric") {
+    const std::array<float, TUNER_SIZE> &window = tuner::HANN_WINDOW<TUNER_SIZE>;
+    for (int i = 1; i < TUNER_SIZE; i++) {
+        REQUIRE(window[i] == window[TUNER_SIZE - i]);
+    }
+}
+
+TEST_CASE("[hann_window] precomputed frame sizes") {
+    for (int size = tuner::MIN_WINDOW_TABLE_SIZE; size <= tuner::MAX_WINDOW_TABLE_SIZE; size *= 2) {
+        const float *window = tuner::hann_window(size);
+        REQUIRE(window != nullptr);
+        REQUIRE(window[size / 2] == 1.0f);
+    }
+    REQUIRE(tuner::hann_window(tuner::MIN_WINDOW_TABLE_SIZE / 2) == nullptr);
+    REQUIRE(tuner::hann_window(2 * tuner::MAX_WINDOW_TABLE_SIZE) == nullptr);
+    REQUIRE(tuner::hann_window(TUNER_SIZE + 1) == nullptr);
+}
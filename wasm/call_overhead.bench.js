@@ -0,0 +1,104 @@
+// Measures what one second of audio costs at the JS to WASM boundary, comparing the per-sample push_value API with
+// the block API that fills the shared input region and makes one analyze_block call per render quantum.
+//
+// Build the module with ./make_wasm.sh first, then run:
+//     node ./wasm/call_overhead.bench.js [path/to/wasm_tuner.js]
+
+const path = require('path');
+
+const SAMPLE_RATE = 48000;
+const RENDER_QUANTUM = 128;
+const TUNER_SIZE = 2048;
+const SECONDS = 10;
+
+function tone(length) {
+    const samples = new Float32Array(length);
+    for (let i = 0; i < length; i++) {
+        samples[i] = 0.5 * Math.sin(2 * Math.PI * 110 * i / SAMPLE_RATE);
+    }
+    return samples;
+}
+
+function measure(name, callsPerSecond, run) {
+    run(1); // warm up
+    const start = process.hrtime.bigint();
+    run(SECONDS);
+    const ns = Number(process.hrtime.bigint() - start);
+    const perSecond = ns / SECONDS;
+    console.log(
+        name.padEnd(34) +
+        String(callsPerSecond).padStart(10) + ' calls/s' +
+        (perSecond / 1e6).toFixed(3).padStart(10) + ' ms per audio second' +
+        (perSecond / callsPerSecond).toFixed(1).padStart(10) + ' ns per call'
+    );
+}
+
+function benchmark(Module) {
+    const audio = tone(SAMPLE_RATE);
+    const pointer = Module._get_block_buffer();
+    const capacity = Module._get_block_capacity();
+    const block = new Float32Array(Module.HEAPF32.buffer, pointer, capacity);
+    const quanta = Math.floor(SAMPLE_RATE / RENDER_QUANTUM);
+
+    console.log(`one second of audio = ${SAMPLE_RATE} samples, render quantum = ${RENDER_QUANTUM}, measured over ${SECONDS}s of audio`);
+
+    // boundary crossings only: no analysis runs
+    measure('push_value per sample', SAMPLE_RATE, (seconds) => {
+        for (let s = 0; s < seconds; s++) {
+            for (let i = 0; i < SAMPLE_RATE; i++) {
+                if (i % TUNER_SIZE === 0) {
+                    Module._clear_buffer_offset();
+                }
+                Module._push_value(audio[i]);
+            }
+        }
+    });
+    measure('ccall push_value per sample', SAMPLE_RATE, (seconds) => {
+        for (let s = 0; s < seconds; s++) {
+            for (let i = 0; i < SAMPLE_RATE; i++) {
+                if (i % TUNER_SIZE === 0) {
+                    Module.ccall('clear_buffer_offset', null, [], []);
+                }
+                Module.ccall('push_value', null, ['number'], [audio[i]]);
+            }
+        }
+    });
+    measure('block copy per quantum', quanta, (seconds) => {
+        for (let s = 0; s < seconds; s++) {
+            for (let q = 0; q < quanta; q++) {
+                block.set(audio.subarray(q * RENDER_QUANTUM, (q + 1) * RENDER_QUANTUM));
+            }
+        }
+    });
+
+    // end to end: boundary crossings plus analysis
+    const framesPerSecond = Math.floor(SAMPLE_RATE / TUNER_SIZE);
+    measure('push_value + get_frequency', SAMPLE_RATE + framesPerSecond, (seconds) => {
+        for (let s = 0; s < seconds; s++) {
+            Module._clear_buffer_offset();
+            for (let i = 0; i < framesPerSecond * TUNER_SIZE; i++) {
+                Module._push_value(audio[i]);
+                if ((i + 1) % TUNER_SIZE === 0) {
+                    Module._get_frequency(SAMPLE_RATE);
+                    Module._clear_buffer_offset();
+                }
+            }
+        }
+    });
+    measure('analyze_block per quantum', quanta, (seconds) => {
+        Module._clear_block_history();
+        for (let s = 0; s < seconds; s++) {
+            for (let q = 0; q < quanta; q++) {
+                block.set(audio.subarray(q * RENDER_QUANTUM, (q + 1) * RENDER_QUANTUM));
+                Module._analyze_block(RENDER_QUANTUM, SAMPLE_RATE);
+            }
+        }
+    });
+}
+
+globalThis.Module = {
+    onRuntimeInitialized() {
+        benchmark(globalThis.Module);
+    },
+};
+require(path.resolve(process.argv[2] || path.join(__dirname, '..', 'wasm_public', 'wasm_tuner.js')));
@@ -0,0 +1,44 @@
+// Loads the SIMD128 build of the tuner when the engine supports it and the scalar build otherwise.
+//
+//     loadTuner('./wasm_public').then((Module) => { ... });
+//
+// Works in browsers (script injection) and in Node (require). Both builds export the same functions;
+// Module._uses_simd() reports which one was loaded.
+
+// a module whose only function uses i8x16.splat and i8x16.popcnt, it only validates where SIMD128 is supported
+const SIMD_PROBE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11,
+]);
+
+function supportsSimd() {
+    try {
+        return typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_PROBE);
+    } catch (e) {
+        return false;
+    }
+}
+
+function loadTuner(basePath) {
+    const name = supportsSimd() ? 'wasm_tuner_simd' : 'wasm_tuner';
+    return new Promise((resolve, reject) => {
+        const Module = {
+            locateFile: (file) => `${basePath}/${file}`,
+            onRuntimeInitialized: () => resolve(Module),
+            onAbort: reject,
+        };
+        globalThis.Module = Module;
+
+        if (typeof document !== 'undefined') {
+            const script = document.createElement('script');
+            script.src = `${basePath}/${name}.js`;
+            script.onerror = reject;
+            document.head.appendChild(script);
+        } else {
+            require(require('path').resolve(basePath, `${name}.js`));
+        }
+    });
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = {loadTuner, supportsSimd};
+}